@@ -43,19 +43,104 @@ using namespace Pareto;
 int main(int argc, char* argv[])
 {
 
-	if (argc != 2) {
+	// optional flags to select columnar storage of configuration sets, streaming
+	// products, optimized plans, concurrent execution of plans, profiling of the
+	// operations, tracing of the minimizations, autotuning of the minimization with
+	// a tuning profile, online minimization of a record file and loading and saving
+	// the memory of the calculator in binary files
+	bool columnar = false;
+	bool stream = false;
+	bool plan = false;
+	bool parallel = false;
+	bool profiling = false;
+	std::string traceFile;
+	bool autotune = false;
+	std::string profile;
+	bool online = false;
+	bool binary = false;
+	std::string space, records, front;
+	std::string loadFile, saveFile;
+	bool validArguments = argc >= 2;
+	for (int i = 1; validArguments && i < argc - 1; i++) {
+		std::string arg = argv[i];
+		if (arg == "-columnar") {
+			columnar = true;
+		}
+		else if (arg == "-stream") {
+			stream = true;
+		}
+		else if (arg == "-plan") {
+			plan = true;
+		}
+		else if (arg == "-parallel") {
+			parallel = true;
+		}
+		else if (arg == "-profile") {
+			profiling = true;
+		}
+		else if (arg == "-trace" && i < argc - 2) {
+			traceFile = argv[++i];
+		}
+		else if (arg == "-online" && i < argc - 4) {
+			online = true;
+			space = argv[++i];
+			records = argv[++i];
+			front = argv[++i];
+		}
+		else if (arg == "-load" && i < argc - 2) {
+			loadFile = argv[++i];
+		}
+		else if (arg == "-save" && i < argc - 2) {
+			saveFile = argv[++i];
+		}
+		else if (arg == "-binary") {
+			binary = true;
+		}
+		else if (arg == "-tune" && i < argc - 2) {
+			autotune = true;
+			profile = argv[++i];
+		}
+		else {
+			validArguments = false;
+		}
+	}
+
+	if (!validArguments) {
 		std::cout << "Please provide an xml file to process." << std::endl;
-		std::cout << "Usage: ParetoCalculator <input_file>" << std::endl;
+		std::cout << "Usage: ParetoCalculator [-columnar] [-stream] [-plan] [-parallel] [-profile] [-trace <trace_file>]" << std::endl;
+		std::cout << "                        [-tune <profile_file>] [-load <binary_file>] [-save <binary_file>] <input_file>" << std::endl;
+		std::cout << "       ParetoCalculator -online <space> <record_file> <front_file> [-binary] <input_file>" << std::endl;
 		return -1;
 	}
 
-	std::string xmlfile = argv[1];
+	std::string xmlfile = argv[argc - 1];
 
 	std::cout << "Loading file: "<< xmlfile << std::endl;
 
 	try {
 		// create Pareto Calculator
 		PCConsole PCC(std::cout);
+		if (columnar) {
+			PCC.setStorageMode(StorageMode::Columnar);
+		}
+		if (stream) {
+			PCC.enableStreaming();
+		}
+		if (plan) {
+			PCC.enablePlanOptimization();
+		}
+		if (parallel) {
+			PCC.enableConcurrentOperations();
+		}
+		if (profiling) {
+			PCC.enableProfiling();
+		}
+		if (!traceFile.empty()) {
+			PCC.enableTracing();
+		}
+		if (autotune) {
+			PCC.enableAutotuning(profile);
+		}
 
 		// Read XML file
 		PCC.LoadFile(xmlfile);
@@ -63,10 +148,37 @@ int main(int argc, char* argv[])
 		// Process XML file
 		PCC.LoadQuantityTypes();
 		PCC.LoadConfigurationSpaces();
+
+		// Minimize the records of a configuration space with the types and spaces of the XML file
+		if (online) {
+			PCC.MinimizeRecordFile(space, records, front, binary ? RecordFormat::Binary : RecordFormat::Text);
+			return 0;
+		}
+
 		PCC.LoadConfigurationSets();
 
+		// Load the objects of a binary file, for instance a checkpoint of a previous run
+		if (!loadFile.empty()) {
+			PCC.LoadBinaryFile(loadFile);
+		}
+
 		// Execute operations
 		PCC.LoadOperations();
+
+		// Print the summary of the profiles of the operations
+		if (profiling) {
+			PCC.printProfile();
+		}
+
+		// Write the trace of the minimizations
+		if (!traceFile.empty()) {
+			PCC.writeTrace(traceFile);
+		}
+
+		// Save the memory of the calculator
+		if (!saveFile.empty()) {
+			PCC.SaveAllFile(saveFile);
+		}
 	} 
 	catch (EParetoCalculatorError& e) {
 		std::cout << "An exception occurred: " << e.errorMsg << std::endl;
@@ -33,6 +33,10 @@
 
 
 #include "pcconsole.h"
+#include <minimizetrace.h>
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
 
 namespace Pareto {
 
@@ -67,6 +71,124 @@ namespace Pareto {
 		this->_pc.LoadOperations();
 	}
 
+	void PCConsole::LoadBinaryFile(const std::string& filename)
+	{
+		this->_pc.LoadBinaryFile(filename);
+	}
+
+	void PCConsole::SaveAllFile(const std::string& filename)
+	{
+		this->_pc.SaveAllFile(filename);
+	}
+
+	void PCConsole::MinimizeRecordFile(const std::string& space, const std::string& records, const std::string& front, RecordFormat f)
+	{
+		this->_pc.MinimizeRecordFile(space, records, front, f);
+	}
+
+	void PCConsole::setStorageMode(StorageMode m)
+	{
+		this->_pc.setStorageMode(m);
+	}
+
+	void PCConsole::enableAutotuning(const std::string& profile)
+	{
+		this->_pc.enableAutotuning(profile);
+	}
+
+	void PCConsole::enableStreaming(void)
+	{
+		this->_pc.streamingPipelines = true;
+	}
+
+	void PCConsole::enablePlanOptimization(void)
+	{
+		this->_pc.optimizePlans = true;
+	}
+
+	void PCConsole::enableConcurrentOperations(void)
+	{
+		this->_pc.concurrentOperations = true;
+	}
+
+	void PCConsole::enableProfiling(void)
+	{
+		this->_pc.setProfilingCallbackObject(this);
+	}
+
+	void PCConsole::printProfile(void)
+	{
+		// the totals of the profiles of the same kind of operation or function
+		class Row {
+		public:
+			std::string name;
+			unsigned int level = 0;
+			unsigned long calls = 0;
+			double seconds = 0.0;
+			size_t inputSize = 0;
+			size_t outputSize = 0;
+			unsigned long long dominanceTests = 0;
+			unsigned long long allocations = 0;
+			unsigned int recursionDepth = 0;
+		};
+
+		// aggregate the operations by their first word, in order of appearance
+		std::vector<Row> rows;
+		{
+			std::lock_guard<std::mutex> guard(this->_profilesLock);
+			for (const OperationProfile& p : this->_profiles) {
+				std::string name = p.level == 0 ? p.name.substr(0, p.name.find(' ')) : p.name;
+				std::vector<Row>::iterator r = std::find_if(rows.begin(), rows.end(), [&](const Row& r) {
+					return r.level == p.level && r.name == name;
+				});
+				if (r == rows.end()) {
+					rows.push_back(Row());
+					r = rows.end() - 1;
+					r->name = name;
+					r->level = p.level;
+				}
+				r->calls++;
+				r->seconds += p.seconds;
+				r->inputSize += p.inputSize;
+				r->outputSize += p.outputSize;
+				r->dominanceTests += p.dominanceTests;
+				r->allocations += p.allocations;
+				r->recursionDepth = std::max(r->recursionDepth, p.recursionDepth);
+			}
+		}
+
+		std::ostream& os = this->_outstr;
+		for (unsigned int level = 0; level < 2; level++) {
+			os << (level == 0 ? "Profile of the operations:" : "Profile of the algebra functions:") << std::endl;
+			os << std::left << std::setw(24) << "name" << std::right << std::setw(8) << "calls" << std::setw(12) << "time (ms)"
+				<< std::setw(12) << "in" << std::setw(12) << "out" << std::setw(16) << "dominance" << std::setw(14) << "allocations"
+				<< std::setw(8) << "depth" << std::endl;
+			for (const Row& r : rows) {
+				if (r.level != level) continue;
+				os << std::left << std::setw(24) << r.name << std::right << std::setw(8) << r.calls
+					<< std::setw(12) << std::fixed << std::setprecision(3) << r.seconds * 1000.0
+					<< std::setw(12) << r.inputSize << std::setw(12) << r.outputSize << std::setw(16) << r.dominanceTests
+					<< std::setw(14) << r.allocations << std::setw(8) << r.recursionDepth << std::endl;
+			}
+		}
+	}
+
+	void PCConsole::enableTracing(void)
+	{
+		this->_pc.trace = std::make_shared<MinimizeTrace>();
+	}
+
+	void PCConsole::writeTrace(const std::string& filename)
+	{
+		std::ofstream f(filename);
+		if (!f) {
+			throw EParetoCalculatorError("Cannot write trace file " + filename);
+		}
+		this->_pc.trace->writeChromeTrace(f);
+		this->_outstr << "Trace of the minimizations per level of the recursion:" << std::endl;
+		this->_pc.trace->streamOn(this->_outstr);
+	}
+
 	// called by the calculator to indicate the status of its activities
 	void PCConsole::setStatus(const std::string& s)
 	{
@@ -77,4 +199,10 @@ namespace Pareto {
 	{
 		this->_outstr << s << std::endl;
 	}
+	// called by the calculator when an operation or algebra function completes
+	void PCConsole::profile(const OperationProfile& p)
+	{
+		std::lock_guard<std::mutex> guard(this->_profilesLock);
+		this->_profiles.push_back(p);
+	}
 }
@@ -34,7 +34,9 @@
 #pragma once
 
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <calculator.h>
 
@@ -43,7 +45,8 @@ namespace Pareto {
 
 	/// Provides interface to the Pareto Calculator for all functions used in the console app
 	/// Inherits from StatusCallback to deal with the information returned by the calculator
-	class PCConsole: StatusCallback
+	/// and from ProfilingCallback to collect the profiles of the operations
+	class PCConsole: StatusCallback, ProfilingCallback
 	{
 	public:
 		// constructor, takes a stream to direct output to
@@ -56,6 +59,41 @@ namespace Pareto {
 		void LoadConfigurationSets();
 		void LoadOperations();
 
+		// load the objects of a binary file into memory and save the memory to a binary file
+		void LoadBinaryFile(const std::string& filename);
+		void SaveAllFile(const std::string& filename);
+
+		// minimize a record file of configurations of space 'space' online and write the front to 'front'
+		void MinimizeRecordFile(const std::string& space, const std::string& records, const std::string& front, RecordFormat f);
+
+		// select the storage mode for configuration sets
+		void setStorageMode(StorageMode m);
+
+		// tune the minimization thresholds with the tuning profile in file 'profile'
+		void enableAutotuning(const std::string& profile);
+
+		// fuse products with the constraints and minimizations that follow them
+		void enableStreaming(void);
+
+		// compile the operations into an optimized plan before executing them
+		void enablePlanOptimization(void);
+
+		// execute the independent operations of the plan concurrently
+		void enableConcurrentOperations(void);
+
+		// collect the profiles of the operations and the algebra functions they call
+		void enableProfiling(void);
+
+		// print a table summarizing the profiles collected so far
+		void printProfile(void);
+
+		// trace the recursion of the minimizations
+		void enableTracing(void);
+
+		// write the trace of the minimizations in the Chrome trace-event format to file 'filename'
+		// and print a table of its totals per level of the recursion
+		void writeTrace(const std::string& filename);
+
 	private:
 
 		// stream to direct calculator output to
@@ -64,6 +102,10 @@ namespace Pareto {
 		// the calculator that will do the work
 		ParetoCalculator _pc;
 
+		// the profiles collected from the calculator, which may report from several threads
+		std::vector<OperationProfile> _profiles;
+		std::mutex _profilesLock;
+
 	private:
 
 		/// called by the calculator to indicate the status of its activities
@@ -72,6 +114,9 @@ namespace Pareto {
 		/// called by the calculator to generate verbose stream description of what it is doing.
 		virtual void verbose(const std::string& s);
 
+		/// called by the calculator when an operation or algebra function completes
+		virtual void profile(const OperationProfile& p);
+
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,364 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Implementation of the ND-tree of a Pareto archive
+//
+
+#include "archive.h"
+#include "profiling.h"
+#include "quantity.h"
+#include <algorithm>
+
+using namespace Pareto;
+
+
+/// A node of the tree of a Pareto archive. A leaf holds configurations, an internal node holds
+/// at least two children. The ideal and nadir points bound the configurations below the node.
+class ParetoArchive::Node {
+public:
+	class Entry {
+	public:
+		ConfigurationPtr conf;
+		Point x;
+	};
+
+	Point ideal, nadir;
+	std::vector<Entry> entries;
+	std::vector<std::unique_ptr<Node>> children;
+
+	bool isLeaf(void) const { return children.empty(); }
+	bool empty(void) const { return entries.empty() && children.empty(); }
+
+	/// extend the bounds with point 'x'
+	void extend(const Point& x) {
+		if (this->empty()) {
+			ideal = x;
+			nadir = x;
+			return;
+		}
+		for (size_t i = 0; i < x.size(); i++) {
+			if (x[i] < ideal[i]) ideal[i] = x[i];
+			if (x[i] > nadir[i]) nadir[i] = x[i];
+		}
+	}
+
+	/// the squared distance of point 'x' to the center of the bounds
+	double distanceToMidpoint(const Point& x) const {
+		double d = 0.0;
+		for (size_t i = 0; i < x.size(); i++) {
+			double m = (ideal[i] + nadir[i]) / 2.0 - x[i];
+			d += m * m;
+		}
+		return d;
+	}
+};
+
+/// test if point 'a' is weakly below point 'b' in all coordinates
+static bool weaklyBelow(const std::vector<double>& a, const std::vector<double>& b) {
+	for (size_t i = 0; i < a.size(); i++) {
+		if (a[i] > b[i]) return false;
+	}
+	return true;
+}
+
+static double squaredDistance(const std::vector<double>& a, const std::vector<double>& b) {
+	double d = 0.0;
+	for (size_t i = 0; i < a.size(); i++) {
+		d += (a[i] - b[i]) * (a[i] - b[i]);
+	}
+	return d;
+}
+
+
+ParetoArchive::ParetoArchive(ConfigurationSetPtr f, size_t ls) :
+	front(f), kernel(f->confspace->dominanceKernel()), leafSize(ls < 2 ? 2 : ls) {
+	this->front->toNodes();
+	for (SetOfConfigurations::const_iterator i = this->front->confs().begin(); i != this->front->confs().end(); i++) {
+		this->add(this->trees[this->key(**i)], *i, this->coordinates(**i));
+		this->count++;
+	}
+}
+
+ParetoArchive::~ParetoArchive() {
+}
+
+ParetoArchive::Point ParetoArchive::coordinates(const Configuration& c) const {
+	const ListOfQuantityValues& q = c.quantities;
+	Point x;
+	x.reserve(kernel.reals.size() + kernel.integers.size() + kernel.enums.size());
+	for (unsigned int i : kernel.reals) {
+		x.push_back(static_cast<const QuantityValue_Real&>(*q[i]).value);
+	}
+	for (unsigned int i : kernel.integers) {
+		x.push_back(static_cast<const QuantityValue_Integer&>(*q[i]).value);
+	}
+	for (unsigned int i : kernel.enums) {
+		x.push_back(static_cast<const QuantityValue_Enum&>(*q[i]).code);
+	}
+	return x;
+}
+
+ParetoArchive::Key ParetoArchive::key(const Configuration& c) const {
+	Key k;
+	k.reserve(kernel.unordered.size());
+	for (unsigned int i : kernel.unordered) {
+		k.push_back(static_cast<const QuantityValue_Enum&>(*c.quantities[i]).code);
+	}
+	return k;
+}
+
+/// split leaf 'n' into children. The children are seeded with configurations that are far
+/// apart and the other configurations go to the child with the nearest midpoint.
+static void split(ParetoArchive::Node& n) {
+	using Node = ParetoArchive::Node;
+	size_t dims = n.ideal.size();
+	size_t k = std::min(std::max<size_t>(2, dims + 1), n.entries.size());
+
+	// the seeds, every next seed has the largest average distance to the previous ones
+	std::vector<size_t> seeds;
+	std::vector<double> distance(n.entries.size(), 0.0);
+	for (size_t i = 0; i < n.entries.size(); i++) {
+		for (size_t j = 0; j < n.entries.size(); j++) {
+			distance[i] += squaredDistance(n.entries[i].x, n.entries[j].x);
+		}
+	}
+	std::vector<bool> seeded(n.entries.size(), false);
+	while (seeds.size() < k) {
+		size_t best = 0;
+		bool found = false;
+		for (size_t i = 0; i < n.entries.size(); i++) {
+			if (!seeded[i] && (!found || distance[i] > distance[best])) {
+				best = i;
+				found = true;
+			}
+		}
+		seeded[best] = true;
+		seeds.push_back(best);
+		if (seeds.size() == 1) {
+			std::fill(distance.begin(), distance.end(), 0.0);
+		}
+		for (size_t i = 0; i < n.entries.size(); i++) {
+			distance[i] += squaredDistance(n.entries[i].x, n.entries[best].x);
+		}
+	}
+
+	for (size_t s : seeds) {
+		std::unique_ptr<Node> child(new Node());
+		child->extend(n.entries[s].x);
+		child->entries.push_back(std::move(n.entries[s]));
+		n.children.push_back(std::move(child));
+	}
+	for (size_t i = 0; i < n.entries.size(); i++) {
+		if (seeded[i]) continue;
+		Node* nearest = nullptr;
+		double d = 0.0;
+		for (const std::unique_ptr<Node>& child : n.children) {
+			double dc = child->distanceToMidpoint(n.entries[i].x);
+			if (nearest == nullptr || dc < d) {
+				nearest = child.get();
+				d = dc;
+			}
+		}
+		nearest->extend(n.entries[i].x);
+		nearest->entries.push_back(std::move(n.entries[i]));
+	}
+	n.entries.clear();
+}
+
+/// insert entry 'e' below node 'n'
+static void insertInto(ParetoArchive::Node& n, ParetoArchive::Node::Entry&& e, size_t leafSize) {
+	n.extend(e.x);
+	if (n.isLeaf()) {
+		n.entries.push_back(std::move(e));
+		if (n.entries.size() > leafSize) {
+			split(n);
+		}
+		return;
+	}
+	ParetoArchive::Node* nearest = nullptr;
+	double d = 0.0;
+	for (const std::unique_ptr<ParetoArchive::Node>& child : n.children) {
+		double dc = child->distanceToMidpoint(e.x);
+		if (nearest == nullptr || dc < d) {
+			nearest = child.get();
+			d = dc;
+		}
+	}
+	insertInto(*nearest, std::move(e), leafSize);
+}
+
+/// restore the invariants of node 'n' after removals: no empty children, no internal node with
+/// a single child and exact bounds
+static void normalize(ParetoArchive::Node& n) {
+	using Node = ParetoArchive::Node;
+	n.children.erase(std::remove_if(n.children.begin(), n.children.end(),
+		[](const std::unique_ptr<Node>& c) { return c->empty(); }), n.children.end());
+	if (n.children.size() == 1) {
+		std::unique_ptr<Node> child = std::move(n.children[0]);
+		n.children = std::move(child->children);
+		n.entries = std::move(child->entries);
+	}
+	if (n.empty()) return;
+	if (n.isLeaf()) {
+		n.ideal = n.entries[0].x;
+		n.nadir = n.entries[0].x;
+		for (const Node::Entry& e : n.entries) {
+			for (size_t i = 0; i < e.x.size(); i++) {
+				if (e.x[i] < n.ideal[i]) n.ideal[i] = e.x[i];
+				if (e.x[i] > n.nadir[i]) n.nadir[i] = e.x[i];
+			}
+		}
+	}
+	else {
+		n.ideal = n.children[0]->ideal;
+		n.nadir = n.children[0]->nadir;
+		for (const std::unique_ptr<Node>& c : n.children) {
+			for (size_t i = 0; i < n.ideal.size(); i++) {
+				if (c->ideal[i] < n.ideal[i]) n.ideal[i] = c->ideal[i];
+				if (c->nadir[i] > n.nadir[i]) n.nadir[i] = c->nadir[i];
+			}
+		}
+	}
+}
+
+/// remove all configurations below node 'n' from 'confs'
+static size_t removeAll(ParetoArchive::Node& n, SetOfConfigurations& confs) {
+	size_t removed = n.entries.size();
+	for (const ParetoArchive::Node::Entry& e : n.entries) {
+		confs.erase(e.conf);
+	}
+	for (const std::unique_ptr<ParetoArchive::Node>& c : n.children) {
+		removed += removeAll(*c, confs);
+	}
+	n.entries.clear();
+	n.children.clear();
+	return removed;
+}
+
+/// remove the configurations below node 'n' that are dominated by point 'x'
+static size_t removeDominated(ParetoArchive::Node& n, const std::vector<double>& x, SetOfConfigurations& confs) {
+	if (!weaklyBelow(x, n.nadir)) return 0;
+	if (weaklyBelow(x, n.ideal)) return removeAll(n, confs);
+	size_t removed = 0;
+	if (n.isLeaf()) {
+		std::vector<ParetoArchive::Node::Entry>::iterator i = n.entries.begin();
+		while (i != n.entries.end()) {
+			ProfileCounters::dominanceTests++;
+			if (weaklyBelow(x, i->x)) {
+				confs.erase(i->conf);
+				i = n.entries.erase(i);
+				removed++;
+			}
+			else i++;
+		}
+	}
+	else {
+		for (const std::unique_ptr<ParetoArchive::Node>& c : n.children) {
+			removed += removeDominated(*c, x, confs);
+		}
+	}
+	if (removed > 0) normalize(n);
+	return removed;
+}
+
+/// test if a configuration below node 'n' dominates point 'x'
+static bool dominatedIn(const ParetoArchive::Node& n, const std::vector<double>& x) {
+	if (!weaklyBelow(n.ideal, x)) return false;
+	if (weaklyBelow(n.nadir, x)) return true;
+	for (const ParetoArchive::Node::Entry& e : n.entries) {
+		ProfileCounters::dominanceTests++;
+		if (weaklyBelow(e.x, x)) return true;
+	}
+	for (const std::unique_ptr<ParetoArchive::Node>& c : n.children) {
+		if (dominatedIn(*c, x)) return true;
+	}
+	return false;
+}
+
+/// remove configuration 'c' with point 'x' from below node 'n'
+static bool eraseFrom(ParetoArchive::Node& n, const ConfigurationPtr& c, const std::vector<double>& x, SetOfConfigurations& confs) {
+	if (!weaklyBelow(n.ideal, x) || !weaklyBelow(x, n.nadir)) return false;
+	bool found = false;
+	for (std::vector<ParetoArchive::Node::Entry>::iterator i = n.entries.begin(); !found && i != n.entries.end(); i++) {
+		if (i->conf == c || (!ConfigurationSpace::LexicographicCompare(*i->conf, *c) && !ConfigurationSpace::LexicographicCompare(*c, *i->conf))) {
+			confs.erase(i->conf);
+			n.entries.erase(i);
+			found = true;
+		}
+	}
+	for (std::vector<std::unique_ptr<ParetoArchive::Node>>::iterator i = n.children.begin(); !found && i != n.children.end(); i++) {
+		found = eraseFrom(**i, c, x, confs);
+	}
+	if (found) normalize(n);
+	return found;
+}
+
+void ParetoArchive::add(std::unique_ptr<Node>& tree, ConfigurationPtr c, Point&& x) {
+	if (!tree) {
+		tree.reset(new Node());
+	}
+	Node::Entry e;
+	e.conf = c;
+	e.x = std::move(x);
+	insertInto(*tree, std::move(e), this->leafSize);
+}
+
+bool ParetoArchive::isDominated(const Configuration& c) const {
+	std::map<Key, std::unique_ptr<Node>>::const_iterator t = this->trees.find(this->key(c));
+	if (t == this->trees.end()) return false;
+	return dominatedIn(*t->second, this->coordinates(c));
+}
+
+bool ParetoArchive::insert(ConfigurationPtr c) {
+	Point x = this->coordinates(*c);
+	std::unique_ptr<Node>& tree = this->trees[this->key(*c)];
+	if (tree) {
+		if (dominatedIn(*tree, x)) return false;
+		this->count -= removeDominated(*tree, x, this->front->confs());
+	}
+	if (tree && tree->empty()) {
+		tree.reset();
+	}
+	this->add(tree, c, std::move(x));
+	this->front->addUniqueConfiguration(c);
+	this->count++;
+	return true;
+}
+
+bool ParetoArchive::erase(const ConfigurationPtr& c) {
+	std::map<Key, std::unique_ptr<Node>>::iterator t = this->trees.find(this->key(*c));
+	if (t == this->trees.end()) return false;
+	if (!eraseFrom(*t->second, c, this->coordinates(*c), this->front->confs())) return false;
+	if (t->second->empty()) {
+		this->trees.erase(t);
+	}
+	this->count--;
+	return true;
+}
@@ -0,0 +1,111 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// An indexed archive of mutually non-dominated configurations that supports
+// dominance queries, insertion and deletion
+//
+
+#ifndef PARETO_ARCHIVE_H
+#define PARETO_ARCHIVE_H
+
+#include <map>
+#include <memory>
+#include <vector>
+#include "configuration.h"
+#include "dominance.h"
+
+/// the maximum number of configurations in a leaf of the tree of a Pareto archive
+#define DEFAULT_ARCHIVE_LEAF_SIZE 20
+
+
+namespace Pareto {
+
+	/// An indexed dynamic Pareto archive (ND-tree) on a minimal set of configurations.
+	///
+	/// The archive keeps the set 'front' minimal under insertion and indexes its configurations
+	/// by their totally ordered quantities in a tree. Every node of the tree is summarized by
+	/// the ideal point and the nadir point of its configurations, the best and the worst value
+	/// in every quantity. A dominance query or an insertion skips the nodes whose bounds show
+	/// that none of their configurations is involved, and the configurations that are dominated
+	/// by a new configuration are removed in whole subtrees where possible. Configurations that
+	/// differ in unordered quantities never dominate each other, they are kept in separate trees.
+	/// The archive follows the dominance (<=) of ConfigurationSpace::dominanceKernel().
+	class ParetoArchive {
+	public:
+		/// Constructor of the archive backing 'front', which must be minimal. The configurations
+		/// of 'front' are indexed and 'front' is switched to node storage mode. Leaves of the tree
+		/// are split when they exceed 'leafSize' configurations.
+		ParetoArchive(ConfigurationSetPtr front, size_t leafSize = DEFAULT_ARCHIVE_LEAF_SIZE);
+		~ParetoArchive();
+
+		/// test if a configuration of the archive dominates configuration 'c'
+		bool isDominated(const Configuration& c) const;
+
+		/// add configuration 'c' if it is not dominated and remove the configurations it
+		/// dominates. Returns true if 'c' is added.
+		bool insert(ConfigurationPtr c);
+
+		/// remove configuration 'c' from the archive. Returns false if it does not occur.
+		bool erase(const ConfigurationPtr& c);
+
+		/// the number of configurations in the archive
+		size_t size(void) const { return this->count; }
+
+		/// the set of configurations backed by the archive
+		ConfigurationSetPtr set(void) const { return this->front; }
+
+		/// a node of the tree, see archive.cpp
+		class Node;
+
+	private:
+		using Point = std::vector<double>;
+		using Key = std::vector<unsigned int>;
+
+		ConfigurationSetPtr front;
+		const DominanceKernel& kernel;
+		size_t leafSize;
+		size_t count = 0;
+
+		/// the trees of the configurations by the values of their unordered quantities
+		std::map<Key, std::unique_ptr<Node>> trees;
+
+		/// the values of the totally ordered quantities of configuration 'c'
+		Point coordinates(const Configuration& c) const;
+
+		/// the values of the unordered quantities of configuration 'c'
+		Key key(const Configuration& c) const;
+
+		/// add configuration 'c' with coordinates 'x' to the tree, assumes it is not dominated
+		void add(std::unique_ptr<Node>& tree, ConfigurationPtr c, Point&& x);
+	};
+
+}
+
+#endif
@@ -0,0 +1,91 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Implements the region allocator for configurations
+//
+
+#include "arena.h"
+#include "exceptions.h"
+#include <cstdint>
+
+
+namespace Pareto {
+
+	/// the number of chunks of all arenas that have not been released
+	static std::atomic<size_t> liveChunks{ 0 };
+
+	ConfigurationArena::~ConfigurationArena() {
+		if (this->current != nullptr) ConfigurationArena::release(this->current);
+	}
+
+	void* ConfigurationArena::allocate(size_t n, size_t align) {
+#ifdef _DEBUG
+		if (this->busy.exchange(true, std::memory_order_acquire)) {
+			throw EParetoCalculatorError("Concurrent allocation in a ConfigurationArena.");
+		}
+#endif
+		uintptr_t p = (reinterpret_cast<uintptr_t>(this->next) + align - 1) & ~(uintptr_t)(align - 1);
+		if (this->current == nullptr || p + n > reinterpret_cast<uintptr_t>(this->end)) {
+			// start a new chunk; the old one is released when its last object is destroyed
+			if (this->current != nullptr) ConfigurationArena::release(this->current);
+			char* memory = static_cast<char*>(::operator new(CHUNK_SIZE, std::align_val_t(CHUNK_SIZE)));
+			liveChunks++;
+			this->current = new (memory) Chunk();
+			this->next = memory + sizeof(Chunk);
+			this->end = memory + CHUNK_SIZE;
+			p = (reinterpret_cast<uintptr_t>(this->next) + align - 1) & ~(uintptr_t)(align - 1);
+		}
+		this->next = reinterpret_cast<char*>(p + n);
+		this->current->live.fetch_add(1, std::memory_order_relaxed);
+#ifdef _DEBUG
+		this->busy.store(false, std::memory_order_release);
+#endif
+		return reinterpret_cast<void*>(p);
+	}
+
+	void ConfigurationArena::deallocate(void* p) {
+		// chunks are aligned to their size, so the header is found by rounding down
+		uintptr_t c = reinterpret_cast<uintptr_t>(p) & ~(uintptr_t)(CHUNK_SIZE - 1);
+		ConfigurationArena::release(reinterpret_cast<Chunk*>(c));
+	}
+
+	void ConfigurationArena::release(Chunk* c) {
+		if (c->live.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			c->~Chunk();
+			::operator delete(static_cast<void*>(c), std::align_val_t(CHUNK_SIZE));
+			liveChunks--;
+		}
+	}
+
+	size_t ConfigurationArena::chunksInUse(void) {
+		return liveChunks.load();
+	}
+
+}
@@ -0,0 +1,160 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// A region allocator for the configurations of a set and their quantity values
+//
+
+#ifndef PARETO_ARENA_H
+#define PARETO_ARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "profiling.h"
+
+
+namespace Pareto {
+
+	class ConfigurationArena;
+	using ConfigurationArenaPtr = std::shared_ptr<ConfigurationArena>;
+
+	/// A region allocator for the many small objects of a configuration set: the configurations,
+	/// their lists of quantity values and the quantity values that are computed for them.
+	///
+	/// Objects are allocated by advancing a pointer through large, aligned chunks of memory.
+	/// Every chunk counts the objects in it that are alive and is released in one go when the
+	/// last of them is destroyed, so a set that leaves the calculator stack frees its memory per
+	/// chunk instead of per object. Configurations that outlive their set, for instance in the
+	/// minimized set, only keep their own chunks alive.
+	///
+	/// An arena is filled by one thread at a time, like the configuration set it belongs to, so
+	/// allocation takes no lock. Tasks of a parallel operation fill arenas of their own, as the
+	/// partitions of a HashJoin do. Objects may be released on any thread.
+	class ConfigurationArena {
+	public:
+		/// the size and alignment of a chunk
+		static const size_t CHUNK_SIZE = 64 * 1024;
+		/// allocations larger than this are passed on to the global heap
+		static const size_t MAX_ARENA_ALLOCATION = CHUNK_SIZE / 8;
+
+		ConfigurationArena() {}
+		~ConfigurationArena();
+
+		ConfigurationArena(const ConfigurationArena&) = delete;
+		ConfigurationArena& operator=(const ConfigurationArena&) = delete;
+
+		/// allocate 'n' bytes, aligned to 'align', which must be at most alignof(std::max_align_t)
+		void* allocate(size_t n, size_t align);
+
+		/// release memory allocated by any arena
+		static void deallocate(void* p);
+
+		/// test if an allocation of 'n' bytes aligned to 'align' can be made in an arena
+		static bool fitsInArena(size_t n, size_t align) {
+			return n <= MAX_ARENA_ALLOCATION && align <= alignof(std::max_align_t);
+		}
+
+		/// the number of chunks of all arenas that have not been released
+		static size_t chunksInUse(void);
+
+	private:
+		/// the header at the start of every chunk
+		struct alignas(std::max_align_t) Chunk {
+			/// the number of live objects in the chunk, plus one while the chunk is being filled
+			std::atomic<size_t> live{ 1 };
+		};
+
+		/// drop one reference to chunk 'c' and release it if it was the last
+		static void release(Chunk* c);
+
+#ifdef _DEBUG
+		/// set while an object is allocated, to detect allocations by concurrent threads
+		std::atomic<bool> busy{ false };
+#endif
+		Chunk* current = nullptr;
+		char* next = nullptr;
+		char* end = nullptr;
+	};
+
+
+	/// A standard allocator that allocates in a ConfigurationArena. An allocator without an
+	/// arena, or a request that is too large for an arena, uses the global heap.
+	template <class T>
+	class ArenaAllocator {
+	public:
+		using value_type = T;
+		using propagate_on_container_move_assignment = std::true_type;
+		using propagate_on_container_swap = std::true_type;
+
+		ArenaAllocator() noexcept {}
+		ArenaAllocator(ConfigurationArenaPtr a) noexcept : arena(std::move(a)) {}
+		template <class U>
+		ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+
+		T* allocate(size_t n) {
+			ProfileCounters::allocations++;
+			if (arena != nullptr && ConfigurationArena::fitsInArena(n * sizeof(T), alignof(T))) {
+				return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+			}
+			return static_cast<T*>(::operator new(n * sizeof(T)));
+		}
+
+		void deallocate(T* p, size_t n) noexcept {
+			if (arena != nullptr && ConfigurationArena::fitsInArena(n * sizeof(T), alignof(T))) {
+				ConfigurationArena::deallocate(p);
+			}
+			else {
+				::operator delete(p);
+			}
+		}
+
+		/// the arena, or nullptr for the global heap
+		ConfigurationArenaPtr arena;
+	};
+
+	template <class T, class U>
+	bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.arena == b.arena; }
+
+	template <class T, class U>
+	bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.arena != b.arena; }
+
+	/// create an object of type T in 'arena', or on the global heap if 'arena' is nullptr.
+	/// Use it for all configurations and quantity values, so that their allocations are profiled.
+	template <class T, class... Args>
+	std::shared_ptr<T> allocateInArena(const ConfigurationArenaPtr& arena, Args&&... args) {
+		return std::allocate_shared<T>(ArenaAllocator<T>(arena), std::forward<Args>(args)...);
+	}
+
+}
+
+#endif
@@ -0,0 +1,204 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Implements the automatic tuning of the minimization thresholds
+//
+
+#include "autotuner.h"
+#include "calculator.h"
+#include "exceptions.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+
+namespace Pareto {
+
+	ThresholdTuner::ThresholdTuner(void) {
+	}
+
+	ThresholdTuner::ThresholdTuner(const std::string& profileFile) : profileFile(profileFile) {
+		std::ifstream f(profileFile);
+		if (f.good()) {
+			f.close();
+			this->load(profileFile);
+		}
+	}
+
+	MinimizeOptions ThresholdTuner::tune(ConfigurationSetPtr cs, const MinimizeOptions& o) {
+		MinimizeOptions res = o;
+		res.tuner = nullptr;
+		unsigned int d = cs->confspace->nrOfVisibleQuantities();
+
+		std::lock_guard<std::recursive_mutex> l(this->lock);
+		std::map<unsigned int, TunedThresholds>::iterator i = this->profile.find(d);
+		if (i == this->profile.end()) {
+			// too small to get a meaningful measurement
+			if (cs->size() < TUNING_MINIMAL_SIZE) {
+				return res;
+			}
+			TunedThresholds t = this->measure(ThresholdTuner::sampleOf(cs, TUNING_SAMPLE_SIZE), res);
+			i = this->profile.insert(std::make_pair(d, t)).first;
+			if (!this->profileFile.empty()) {
+				this->save(this->profileFile);
+			}
+		}
+		res.minimizeThreshold = i->second.minimizeThreshold;
+		res.filterThreshold = i->second.filterThreshold;
+		return res;
+	}
+
+	bool ThresholdTuner::hasThresholds(unsigned int nrOfQuantities) {
+		std::lock_guard<std::recursive_mutex> l(this->lock);
+		return this->profile.find(nrOfQuantities) != this->profile.end();
+	}
+
+	TunedThresholds ThresholdTuner::thresholds(unsigned int nrOfQuantities) {
+		std::lock_guard<std::recursive_mutex> l(this->lock);
+		std::map<unsigned int, TunedThresholds>::iterator i = this->profile.find(nrOfQuantities);
+		if (i == this->profile.end()) {
+			throw EParetoCalculatorError("No tuned thresholds for " + std::to_string(nrOfQuantities) + " quantities");
+		}
+		return i->second;
+	}
+
+	void ThresholdTuner::setThresholds(unsigned int nrOfQuantities, const TunedThresholds& t) {
+		std::lock_guard<std::recursive_mutex> l(this->lock);
+		this->profile[nrOfQuantities] = t;
+	}
+
+	void ThresholdTuner::load(const std::string& fn) {
+		std::ifstream f(fn);
+		if (!f.good()) {
+			throw EParetoCalculatorError("Cannot open tuning profile " + fn);
+		}
+		std::lock_guard<std::recursive_mutex> l(this->lock);
+		std::string line;
+		while (std::getline(f, line)) {
+			// skip empty lines and comments
+			if (line.find_first_not_of(" \t\r") == std::string::npos || line[line.find_first_not_of(" \t")] == '#') {
+				continue;
+			}
+			std::istringstream ls(line);
+			unsigned int d;
+			TunedThresholds t;
+			if (!(ls >> d >> t.minimizeThreshold >> t.filterThreshold)) {
+				throw EParetoCalculatorError("Invalid line in tuning profile " + fn + ": " + line);
+			}
+			this->profile[d] = t;
+		}
+	}
+
+	void ThresholdTuner::save(const std::string& fn) {
+		std::ofstream f(fn);
+		if (!f.good()) {
+			throw EParetoCalculatorError("Cannot write tuning profile " + fn);
+		}
+		std::lock_guard<std::recursive_mutex> l(this->lock);
+		f << "# ParetoCalculator tuning profile" << std::endl;
+		f << "# quantities minimize_threshold filter_threshold" << std::endl;
+		for (const std::pair<const unsigned int, TunedThresholds>& p : this->profile) {
+			f << p.first << " " << p.second.minimizeThreshold << " " << p.second.filterThreshold << std::endl;
+		}
+	}
+
+	TunedThresholds ThresholdTuner::measure(ConfigurationSetPtr sample, const MinimizeOptions& o) {
+		// time sequential runs only, without collecting statistics or a trace
+		MinimizeOptions trial = o;
+		trial.parallel = false;
+		trial.statistics = nullptr;
+		trial.trace = nullptr;
+		trial.tuner = nullptr;
+		unsigned int n = (unsigned int) sample->size();
+
+		// the minimize threshold, a threshold above the sample size uses the base case only
+		std::vector<unsigned int> candidates;
+		for (unsigned int t = 16; t < n; t *= 2) candidates.push_back(t);
+		candidates.push_back(n + 1);
+
+		TunedThresholds best = { o.minimizeThreshold, o.filterThreshold };
+		double bestTime = -1.0;
+		for (unsigned int t : candidates) {
+			trial.minimizeThreshold = t;
+			double time = ThresholdTuner::timeMinimization(sample, trial);
+			if (bestTime < 0.0 || time < bestTime) {
+				bestTime = time;
+				best.minimizeThreshold = t;
+			}
+		}
+
+		// the base case is best up to the sample size, sets beyond it remain undecided
+		if (best.minimizeThreshold > n) {
+			best.minimizeThreshold = std::max(n, o.minimizeThreshold);
+			return best;
+		}
+
+		// the filter threshold, given the minimize threshold
+		trial.minimizeThreshold = best.minimizeThreshold;
+		bestTime = -1.0;
+		for (unsigned int t : candidates) {
+			trial.filterThreshold = t;
+			double time = ThresholdTuner::timeMinimization(sample, trial);
+			if (bestTime < 0.0 || time < bestTime) {
+				bestTime = time;
+				best.filterThreshold = t;
+			}
+		}
+		return best;
+	}
+
+	ConfigurationSetPtr ThresholdTuner::sampleOf(ConfigurationSetPtr cs, size_t n) {
+		cs->materialize();
+		ConfigurationSetPtr sample = std::make_shared<ConfigurationSet>(cs->confspace, cs->name + " sample");
+		size_t stride = std::max((size_t) 1, cs->confs().size() / n);
+		size_t k = 0;
+		for (SetOfConfigurations::iterator i = cs->confs().begin(); i != cs->confs().end() && sample->confs().size() < n; i++, k++) {
+			if (k % stride == 0) {
+				// the sample is in the same order as the set
+				sample->confs().insert(sample->confs().end(), *i);
+			}
+		}
+		return sample;
+	}
+
+	double ThresholdTuner::timeMinimization(ConfigurationSetPtr cs, const MinimizeOptions& o) {
+		// the best of two runs
+		double best = -1.0;
+		for (int r = 0; r < 2; r++) {
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			ParetoCalculator::efficient_minimize(cs, o);
+			std::chrono::duration<double> d = std::chrono::steady_clock::now() - start;
+			if (best < 0.0 || d.count() < best) best = d.count();
+		}
+		return best;
+	}
+
+}
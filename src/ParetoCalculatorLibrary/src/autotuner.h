@@ -0,0 +1,114 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Automatic tuning of the thresholds of the divide-and-conquer minimization
+//
+
+#ifndef PARETO_AUTOTUNER_H
+#define PARETO_AUTOTUNER_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include "configuration.h"
+#include "minimizeoptions.h"
+
+
+#define TUNING_SAMPLE_SIZE 4096
+#define TUNING_MINIMAL_SIZE 512
+
+
+namespace Pareto {
+
+	/// The tuned thresholds for one number of visible quantities
+	struct TunedThresholds {
+		unsigned int minimizeThreshold;
+		unsigned int filterThreshold;
+	};
+
+	/// Determines the thresholds of the divide-and-conquer minimization by measuring.
+	///
+	/// The best crossover between the base-case algorithm and divide-and-conquer depends on
+	/// the number of visible quantities and on the fraction of Pareto points. The first time
+	/// a set with a given number of visible quantities is minimized, the tuner takes a sample
+	/// of the set, times the minimization of the sample for a range of thresholds and keeps the
+	/// fastest. The results are kept in a profile, which can be stored in a file and loaded by
+	/// later runs.
+	class ThresholdTuner {
+	public:
+		/// Constructor of a tuner with an empty profile that is not stored
+		ThresholdTuner(void);
+
+		/// Constructor of a tuner with the profile in file 'profileFile'. The profile is loaded
+		/// if the file exists and saved whenever new thresholds have been tuned.
+		ThresholdTuner(const std::string& profileFile);
+
+		/// return 'o' with the thresholds tuned for the configuration set 'cs'.
+		/// Sets that are too small to measure get the thresholds of 'o'.
+		MinimizeOptions tune(ConfigurationSetPtr cs, const MinimizeOptions& o);
+
+		/// test if the profile has thresholds for 'nrOfQuantities' visible quantities
+		bool hasThresholds(unsigned int nrOfQuantities);
+
+		/// the thresholds for 'nrOfQuantities' visible quantities. Throws an exception if there are none.
+		TunedThresholds thresholds(unsigned int nrOfQuantities);
+
+		/// set the thresholds for 'nrOfQuantities' visible quantities
+		void setThresholds(unsigned int nrOfQuantities, const TunedThresholds& t);
+
+		/// load the profile from file 'fn'
+		void load(const std::string& fn);
+
+		/// save the profile to file 'fn'
+		void save(const std::string& fn);
+
+	private:
+		/// the file of the profile, empty if the profile is not stored
+		std::string profileFile;
+
+		/// the tuned thresholds by number of visible quantities
+		std::map<unsigned int, TunedThresholds> profile;
+
+		/// protects the profile, tuning is done while holding the lock
+		std::recursive_mutex lock;
+
+		/// measure the best thresholds on the sample 'sample'
+		TunedThresholds measure(ConfigurationSetPtr sample, const MinimizeOptions& o);
+
+		/// take an evenly spread sample of at most 'n' configurations from 'cs'
+		static ConfigurationSetPtr sampleOf(ConfigurationSetPtr cs, size_t n);
+
+		/// the time in seconds to minimize 'cs' with options 'o'
+		static double timeMinimization(ConfigurationSetPtr cs, const MinimizeOptions& o);
+	};
+
+}
+
+#endif
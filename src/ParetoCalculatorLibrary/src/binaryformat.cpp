@@ -0,0 +1,404 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Implementation of the binary file format
+//
+
+#include "binaryformat.h"
+#include "configuration.h"
+#include "columns.h"
+#include "quantity.h"
+#include "exceptions.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+#ifdef _WIN32
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Pareto;
+
+static const char binaryMagic[8] = { 'P', 'A', 'R', 'E', 'T', 'O', 'C', 'B' };
+static const uint32_t byteOrderMark = 0x01020304;
+
+/// the kinds of objects filed under the keys of a binary file
+enum class BinaryObject : uint32_t { QuantityType = 0, ConfigurationSpace = 1, ConfigurationSet = 2, String = 3 };
+
+
+/// Writes the fields of a binary file
+class BinaryWriter {
+public:
+	BinaryWriter(const std::string& fn) : os(fn, std::ios::out | std::ios::binary), fileName(fn) {
+		if (!os) {
+			throw EParetoCalculatorError("Cannot open binary file " + fn + " for writing");
+		}
+	}
+
+	void bytes(const void* b, size_t n) {
+		os.write(static_cast<const char*>(b), n);
+		offset += n;
+	}
+
+	template <typename T>
+	void value(T v) {
+		this->bytes(&v, sizeof(T));
+	}
+
+	void string(const std::string& s) {
+		this->value<uint32_t>((uint32_t)s.size());
+		this->bytes(s.data(), s.size());
+	}
+
+	/// pad the file to a multiple of 8 bytes
+	void align(void) {
+		static const char padding[8] = { 0 };
+		this->bytes(padding, (8 - offset % 8) % 8);
+	}
+
+	void close(void) {
+		os.close();
+		if (!os) {
+			throw EParetoCalculatorError("Error writing binary file " + fileName);
+		}
+	}
+
+private:
+	std::ofstream os;
+	std::string fileName;
+	uint64_t offset = 0;
+};
+
+/// A file mapped into memory for reading
+class MappedFile {
+public:
+	MappedFile(const std::string& fn) {
+#ifdef _WIN32
+		std::ifstream is(fn, std::ios::in | std::ios::binary);
+		if (!is) {
+			throw EParetoCalculatorError("Cannot open binary file " + fn);
+		}
+		buffer.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+		data = buffer.data();
+		size = buffer.size();
+#else
+		int fd = open(fn.c_str(), O_RDONLY);
+		if (fd < 0) {
+			throw EParetoCalculatorError("Cannot open binary file " + fn);
+		}
+		struct stat st;
+		if (fstat(fd, &st) == 0 && st.st_size > 0) {
+			size = (size_t)st.st_size;
+			void* m = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (m != MAP_FAILED) {
+				data = static_cast<const char*>(m);
+			}
+		}
+		::close(fd);
+		if (data == nullptr) {
+			throw EParetoCalculatorError("Cannot map binary file " + fn);
+		}
+#endif
+	}
+
+	~MappedFile() {
+#ifndef _WIN32
+		if (data != nullptr) {
+			munmap(const_cast<char*>(data), size);
+		}
+#endif
+	}
+
+	const char* data = nullptr;
+	size_t size = 0;
+
+private:
+#ifdef _WIN32
+	std::vector<char> buffer;
+#endif
+};
+
+/// Reads the fields of a mapped binary file, with bounds checks
+class BinaryReader {
+public:
+	BinaryReader(const MappedFile& f, const std::string& fn) : begin(f.data), p(f.data), end(f.data + f.size), fileName(fn) {}
+
+	const char* bytes(size_t n) {
+		if ((size_t)(end - p) < n) this->corrupt();
+		const char* b = p;
+		p += n;
+		return b;
+	}
+
+	template <typename T>
+	T value(void) {
+		T v;
+		std::memcpy(&v, this->bytes(sizeof(T)), sizeof(T));
+		return v;
+	}
+
+	std::string string(void) {
+		uint32_t n = this->value<uint32_t>();
+		return std::string(this->bytes(n), n);
+	}
+
+	/// the number of bytes that are not read yet
+	size_t remaining(void) const {
+		return (size_t)(end - p);
+	}
+
+	void align(void) {
+		this->bytes((8 - (p - begin) % 8) % 8);
+	}
+
+	[[noreturn]] void corrupt(void) {
+		throw EParetoCalculatorError("Binary file " + fileName + " is corrupt");
+	}
+
+private:
+	const char* begin;
+	const char* p;
+	const char* end;
+	std::string fileName;
+};
+
+
+void BinaryFormat::save(const BinaryEntries& entries, const std::string& fn) {
+
+	// number the objects and the types and spaces they depend on, dependencies first
+	std::vector<QuantityTypePtr> types;
+	std::vector<ConfigurationSpacePtr> spaces;
+	std::vector<ConfigurationSetPtr> sets;
+	std::map<const StorableObject*, uint32_t> index;
+	auto addType = [&](const QuantityTypePtr& t) {
+		if (index.insert(std::make_pair(t.get(), (uint32_t)types.size())).second) {
+			columnKindOf(*t);
+			types.push_back(t);
+		}
+	};
+	auto addSpace = [&](const ConfigurationSpacePtr& cs) {
+		if (index.find(cs.get()) != index.end()) return;
+		for (const QuantityTypePtr& t : cs->quantities) addType(t);
+		index[cs.get()] = (uint32_t)spaces.size();
+		spaces.push_back(cs);
+	};
+	for (const std::pair<std::string, StorableObjectPtr>& e : entries) {
+		if (e.second->isConfigurationSet()) {
+			ConfigurationSetPtr cs = std::dynamic_pointer_cast<ConfigurationSet>(e.second);
+			addSpace(cs->confspace);
+			if (index.insert(std::make_pair(cs.get(), (uint32_t)sets.size())).second) {
+				sets.push_back(cs);
+			}
+		}
+		else if (e.second->isConfigurationSpace()) {
+			addSpace(std::dynamic_pointer_cast<ConfigurationSpace>(e.second));
+		}
+		else if (e.second->isQuantityType()) {
+			addType(std::dynamic_pointer_cast<QuantityType>(e.second));
+		}
+	}
+
+	BinaryWriter w(fn);
+	w.bytes(binaryMagic, sizeof(binaryMagic));
+	w.value<uint32_t>(PARETO_BINARY_VERSION);
+	w.value<uint32_t>(byteOrderMark);
+	w.value<uint32_t>((uint32_t)types.size());
+	w.value<uint32_t>((uint32_t)spaces.size());
+	w.value<uint32_t>((uint32_t)sets.size());
+	w.value<uint32_t>((uint32_t)entries.size());
+
+	for (const QuantityTypePtr& t : types) {
+		w.string(t->name);
+		ColumnKind kind = columnKindOf(*t);
+		w.value<uint32_t>((uint32_t)kind);
+		if (kind == ColumnKind::Enum || kind == ColumnKind::Unordered) {
+			const QuantityType_Enum& et = static_cast<const QuantityType_Enum&>(*t);
+			w.value<uint32_t>((uint32_t)et.names.size());
+			for (const std::string& n : et.names) w.string(n);
+		}
+		else {
+			w.value<uint32_t>(0);
+		}
+	}
+
+	for (const ConfigurationSpacePtr& cs : spaces) {
+		// the names of the quantities by their index
+		std::vector<std::string> names(cs->quantities.size());
+		for (QuantityIntMap::const_iterator i = cs->quantityNames.begin(); i != cs->quantityNames.end(); i++) {
+			names[i->second] = i->first;
+		}
+		w.string(cs->name);
+		w.value<uint32_t>((uint32_t)cs->quantities.size());
+		for (unsigned int q = 0; q < cs->quantities.size(); q++) {
+			w.value<uint32_t>(index[cs->quantities[q].get()]);
+			w.string(names[q].empty() ? cs->quantities[q]->name : names[q]);
+			w.value<uint8_t>(cs->quantityVisibility[q] ? 1 : 0);
+		}
+	}
+
+	for (const ConfigurationSetPtr& cs : sets) {
+		ConfigurationColumnsPtr cc = cs->asColumns();
+		w.string(cs->name);
+		w.value<uint32_t>(index[cs->confspace.get()]);
+		w.value<uint64_t>(cc->size());
+		for (const QuantityColumn& c : cc->columns) {
+			w.align();
+			if (c.kind == ColumnKind::Real) w.bytes(c.reals.data(), c.reals.size() * sizeof(double));
+			else w.bytes(c.codes.data(), c.codes.size() * sizeof(int32_t));
+		}
+	}
+
+	for (const std::pair<std::string, StorableObjectPtr>& e : entries) {
+		w.string(e.first);
+		const StorableObject& o = *e.second;
+		if (o.isConfigurationSet()) w.value<uint32_t>((uint32_t)BinaryObject::ConfigurationSet);
+		else if (o.isConfigurationSpace()) w.value<uint32_t>((uint32_t)BinaryObject::ConfigurationSpace);
+		else if (o.isQuantityType()) w.value<uint32_t>((uint32_t)BinaryObject::QuantityType);
+		else w.value<uint32_t>((uint32_t)BinaryObject::String);
+		if (o.isString()) w.string(o.name);
+		else w.value<uint32_t>(index[&o]);
+	}
+	w.close();
+}
+
+
+BinaryEntries BinaryFormat::load(const std::string& fn) {
+	MappedFile f(fn);
+	BinaryReader r(f, fn);
+
+	if (std::memcmp(r.bytes(sizeof(binaryMagic)), binaryMagic, sizeof(binaryMagic)) != 0) {
+		throw EParetoCalculatorError("File " + fn + " is not a binary Pareto calculator file");
+	}
+	uint32_t version = r.value<uint32_t>();
+	if (version != PARETO_BINARY_VERSION) {
+		throw EParetoCalculatorError("Binary file " + fn + " has unsupported version " + std::to_string(version));
+	}
+	if (r.value<uint32_t>() != byteOrderMark) {
+		throw EParetoCalculatorError("Binary file " + fn + " has a different byte order");
+	}
+	uint32_t nrOfTypes = r.value<uint32_t>();
+	uint32_t nrOfSpaces = r.value<uint32_t>();
+	uint32_t nrOfSets = r.value<uint32_t>();
+	uint32_t nrOfEntries = r.value<uint32_t>();
+
+	std::vector<std::shared_ptr<QuantityType>> types;
+	for (uint32_t t = 0; t < nrOfTypes; t++) {
+		std::string name = r.string();
+		ColumnKind kind = (ColumnKind)r.value<uint32_t>();
+		uint32_t nrOfNames = r.value<uint32_t>();
+		if (kind == ColumnKind::Real || kind == ColumnKind::Integer) {
+			if (nrOfNames != 0) r.corrupt();
+			if (kind == ColumnKind::Real) types.push_back(std::make_shared<QuantityType_Real>(name));
+			else types.push_back(std::make_shared<QuantityType_Integer>(name));
+		}
+		else if (kind == ColumnKind::Enum || kind == ColumnKind::Unordered) {
+			QuantityType_EnumPtr et = (kind == ColumnKind::Enum) ? std::make_shared<QuantityType_Enum>(name) : std::make_shared<QuantityType_Enum_Unordered>(name);
+			for (uint32_t n = 0; n < nrOfNames; n++) et->addQuantity(r.string());
+			types.push_back(et);
+		}
+		else r.corrupt();
+	}
+
+	std::vector<ConfigurationSpacePtr> spaces;
+	for (uint32_t s = 0; s < nrOfSpaces; s++) {
+		ConfigurationSpacePtr cs = std::make_shared<ConfigurationSpace>(r.string());
+		uint32_t nrOfQuantities = r.value<uint32_t>();
+		for (uint32_t q = 0; q < nrOfQuantities; q++) {
+			uint32_t t = r.value<uint32_t>();
+			if (t >= types.size()) r.corrupt();
+			std::string qname = r.string();
+			cs->addQuantityAsVisibility(types[t], qname, r.value<uint8_t>() != 0);
+		}
+		spaces.push_back(cs);
+	}
+
+	std::vector<ConfigurationSetPtr> sets;
+	for (uint32_t s = 0; s < nrOfSets; s++) {
+		std::string name = r.string();
+		uint32_t sp = r.value<uint32_t>();
+		if (sp >= spaces.size()) r.corrupt();
+		uint64_t rows = r.value<uint64_t>();
+		ConfigurationColumnsPtr cc = std::make_shared<ConfigurationColumns>(spaces[sp]);
+		// the columns must fit in the rest of the file before they are allocated. Without
+		// columns, a set holds at most the empty configuration.
+		if (cc->columns.empty() && rows > 1) r.corrupt();
+		size_t needed = 0;
+		for (const QuantityColumn& c : cc->columns) {
+			size_t width = (c.kind == ColumnKind::Real) ? sizeof(double) : sizeof(int32_t);
+			if (rows > (r.remaining() - needed) / width) r.corrupt();
+			needed += (size_t)rows * width;
+		}
+		cc->resize((size_t)rows);
+		for (QuantityColumn& c : cc->columns) {
+			r.align();
+			if (c.kind == ColumnKind::Real) {
+				std::memcpy(c.reals.data(), r.bytes(c.reals.size() * sizeof(double)), c.reals.size() * sizeof(double));
+				continue;
+			}
+			std::memcpy(c.codes.data(), r.bytes(c.codes.size() * sizeof(int32_t)), c.codes.size() * sizeof(int32_t));
+			if (c.kind != ColumnKind::Integer) {
+				int32_t nrOfValues = (int32_t)std::static_pointer_cast<const QuantityType_Enum>(c.qtype)->quantities.size();
+				for (int32_t v : c.codes) {
+					if (v < 0 || v >= nrOfValues) r.corrupt();
+				}
+			}
+		}
+		// the rows are written in order, only sets from other sources need to be sorted
+		for (size_t k = 1; k < cc->size(); k++) {
+			if (!cc->rowSmaller(k - 1, *cc, k)) {
+				cc->normalize();
+				break;
+			}
+		}
+		sets.push_back(std::make_shared<ConfigurationSet>(cc, name));
+	}
+
+	BinaryEntries entries;
+	for (uint32_t e = 0; e < nrOfEntries; e++) {
+		std::string key = r.string();
+		BinaryObject kind = (BinaryObject)r.value<uint32_t>();
+		if (kind == BinaryObject::String) {
+			entries.push_back(std::make_pair(key, std::make_shared<StorableString>(r.string())));
+			continue;
+		}
+		uint32_t i = r.value<uint32_t>();
+		if (kind == BinaryObject::QuantityType && i < types.size()) entries.push_back(std::make_pair(key, types[i]));
+		else if (kind == BinaryObject::ConfigurationSpace && i < spaces.size()) entries.push_back(std::make_pair(key, spaces[i]));
+		else if (kind == BinaryObject::ConfigurationSet && i < sets.size()) entries.push_back(std::make_pair(key, sets[i]));
+		else r.corrupt();
+	}
+	return entries;
+}
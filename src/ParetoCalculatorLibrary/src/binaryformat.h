@@ -0,0 +1,76 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// A compact binary file format for quantity types, configuration spaces and
+// configuration sets, loaded by memory-mapping the file
+//
+
+#ifndef PARETO_BINARYFORMAT_H
+#define PARETO_BINARYFORMAT_H
+
+#include <string>
+#include <utility>
+#include <vector>
+#include "storage.h"
+
+/// the version of the binary file format that is written
+#define PARETO_BINARY_VERSION 1
+
+
+namespace Pareto {
+
+	/// The objects of a binary file with the keys under which they are filed in memory
+	using BinaryEntries = std::vector<std::pair<std::string, StorableObjectPtr>>;
+
+	/// Saves and loads objects of the calculator in a versioned binary file.
+	///
+	/// The file starts with a header with a magic string, the version of the format and a
+	/// byte order mark. It is followed by the quantity types, the configuration spaces in terms
+	/// of the types and the configuration sets. Every set is stored in columnar form: the
+	/// number of configurations followed by one block of raw values per quantity (doubles for
+	/// real quantities, 32-bit integers for integer quantities and value indices of enumerated
+	/// quantities), aligned to 8 bytes in the file. The file ends with the keys of the stored
+	/// objects. The quantity types and spaces that the stored sets depend on are always
+	/// included, so that every file can be loaded on its own.
+	///
+	/// Loading maps the file into memory and copies every value block into its column in a
+	/// single step. The sets are loaded in columnar storage mode.
+	class BinaryFormat {
+	public:
+		/// save the objects 'entries' with the quantity types and spaces they depend on to file 'fn'
+		static void save(const BinaryEntries& entries, const std::string& fn);
+
+		/// load the objects from file 'fn'. Throws an exception if the file is not a valid binary file.
+		static BinaryEntries load(const std::string& fn);
+	};
+
+}
+
+#endif
@@ -35,17 +35,35 @@
 
 #include <memory>
 #include <functional>
+#include <fstream>
+#include <iostream>
 #include <sstream>
 #include <math.h>
 
 #include "paretoparser_libxml.h"
+#include "paretoparser_dsl.h"
+#include "archive.h"
+#include "binaryformat.h"
+#include "columns.h"
+#include "dominance.h"
+#include "dominancefilter.h"
+#include "minimizetrace.h"
+#include "plan.h"
+#include "taskpool.h"
+#include "autotuner.h"
+#include "sortfilter.h"
+#include "sweep.h"
 
 
 using namespace Pareto;
 
-// initialize static members of ParetoCalculator class
-unsigned int ParetoCalculator::_filter_threshold = DEFAULT_FILTER_THRESHOLD;
-unsigned int ParetoCalculator::_minimize_threshold = DEFAULT_MINIMIZE_THRESHOLD;
+// the pool executing the parallel subproblems of a minimization with options 'o'
+static TaskPool& poolOf(const MinimizeOptions& o) {
+	return o.pool != nullptr ? *o.pool : TaskPool::shared();
+}
+
+// count a step of a minimization with options 'o' if statistics are requested
+#define COUNT_STEP(o, counter) if ((o).statistics != nullptr) (o).statistics->counter++
 
 
 ParetoCalculator::ParetoCalculator() {
@@ -53,52 +71,67 @@ ParetoCalculator::ParetoCalculator() {
 
 // compute product of two configuration sets with the given (product-) consiguration space
 ConfigurationSetPtr ParetoCalculator::productInSpace(ConfigurationSetPtr cs1, const ConfigurationSetPtr cs2, ConfigurationSpacePtr cspace) {
+	ProfileScope scope("productInSpace", cs1->size() + cs2->size());
+
+	// compute directly on the columns if either of the sets is in columnar storage
+	if (cs1->isColumnar() || cs2->isColumnar()) {
+		ConfigurationColumnsPtr cc = ConfigurationColumns::product(*cs1->asColumns(), *cs2->asColumns(), cspace);
+		return scope.result(std::make_shared<ConfigurationSet>(cc, "Product(" + cs1->name + ", " + cs2->name + ")"));
+	}
 
 	// create the result configuration set
 	ConfigurationSetPtr prod = std::make_shared<ConfigurationSet>(cspace, "Product(" + cs1->name + ", " + cs2->name + ")");
 
 	// iterate over all configurations from both sets
 	SetOfConfigurations::const_iterator i;
-	for (i = cs1->confs.begin(); i != cs1->confs.end(); i++) {
+	for (i = cs1->confs().begin(); i != cs1->confs().end(); i++) {
 		ConfigurationPtr c1 = *i;
 		SetOfConfigurations::const_iterator j;
-		for (j = cs2->confs.begin(); j != cs2->confs.end(); j++) {
+		for (j = cs2->confs().begin(); j != cs2->confs().end(); j++) {
 			ConfigurationPtr c2 = *j;
 			
 			// create the new configuration
-			ConfigurationPtr c = std::make_shared<Configuration>(cspace);
+			ConfigurationPtr c = prod->createConfiguration();
 			c->addQuantitiesOf(c1);
 			c->addQuantitiesOf(c2);
 			prod->addUniqueConfiguration(c);
 		}
 	}
 	// return the result
-	return prod;
+	return scope.result(prod);
 }
 
 // compute the product of two configuraiton sets
 ConfigurationSetPtr ParetoCalculator::product(ConfigurationSetPtr cs1, ConfigurationSetPtr cs2) {
+	ProfileScope scope("product", cs1->size() + cs2->size());
 	// Create a configuration space
 	ConfigurationSpacePtr cspace = cs1->confspace->productWith(cs2->confspace);
 	// compute the configurations
-	return ParetoCalculator::productInSpace(cs1, cs2, cspace);
+	return scope.result(ParetoCalculator::productInSpace(cs1, cs2, cspace));
 }
 
 // apply constraint to a configuration set, i.e., compute the intersection of the sets
 ConfigurationSetPtr ParetoCalculator::constraint(ConfigurationSetPtr cs1, ConfigurationSetPtr cs2) {
+	ProfileScope scope("constraint", cs1->size() + cs2->size());
 	// the following assumptions are made: 
 	// - ConfigurationSet is a sorted collection according to the order defined as ConfigurationSpace::LexicographicCompare
 	// - iterating over SetOfConfigurations provides the configurations in sorted order.
 
+	// compute directly on the columns if either of the sets is in columnar storage
+	if (cs1->isColumnar() || cs2->isColumnar()) {
+		ConfigurationColumnsPtr cc = ConfigurationColumns::constraint(*cs1->asColumns(), *cs2->asColumns());
+		return scope.result(std::make_shared<ConfigurationSet>(cc, "Constraint"));
+	}
+
 	// Make a new set to hold the result
 	ConfigurationSetPtr res = std::make_shared<ConfigurationSet>(cs1->confspace, "Constraint");
 
 	// make iterators for both sets
-	SetOfConfigurations::const_iterator i1 = cs1->confs.begin();
-	SetOfConfigurations::const_iterator i2 = cs2->confs.begin();
+	SetOfConfigurations::const_iterator i1 = cs1->confs().begin();
+	SetOfConfigurations::const_iterator i2 = cs2->confs().begin();
 
 	// while we have not traversed both sets to the end
-	while ((i1 != cs1->confs.end()) && (i2 != cs2->confs.end())) {
+	while ((i1 != cs1->confs().end()) && (i2 != cs2->confs().end())) {
 		// get the current configurations
 		ConfigurationPtr c1 = *i1;
 		ConfigurationPtr c2 = *i2;
@@ -117,51 +150,63 @@ ConfigurationSetPtr ParetoCalculator::constraint(ConfigurationSetPtr cs1, Config
 			i1++; i2++;
 		}
 	}
-	return res;
+	return scope.result(res);
 }
 
 // apply constraint given as a characteristing function of the configuration set of the constraint
 //ConfigurationSetPtr ParetoCalculator::constraint(ConfigurationSetPtr cs, bool (*testConstraint)(const Pareto::Configuration&)) {
 ConfigurationSetPtr ParetoCalculator::constraint(ConfigurationSetPtr cs, std::function <bool(const Configuration&)> testConstraint) {
+	ProfileScope scope("constraint", cs->size());
+
+	// on columns, test the configurations row by row
+	if (cs->isColumnar()) {
+		ConfigurationColumnsPtr cc = ConfigurationColumns::constraint(*cs->columns, [&testConstraint](const ConfigurationColumns& cols, size_t r) {
+			return testConstraint(*cols.configurationAt(r));
+		});
+		return scope.result(std::make_shared<ConfigurationSet>(cc, "Constraint"));
+	}
 
 	// construct result configuration set
 	ConfigurationSetPtr res = std::make_shared<ConfigurationSet>(cs->confspace, "Constraint");
 	SetOfConfigurations::const_iterator i;
-	for (i = cs->confs.begin(); i != cs->confs.end(); i++) {
+	for (i = cs->confs().begin(); i != cs->confs().end(); i++) {
 		ConfigurationPtr c = *i;
 		// add those configurations that pass the test
 		if (testConstraint(*c)) { res->addUniqueConfiguration(c); }
 	}
 	// return the result
-	return res;
+	return scope.result(res);
 }
 
 // compute the alternative (set union) of two configuration sets
 ConfigurationSetPtr ParetoCalculator::alternative(ConfigurationSetPtr cs1, ConfigurationSetPtr cs2) {
+	ProfileScope scope("alternative", cs1->size() + cs2->size());
 	
+	cs1->materialize();
+	cs2->materialize();
+
 	// create the resulting set
 	ConfigurationSetPtr res = std::make_shared<ConfigurationSet>(cs1->confspace, "Alternative");
 
 	// add all configurations of cs1
 	SetOfConfigurations::const_iterator i;
-	for (i = cs1->confs.begin(); i != cs1->confs.end(); i++) {
+	for (i = cs1->confs().begin(); i != cs1->confs().end(); i++) {
 		ConfigurationPtr c = *i;
 		res->addUniqueConfiguration(c);
 	}
 	// add all configurations of cs2
-	for (i = cs2->confs.begin(); i != cs2->confs.end(); i++) {
-		ConfigurationPtr nc = std::make_shared<Configuration>(res->confspace);
-		nc->addQuantitiesOf(*i);
+	for (i = cs2->confs().begin(); i != cs2->confs().end(); i++) {
+		ConfigurationPtr nc = res->createConfiguration(res->confspace, *i);
 		res->addConfiguration(nc);
 	}
 	// return the result
-	return res;
+	return scope.result(res);
 }
 
-// compute abstraction of configuration c in configuration space cs by abstracting quantity nr. n
-ConfigurationPtr conf_abstraction(ConfigurationSpacePtr cs, ConfigurationPtr c, unsigned int n) {
+// compute abstraction of configuration c for configuration set res by abstracting quantity nr. n
+ConfigurationPtr conf_abstraction(const ConfigurationSet& res, ConfigurationPtr c, unsigned int n) {
 
-	ConfigurationPtr nc = std::make_shared<Configuration>(cs);
+	ConfigurationPtr nc = res.createConfiguration();
 
 	// copy all quantities, except n
 	ListOfQuantityValues::const_iterator i;
@@ -174,30 +219,45 @@ ConfigurationPtr conf_abstraction(ConfigurationSpacePtr cs, ConfigurationPtr c,
 	return nc;
 }
 
-// compute abstraction of a configuration set by removing quantity number n
-ConfigurationSetPtr ParetoCalculator::abstraction(ConfigurationSetPtr cs, unsigned int n) {
+// compute the configuration space of the abstraction of quantity number n from space cs
+ConfigurationSpacePtr ParetoCalculator::abstractionSpace(ConfigurationSpacePtr cs, unsigned int n) {
 
 	// Create a configuration space
-	ConfigurationSpacePtr cspace = std::make_shared<ConfigurationSpace>("Abstract(" + cs->confspace->name + "," + cs->confspace->nameOfQuantityNr(n) + ")");
+	ConfigurationSpacePtr cspace = std::make_shared<ConfigurationSpace>("Abstract(" + cs->name + "," + cs->nameOfQuantityNr(n) + ")");
 
 	// create the new configurarion space
 	unsigned int k = 0;
-	for (ListOfQuantityTypes::const_iterator i = cs->confspace->quantities.begin(); i != cs->confspace->quantities.end(); i++, k++) {
+	for (ListOfQuantityTypes::const_iterator i = cs->quantities.begin(); i != cs->quantities.end(); i++, k++) {
 		if (k != n) {
-			cspace->addQuantityAsVisibility((*i), cs->confspace->nameOfQuantityNr(k), cs->confspace->quantityVisibility[k]);
+			cspace->addQuantityAsVisibility((*i), cs->nameOfQuantityNr(k), cs->quantityVisibility[k]);
 		}
 	}
+	return cspace;
+}
+
+// compute abstraction of a configuration set by removing quantity number n
+ConfigurationSetPtr ParetoCalculator::abstraction(ConfigurationSetPtr cs, unsigned int n) {
+	ProfileScope scope("abstraction", cs->size());
+
+	// Create a configuration space
+	ConfigurationSpacePtr cspace = ParetoCalculator::abstractionSpace(cs->confspace, n);
+
+	// compute directly on the columns for a set in columnar storage
+	if (cs->isColumnar()) {
+		ConfigurationColumnsPtr cc = ConfigurationColumns::abstraction(*cs->columns, n, cspace);
+		return scope.result(std::make_shared<ConfigurationSet>(cc, ("Abstraction(" + cs->name + ", ").append(n, 'a') + ")"));
+	}
 
 	// create the new configureation set
 	ConfigurationSetPtr res = std::make_shared<ConfigurationSet>(cspace, ("Abstraction(" + cs->name + ", ").append(n, 'a') + ")");
 
 	// add the configurations
 	SetOfConfigurations::const_iterator i;
-	for (i = cs->confs.begin(); i != cs->confs.end(); i++) {
-		ConfigurationPtr nc = conf_abstraction(cspace, (*i), n);
+	for (i = cs->confs().begin(); i != cs->confs().end(); i++) {
+		ConfigurationPtr nc = conf_abstraction(*res, (*i), n);
 		res->addConfiguration(nc);
 	}
-	return res;
+	return scope.result(res);
 }
 
 // abstract configuration set cs from quantity named s, s being a StorableString
@@ -250,15 +310,18 @@ ConfigurationSetPtr ParetoCalculator::hiding(ConfigurationSetPtr cs, const ListO
 
 ConfigurationSetPtr ParetoCalculator::hiding(ConfigurationSetPtr cs, const ListOfQuantityNames& lqn, ConfigurationSpacePtr targetSpace)
 {
+	ProfileScope scope("hiding", cs->size());
 	std::string nm = "Hide of " + cs->name;
+	if (cs->isColumnar()) {
+		return scope.result(std::make_shared<ConfigurationSet>(ConfigurationColumns::hiding(*cs->columns, targetSpace), nm));
+	}
 	ConfigurationSetPtr ncs = std::make_shared<ConfigurationSet>(targetSpace, nm);
 	SetOfConfigurations::iterator i;
-	for (i = cs->confs.begin(); i != cs->confs.end(); i++) {
-		ConfigurationPtr cf = std::make_shared<Configuration>(targetSpace);
-		cf->addQuantitiesOf(*i);
+	for (i = cs->confs().begin(); i != cs->confs().end(); i++) {
+		ConfigurationPtr cf = ncs->createConfiguration(targetSpace, *i);
 		ncs->addConfiguration(cf);
 	}
-	return ncs;
+	return scope.result(ncs);
 }
 
 
@@ -280,15 +343,22 @@ ConfigurationSetPtr ParetoCalculator::hiding(const ConfigurationSetPtr cs, const
 
 /// The Simple Cull minimization algorithm
 ConfigurationSetPtr ParetoCalculator::minimize(ConfigurationSetPtr cs) {
+	ProfileScope scope("minimize", cs->size());
 
 	// The naive way
 
+	// compute directly on the columns for a set in columnar storage
+	if (cs->isColumnar()) {
+		return scope.result(std::make_shared<ConfigurationSet>(ConfigurationColumns::minimize(*cs->columns), "min(" + cs->name + ")"));
+	}
+
 	// make the result configuration set
 	ConfigurationSetPtr res = std::make_shared<ConfigurationSet>(cs->confspace, "min(" + cs->name + ")");
+	const DominanceKernel& dk = cs->confspace->dominanceKernel();
 
 	// Note that the following gives a copy of the set of configurations
-	//SetOfConfigurations confs = cs->confs;
-	SetOfConfigurations confs(cs->confs);
+	//SetOfConfigurations confs = cs->confs();
+	SetOfConfigurations confs(cs->confs());
 
 	// invariants of the loop: 
 	// - the union of confs and res is Pareto equivalent to the original set cs.confs
@@ -309,7 +379,7 @@ ConfigurationSetPtr ParetoCalculator::minimize(ConfigurationSetPtr cs) {
 		SetOfConfigurations::iterator i = confs.begin();
 		while (i != confs.end()) {
 			const ConfigurationPtr& cc = *i;
-			if (*c <= *cc) { // remove cc as it is dominated and continue
+			if (dk.dominates(*c, *cc)) { // remove cc as it is dominated and continue
 				// for port to linux, which does not support (apparently) the erase returning a new iterator
 				// some people on the internet claim the following code is safe.
 				SetOfConfigurations::iterator j;
@@ -319,7 +389,7 @@ ConfigurationSetPtr ParetoCalculator::minimize(ConfigurationSetPtr cs) {
 				i = j;
 			}
 			else {
-				if (*cc <= *c) {
+				if (dk.dominates(*cc, *c)) {
 					// forget about c, it is dominated by cc. Continue with cc, but 
 					// start from the beginning to make sure all points it dominates will be removed.
 					c = cc;
@@ -332,56 +402,139 @@ ConfigurationSetPtr ParetoCalculator::minimize(ConfigurationSetPtr cs) {
 		// add the configuration c to the result
 		res->addUniqueConfiguration(c);
 	}
-	return res;
+	return scope.result(res);
 }
 
 /// Simple Cull minimization
 ConfigurationSetPtr ParetoCalculator::minimize_SC(ConfigurationSetPtr cs) {
+	ProfileScope scope("minimize_SC", cs->size());
 	// TOD: how does this method relate to the minimize function above?
 
+	cs->materialize();
 	ConfigurationSetPtr res = std::make_shared<ConfigurationSet>(cs->confspace, "min(" + cs->name + ")");
 
+	// the archive indexes the result, so that a new configuration is only compared to the
+	// configurations in the parts of the front that can dominate it or be dominated by it
+	ParetoArchive archive(res);
 	SetOfConfigurations::iterator i;
-	for (i = cs->confs.begin(); i != cs->confs.end(); i++) {
-		ConfigurationPtr c = *i;
-		res->addConfigurationAndFilter(c);
+	for (i = cs->confs().begin(); i != cs->confs().end(); i++) {
+		archive.insert(*i);
 	}
-	return res;
+	return scope.result(res);
+}
+
+/// Online simple cull minimization of a stream of configurations
+ConfigurationSetPtr ParetoCalculator::minimize_Online(ConfigurationReader& r, const std::string& name) {
+	ProfileScope scope("minimize_Online", 0);
+	ConfigurationSetPtr res;
+	std::unique_ptr<ParetoArchive> archive;
+	while (ConfigurationPtr c = r.next()) {
+		if (!archive) {
+			res = std::make_shared<ConfigurationSet>(c->confspace, name);
+			archive.reset(new ParetoArchive(res));
+		}
+		archive->insert(c);
+	}
+	return scope.result(res);
 }
 
-ConfigurationSetPtr ParetoCalculator::efficient_minimize_unordered(ConfigurationSetPtr cs, const QuantityName& qn) 
+/// Sort-Filter-Skyline minimization
+ConfigurationSetPtr ParetoCalculator::minimize_SFS(ConfigurationSetPtr cs) {
+	ProfileScope scope("minimize_SFS", cs->size());
+	// the columnar minimization sorts and filters the columns itself
+	if (cs->isColumnar()) {
+		return scope.result(ParetoCalculator::minimize(cs));
+	}
+
+	ConfigurationSetPtr res = std::make_shared<ConfigurationSet>(cs->confspace, "min(" + cs->name + ")");
+	std::vector<const Configuration*> confs;
+	std::vector<ConfigurationPtr> ptrs;
+	confs.reserve(cs->confs().size());
+	ptrs.reserve(cs->confs().size());
+	for (const ConfigurationPtr& c : cs->confs()) {
+		confs.push_back(c.get());
+		ptrs.push_back(c);
+	}
+	SortFilterSkyline sfs(*cs->confspace, confs);
+	for (size_t k : sfs.minimal()) {
+		res->confs().insert(ptrs[k]);
+	}
+	return scope.result(res);
+}
+
+ConfigurationSetPtr ParetoCalculator::efficient_minimize_unordered(ConfigurationSetPtr cs, const QuantityName& qn, const MinimizeOptions& o) 
 {
+	MinimizeTraceSpan span(o, MinimizePhase::Classes, cs->confs().size());
 
 	ConfigurationSetPtr res = std::make_shared<ConfigurationSet>(cs->confspace, "min(" + cs->name + ")");
 
 	// split confset into classes with same value for qn
 	ListOfConfSetPtr cls = splitClasses(cs, qn);
 
-	// minimize each class separately and add to result
+	// minimize each class separately after abstraction of qn
+	std::vector<ConfigurationSetPtr> mcls(cls->size());
+	std::vector<ProfileTransfer> work(cls->size());
+	std::vector<TaskPtr> tasks;
+	bool concurrent = o.parallel && cs->confs().size() >= o.grain;
+	unsigned int depth = ProfileCounters::depth;
+	unsigned int n = 0;
 	ListOfConfSet::iterator i;
-	for (i = cls->begin(); i != cls->end(); i++) {
+	for (i = cls->begin(); i != cls->end(); i++, n++) {
 		ConfigurationSetPtr cx = *i;
+		ConfigurationSetPtr* mcxa = &mcls[n];
+		ProfileTransfer* wx = &work[n];
+		auto minimizeClass = [cx, mcxa, wx, &qn, &o, depth]() {
+			ProfileContinuation recursion(depth, wx);
+			*mcxa = ParetoCalculator::efficient_minimize_recursive(ParetoCalculator::abstraction(cx, qn), o);
+		};
+		COUNT_STEP(o, classes);
+		if (concurrent) {
+			COUNT_STEP(o, tasks);
+			tasks.push_back(poolOf(o).fork(minimizeClass));
+		}
+		else {
+			minimizeClass();
+		}
+	}
+	// wait for all tasks, as they refer to local variables, before reporting an error
+	std::exception_ptr error;
+	for (const TaskPtr& t : tasks) {
+		try {
+			poolOf(o).join(t);
+		}
+		catch (...) {
+			if (!error) error = std::current_exception();
+		}
+	}
+	if (error) {
+		std::rethrow_exception(error);
+	}
+	for (const ProfileTransfer& w : work) {
+		w.addToCounters();
+	}
 
-		// abstract from quantity qn
-		ConfigurationSetPtr cxa = ParetoCalculator::abstraction(cx, qn);
-
-		//minimize *i after abstraction of qn
-		ConfigurationSetPtr mcxa = ParetoCalculator::efficient_minimize_recursive(cxa);
+	// add the results to the result set
+	n = 0;
+	for (i = cls->begin(); i != cls->end(); i++, n++) {
+		ConfigurationSetPtr cx = *i;
+		ConfigurationSetPtr mcxa = mcls[n];
 
 		//add configurations of the result after adding qn again
 
 		// add all configurations of mcxa
 		unsigned int p = cs->confspace->indexOfQuantity(qn);
 		SetOfConfigurations::iterator j;
-		for (j = mcxa->confs.begin(); j != mcxa->confs.end(); j++) {
-			ConfigurationPtr c = std::make_shared<Configuration>(cs->confspace);
+		for (j = mcxa->confs().begin(); j != mcxa->confs().end(); j++) {
+			ConfigurationPtr c = res->createConfiguration();
 			ConfigurationPtr c_mcxa = *j;
-			QuantityValuePtr x = (*cx->confs.begin())->getQuantity(p);
+			QuantityValuePtr x = (*cx->confs().begin())->getQuantity(p);
 			//c-> add quantities with x at the right place ....
 			for (unsigned int k = 0; k < mcxa->confspace->quantities.size(); k++) {
 				if (k == p) c->addQuantity(x);
 				c->addQuantity(c_mcxa->getQuantity(k));
 			}
+			// qn may be the last quantity
+			if (p == mcxa->confspace->quantities.size()) c->addQuantity(x);
 			res->addConfiguration(c);
 		}
 	}
@@ -412,136 +565,194 @@ ListOfConfSetPtr ParetoCalculator::splitClasses(ConfigurationSetPtr cs, const Qu
 }
 
 
-ConfigurationSetPtr ParetoCalculator::efficient_minimize_filter1(ConfigurationSetPtr csl, ConfigurationSetPtr csh, const QuantityName& qn) {
+ConfigurationSetPtr ParetoCalculator::efficient_minimize_filter1(ConfigurationSetPtr csl, ConfigurationSetPtr csh, const QuantityName& qn, const MinimizeOptions& o) {
 	// assume: csl is minimal set of configurations and csh is minimal set of configurations. Return 
 	// set of configurations with configurations from csh removed that are strictly dominated by configurations
 	// of csl.
 		// note: there cannot be any unordered quantities
 
-	if (csl->confs.size() == 0) { return csh; }
-	if (csh->confs.size() == 0) { return csh; }
+	if (csl->confs().size() == 0) { return csh; }
+	if (csh->confs().size() == 0) { return csh; }
+	MinimizeTraceSpan span(o, MinimizePhase::Filter1, csl->confs().size(), csh->confs().size());
 
 	ConfigurationSetPtr csla = ParetoCalculator::hiding(csl, qn);
 	ConfigurationSetPtr csha = ParetoCalculator::hiding(csh, qn, csla->confspace);
-	ConfigurationSetPtr filtered = ParetoCalculator::efficient_minimize_filter2(csla, csha);
+	if (span.trace() != nullptr) {
+		span.trace()->recordProjection(span.level(), csla->confs().size(), csha->confs().size());
+	}
+	ConfigurationSetPtr filtered = ParetoCalculator::efficient_minimize_filter2(csla, csha, o);
 	ConfigurationSetPtr res = std::make_shared<ConfigurationSet>(csl->confspace, "temp");
 	SetOfConfigurations::iterator i;
-	for (i = filtered->confs.begin(); i != filtered->confs.end(); i++) {
-		ConfigurationPtr c = std::make_shared<Configuration>(res->confspace);
-		c->addQuantitiesOf(*i);
+	for (i = filtered->confs().begin(); i != filtered->confs().end(); i++) {
+		ConfigurationPtr c = res->createConfiguration(res->confspace, *i);
 		res->addConfiguration(c);
 	}
 
 	return res;
 }
 
-QuantityValuePtr ParetoCalculator::efficient_minimize_getPivot(ConfigurationSetPtr cs, const QuantityName& qn) {
-	IndexOnTotalOrderConfigurationSet i = IndexOnTotalOrderConfigurationSet(qn, cs);
-	return i.at(i.size() / 2)->conf->getQuantity(qn);
-}
-
-// split the configuration set cs into two new configuration sets csl (low) and csh (high) based
-// on the pivot quantity value pivot for quantity qn
-// returns the 
-void ParetoCalculator::efficient_minimize_filter_split(ConfigurationSetPtr cs, const QuantityName& qn, QuantityValuePtr pivot, ConfigurationSetPtr* csl, ConfigurationSetPtr* csh) {
-	IndexOnTotalOrderConfigurationSet i = IndexOnTotalOrderConfigurationSet(qn, cs);
-	*csl = std::make_shared<ConfigurationSet>(cs->confspace, "temp");
-	*csh = std::make_shared <ConfigurationSet>(cs->confspace, "temp");
-	IndexOnTotalOrderConfigurationSet::iterator j;
-	// loop until pivot value 
-	for (j = i.begin(); j != i.end(); j++) {
-		ConfigurationPtr c = (*j)->conf;
-		// TODO: isn't it slow to lookup quantity by name? Use index?
-		if (*(c->getQuantity(qn)) < *pivot) {
-			(*csl)->addConfiguration(c); 
-		}
-		else break;
-	}
-	// continue loop till the end after the pivot
-	for (; j != i.end(); j++) {
-		ConfigurationPtr c = (*j)->conf;
-		(*csh)->addConfiguration(c);
-	}
+// sort 'cs' on quantity 'qn', traced as a phase of the minimization
+static SortedConfigurationRange sortedOnTotalOrder(const QuantityName& qn, ConfigurationSetPtr cs, const MinimizeOptions& o) {
+	MinimizeTraceSpan span(o, MinimizePhase::Index, cs->confs().size());
+	return SortedConfigurationRange(qn, cs);
 }
 
-
-
-ConfigurationSetPtr ParetoCalculator::efficient_minimize_filter2(ConfigurationSetPtr csa, ConfigurationSetPtr csb) {
+ConfigurationSetPtr ParetoCalculator::efficient_minimize_filter2(ConfigurationSetPtr csa, ConfigurationSetPtr csb, const MinimizeOptions& o) {
 	// assume: csl is minimal set of configurations and csh is minimal set of configurations. Return 
 	// set of configurations with configurations from csh removed that are strictly dominated by configurations
 	// of csl.
 	// note: there cannot be any unordered quantities
 
-	if (csa->confs.size() == 0) { return csb; }
-	if (csb->confs.size() == 0) { return csb; }
+	if (csa->confs().size() == 0) { return csb; }
+	if (csb->confs().size() == 0) { return csb; }
 
-	// check if it is better to switch to a simple cull
-	if (csa->confs.size() < ParetoCalculator::_filter_threshold) {
-		return ParetoCalculator::efficient_minimize_filter3(csa, csb);
+	// two or three totally ordered quantities are swept directly
+	if (o.sweepKernels && SweepKernel::appliesTo(*csb->confspace)) {
+		return ParetoCalculator::efficient_minimize_filter_sweep(csa, csb, o);
 	}
 
 	QuantityNamePtr qn = csa->confspace->getTotallyOrderedQuantity();
-	if (qn != nullptr) {
-		if (csb->confspace->nrOfVisibleQuantities() == 1) {
-			// there is only one, totally ordered quantity
-			return ParetoCalculator::efficient_minimize_filter4(csa, csb);
-		}
-		ConfigurationSetPtr total = ParetoCalculator::alternative(csa, csb);
-		QuantityValuePtr pivot = ParetoCalculator::efficient_minimize_getPivot(total, *qn);
-		ConfigurationSetPtr csal;
-		ConfigurationSetPtr csah;
-		ConfigurationSetPtr csbl;
-		ConfigurationSetPtr csbh;
-		ParetoCalculator::efficient_minimize_filter_split(csa, *qn, pivot, &csal, &csah);
-		ParetoCalculator::efficient_minimize_filter_split(csb, *qn, pivot, &csbl, &csbh);
-		ConfigurationSetPtr csblf = ParetoCalculator::efficient_minimize_filter2(csal, csbl);
-		ConfigurationSetPtr csbhft = ParetoCalculator::efficient_minimize_filter2(csah, csbh);
-		ConfigurationSetPtr csbhf = ParetoCalculator::efficient_minimize_filter1(csal, csbhft, *qn);
-		ConfigurationSetPtr res = ParetoCalculator::alternative(csblf, csbhf);
-		return res;
+	if (qn != nullptr && csb->confspace->nrOfVisibleQuantities() > 1 && csa->confs().size() >= o.filterThreshold) {
+		// sort both sets once, the recursion divides ranges of the sorted sets
+		return ParetoCalculator::efficient_minimize_filter2(sortedOnTotalOrder(*qn, csa, o), sortedOnTotalOrder(*qn, csb, o), *qn, o);
 	}
-	else {
-		return ParetoCalculator::efficient_minimize_filter3(csa, csb); // the simple way.
+
+	MinimizeTraceSpan span(o, MinimizePhase::Filter2, csa->confs().size(), csb->confs().size());
+	bool simpleCull = csa->confs().size() < o.filterThreshold || qn == nullptr;
+	if (span.trace() != nullptr) {
+		span.trace()->recordFilter2(span.level(), simpleCull);
+	}
+
+	if (simpleCull) {
+		return ParetoCalculator::efficient_minimize_filter3(csa, csb, o); // the simple way.
 	}
+	// there is only one, totally ordered quantity
+	return ParetoCalculator::efficient_minimize_filter4(csa, csb, o);
 }
 
-// remove from configuration set csb all points that are dominated by points from configuration set csa
-ConfigurationSetPtr ParetoCalculator::efficient_minimize_filter3(ConfigurationSetPtr csa, ConfigurationSetPtr csb) {
-	if (csa->confs.size() == 0) { return csb; }
-	if (csb->confs.size() == 0) { return csb; }
+// filter2 on ranges 'ra' and 'rb', sorted on the totally ordered quantity 'qn'
+ConfigurationSetPtr ParetoCalculator::efficient_minimize_filter2(const SortedConfigurationRange& ra, const SortedConfigurationRange& rb, const QuantityName& qn, const MinimizeOptions& o) {
+	if (ra.size() == 0 || rb.size() == 0) { return rb.copy(); }
 
-	// create a copy of the set csb as the initial result
-	ConfigurationSetPtr res = std::make_shared<ConfigurationSet>(csb);
-	
-	// then remove dominated points
-	SetOfConfigurations::iterator i, j;
-	// for each of the configurations in csa
-	for (i = csa->confs.begin(); i != csa->confs.end(); i++) {
-		// check each element of csb for being dominated
-		for (j = res->confs.begin(); j != res->confs.end();) {
-			ConfigurationPtr c = *j;
-			if (*(*i) <= *c) { // remove c as it is dominated and continue
-				// port to linux/gcc, set erase does not return a new iterator here
-				// some people on the internet say the following is safe...
-				SetOfConfigurations::iterator k;
-				k = j;
-				k++;
-				res->confs.erase(j);
-				j = k;
-			}
-			else j++;
+	MinimizeTraceSpan span(o, MinimizePhase::Filter2, ra.size(), rb.size());
+	bool simpleCull = ra.size() < o.filterThreshold;
+	if (span.trace() != nullptr) {
+		span.trace()->recordFilter2(span.level(), simpleCull);
+	}
+
+	// check if it is better to switch to a simple cull
+	if (simpleCull) {
+		return ParetoCalculator::efficient_minimize_filter3(ra.copy(), rb.copy(), o);
+	}
+
+	COUNT_STEP(o, filterSplits);
+	// the pivot is the median of both ranges together, they split at the first value not below it
+	const QuantityValue& pivot = SortedConfigurationRange::select(ra, rb, (ra.size() + rb.size()) / 2);
+	size_t na = ra.lower(pivot);
+	size_t nb = rb.lower(pivot);
+	if (na == 0 && nb == 0) {
+		// the pivot is the smallest value, split after the values equal to it instead
+		na = ra.upper(pivot);
+		nb = rb.upper(pivot);
+		if (na == ra.size() && nb == rb.size()) {
+			// all values are equal, the quantity does not decide dominance
+			return ParetoCalculator::efficient_minimize_filter1(ra.copy(), rb.copy(), qn, o);
 		}
 	}
+	SortedConfigurationRange ral = ra.range(0, na);
+	ConfigurationSetPtr csblf = ParetoCalculator::efficient_minimize_filter2(ral, rb.range(0, nb), qn, o);
+	ConfigurationSetPtr csbhft = ParetoCalculator::efficient_minimize_filter2(ra.range(na, ra.size()), rb.range(nb, rb.size()), qn, o);
+	ConfigurationSetPtr csbhf = ParetoCalculator::efficient_minimize_filter1(ral.copy(), csbhft, qn, o);
+	ConfigurationSetPtr res = ParetoCalculator::alternative(csblf, csbhf);
 	return res;
 }
 
+// remove from configuration set csb all points that are dominated by points from configuration set csa
+ConfigurationSetPtr ParetoCalculator::efficient_minimize_filter3(ConfigurationSetPtr csa, ConfigurationSetPtr csb, const MinimizeOptions& o) {
+	csa->materialize();
+	csb->materialize();
+	if (csa->confs().size() == 0) { return csb; }
+	if (csb->confs().size() == 0) { return csb; }
+	COUNT_STEP(o, simpleFilters);
+	MinimizeTraceSpan span(o, MinimizePhase::Filter3, csa->confs().size(), csb->confs().size());
+
+	// pack the visible quantities of both sets
+	std::vector<const Configuration*> ca, cb;
+	ca.reserve(csa->confs().size());
+	cb.reserve(csb->confs().size());
+	for (const ConfigurationPtr& c : csa->confs()) ca.push_back(c.get());
+	for (const ConfigurationPtr& c : csb->confs()) cb.push_back(c.get());
+	PackedConfigurations pa(*csa->confspace, ca);
+	PackedConfigurations pb(*csb->confspace, cb);
+
+	// determine the configurations of csb that are not dominated
+	std::vector<uint8_t> alive = DominanceFilter::survivors(pa, pb);
+
+	// collect them, in order, in the result
+	ConfigurationSetPtr res = std::make_shared<ConfigurationSet>(csb->confspace, csb->name);
+	size_t k = 0;
+	for (SetOfConfigurations::iterator j = csb->confs().begin(); j != csb->confs().end(); j++, k++) {
+		if (alive[k / PackedConfigurations::BlockSize] & (1 << (k % PackedConfigurations::BlockSize))) {
+			res->confs().insert(res->confs().end(), *j);
+		}
+	}
+	return res;
+}
 
-ConfigurationSetPtr ParetoCalculator::efficient_minimize_filter4(ConfigurationSetPtr csa, ConfigurationSetPtr csb) {
+
+// minimize a set with two or three totally ordered quantities with a sweep
+ConfigurationSetPtr ParetoCalculator::efficient_minimize_sweep(ConfigurationSetPtr cs, const MinimizeOptions& o) {
+	cs->materialize();
+	COUNT_STEP(o, sweeps);
+	MinimizeTraceSpan span(o, MinimizePhase::Sweep, cs->confs().size());
+	std::vector<const Configuration*> confs;
+	std::vector<ConfigurationPtr> ptrs;
+	confs.reserve(cs->confs().size());
+	ptrs.reserve(cs->confs().size());
+	for (const ConfigurationPtr& c : cs->confs()) {
+		confs.push_back(c.get());
+		ptrs.push_back(c);
+	}
+	ConfigurationSetPtr res = std::make_shared<ConfigurationSet>(cs->confspace, "min(" + cs->name + ")");
+	for (size_t k : SweepKernel::minimal(*cs->confspace, confs)) {
+		// the positions are increasing, so the result is built in order
+		res->confs().insert(res->confs().end(), ptrs[k]);
+	}
+	return res;
+}
+
+// remove from configuration set csb all points that are dominated by points from configuration set csa,
+// both with two or three totally ordered quantities, with a sweep
+ConfigurationSetPtr ParetoCalculator::efficient_minimize_filter_sweep(ConfigurationSetPtr csa, ConfigurationSetPtr csb, const MinimizeOptions& o) {
+	csa->materialize();
+	csb->materialize();
+	COUNT_STEP(o, sweeps);
+	MinimizeTraceSpan span(o, MinimizePhase::FilterSweep, csa->confs().size(), csb->confs().size());
+	std::vector<const Configuration*> ca, cb;
+	std::vector<ConfigurationPtr> pb;
+	ca.reserve(csa->confs().size());
+	cb.reserve(csb->confs().size());
+	pb.reserve(csb->confs().size());
+	for (const ConfigurationPtr& c : csa->confs()) ca.push_back(c.get());
+	for (const ConfigurationPtr& c : csb->confs()) {
+		cb.push_back(c.get());
+		pb.push_back(c);
+	}
+	ConfigurationSetPtr res = std::make_shared<ConfigurationSet>(csb->confspace, csb->name);
+	for (size_t k : SweepKernel::undominated(*csb->confspace, ca, cb)) {
+		res->confs().insert(res->confs().end(), pb[k]);
+	}
+	return res;
+}
+
+ConfigurationSetPtr ParetoCalculator::efficient_minimize_filter4(ConfigurationSetPtr csa, ConfigurationSetPtr csb, const MinimizeOptions& o) {
 	// assume: csa and csb are 1-dimensional spaces with a total order
 		//find min of csa
 
-	if (csa->confs.size() == 0) { return csb; }
-	if (csb->confs.size() == 0) { return csb; }
+	if (csa->confs().size() == 0) { return csb; }
+	if (csb->confs().size() == 0) { return csb; }
+	COUNT_STEP(o, simpleFilters);
+	MinimizeTraceSpan span(o, MinimizePhase::Filter4, csa->confs().size(), csb->confs().size());
 
 	QuantityValuePtr v = nullptr, w;
 
@@ -550,7 +761,7 @@ ConfigurationSetPtr ParetoCalculator::efficient_minimize_filter4(ConfigurationSe
 
 	SetOfConfigurations::iterator i;
 	// for all configurations in set A
-	for (i = csa->confs.begin(); i != csa->confs.end(); i++) {
+	for (i = csa->confs().begin(); i != csa->confs().end(); i++) {
 		// for the first configuration set v to quantity n
 		if (!v) {
 			v = (*i)->getQuantity(n); 
@@ -561,18 +772,19 @@ ConfigurationSetPtr ParetoCalculator::efficient_minimize_filter4(ConfigurationSe
 			v = w; 
 		}
 	}
-	//	return all confs of b which are smaller than a.
+	//	return all confs of b which are smaller than the minimum of a, the others are dominated.
 	ConfigurationSetPtr res = std::make_shared<ConfigurationSet>(csb->confspace, "temp");
-	for (i = csb->confs.begin(); i != csb->confs.end(); i++) {
-		// TODO: is this correct? Seems all configuraitons are being added!
-		res->addConfiguration(*i);
+	for (i = csb->confs().begin(); i != csb->confs().end(); i++) {
+		if (!(*v <= *((*i)->getQuantity(n)))) {
+			res->addConfiguration(*i);
+		}
 	}
 	return res;
 }
 
 
 
-ConfigurationSetPtr ParetoCalculator::efficient_minimize_dcmerge(ConfigurationSetPtr csl, ConfigurationSetPtr csh, const QuantityName& qn, const QuantityValue& v) 
+ConfigurationSetPtr ParetoCalculator::efficient_minimize_dcmerge(ConfigurationSetPtr csl, ConfigurationSetPtr csh, const QuantityName& qn, const QuantityValue& v, const MinimizeOptions& o) 
 {
 	// csl and csh are minimized and sorted on qn, such that for any cl in csl and ch in csh, cl(qn)<=ch(qn)
 	// project on cut plane "hide qn"
@@ -580,7 +792,7 @@ ConfigurationSetPtr ParetoCalculator::efficient_minimize_dcmerge(ConfigurationSe
 	if (csl->confspace->nrOfVisibleQuantities() == 1) {
 		// csl should contain only one element which dominates the element of csh
 #ifdef _DEBUG
-		if (csl->confs.size() > 1) { // for debugging, just checking... shouldn't happen
+		if (csl->confs().size() > 1) { // for debugging, just checking... shouldn't happen
 			throw EParetoCalculatorError("Should not be reachable. minimize_dcmerge()\n");
 		}
 #endif
@@ -590,93 +802,160 @@ ConfigurationSetPtr ParetoCalculator::efficient_minimize_dcmerge(ConfigurationSe
 	// unify the configuration spaces before merge
 	csl->adoptConfigurationSpaceOf(csh);
 
-	ConfigurationSetPtr cshf = ParetoCalculator::efficient_minimize_filter1(csl, csh, qn);
+	COUNT_STEP(o, merges);
+	MinimizeTraceSpan span(o, MinimizePhase::Merge, csl->confs().size(), csh->confs().size());
+	ConfigurationSetPtr cshf = ParetoCalculator::efficient_minimize_filter1(csl, csh, qn, o);
 	ConfigurationSetPtr csp = ParetoCalculator::alternative(csl, cshf);
 
 	return csp;
 }
 
 
-ConfigurationSetPtr ParetoCalculator::efficient_minimize_totally_ordered_recursive(ConfigurationSetPtr cs, const QuantityName& qn) {
+ConfigurationSetPtr ParetoCalculator::efficient_minimize_totally_ordered_recursive(const SortedConfigurationRange& r, const QuantityName& qn, const MinimizeOptions& o) {
 	// Is called in the N-recursive part of totall_ordered
+	ProfileRecursion level;
 
 	// Base case of recursion, when problem size small enough use
-	// ordinary minimization
-	if (cs->confs.size() < ParetoCalculator::_minimize_threshold) {
-		return ParetoCalculator::minimize(cs);
+	// ordinary minimization. Ranges of fewer than two configurations cannot be split.
+	if (r.size() < 2 || r.size() < o.minimizeThreshold) {
+		return ParetoCalculator::efficient_minimize_base(r.copy(), o);
 	}
 
-	return ParetoCalculator::efficient_minimize_totally_ordered(cs, qn);
+	return ParetoCalculator::efficient_minimize_totally_ordered(r, qn, o);
 }
 
 
-ConfigurationSetPtr ParetoCalculator::efficient_minimize_totally_ordered(ConfigurationSetPtr cs, const QuantityName& qn) 
+ConfigurationSetPtr ParetoCalculator::efficient_minimize_totally_ordered(ConfigurationSetPtr cs, const QuantityName& qn, const MinimizeOptions& o) 
 {
-	QuantityValuePtr v;
-	// split the set in two; v will be the value used for splitting
-	ListOfConfSetPtr l = ParetoCalculator::splitLowHigh(cs, qn, &v);
-	ListOfConfSet::iterator p = l->begin();
-
-	// recursively minimize the lower set
-	ConfigurationSetPtr mcsl = ParetoCalculator::efficient_minimize_totally_ordered_recursive(*p, qn);
-	p++;
-	// recursively minimize the higher set
-	ConfigurationSetPtr mcsh = ParetoCalculator::efficient_minimize_totally_ordered_recursive(*p, qn);
-	// merge the results
-	ConfigurationSetPtr res = ParetoCalculator::efficient_minimize_dcmerge(mcsl, mcsh, qn, *v);
-
-	return res;
+	// sort the set once, the recursion divides ranges of the sorted set
+	return ParetoCalculator::efficient_minimize_totally_ordered(sortedOnTotalOrder(qn, cs, o), qn, o);
 }
 
-ListOfConfSetPtr ParetoCalculator::splitLowHigh(ConfigurationSetPtr cs, const QuantityName& qn, QuantityValuePtr* v) {
-	// pre: size of cs is at least two.
-
-	ListOfConfSetPtr lcs = std::make_shared<ListOfConfSet>();
-
-	//	create index on cs,qn
-	IndexOnTotalOrderConfigurationSet i(qn, cs);
 
-	unsigned int mid = (unsigned int) (i.size() / 2);
-//	*v = & const_cast<QuantityValue&>((i.at(mid).conf->getQuantity(qn)));  // try to get rid of the embarrasing const_casts...
-	*v = i.at(mid)->conf->getQuantity(qn); 
+ConfigurationSetPtr ParetoCalculator::efficient_minimize_totally_ordered(const SortedConfigurationRange& r, const QuantityName& qn, const MinimizeOptions& o) 
+{
+	// split the range in two halves; v will be the value used for splitting
+	size_t mid = r.size() / 2;
+	const QuantityValue& v = r.value(mid);
+	SortedConfigurationRange rl = r.range(0, mid);
+	SortedConfigurationRange rh = r.range(mid, r.size());
+	{
+		MinimizeTraceSpan span(o, MinimizePhase::Split, r.size());
+		if (span.trace() != nullptr) {
+			span.trace()->recordSplit(span.level(), rl.size(), rh.size());
+		}
+	}
+	COUNT_STEP(o, splits);
+
+	ConfigurationSetPtr mcsl, mcsh;
+	if (o.parallel && r.size() >= o.grain) {
+		// minimize the lower half concurrently with the higher half
+		TaskPool& pool = poolOf(o);
+		COUNT_STEP(o, tasks);
+		unsigned int depth = ProfileCounters::depth;
+		ProfileTransfer work;
+		TaskPtr t = pool.fork([&mcsl, &work, rl, &qn, &o, depth]() {
+			ProfileContinuation recursion(depth, &work);
+			mcsl = ParetoCalculator::efficient_minimize_totally_ordered_recursive(rl, qn, o);
+		});
+		try {
+			mcsh = ParetoCalculator::efficient_minimize_totally_ordered_recursive(rh, qn, o);
+		}
+		catch (...) {
+			// the task refers to local variables, it must finish first
+			try { pool.join(t); } catch (...) {}
+			throw;
+		}
+		pool.join(t);
+		work.addToCounters();
+	}
+	else {
+		// recursively minimize the lower half
+		mcsl = ParetoCalculator::efficient_minimize_totally_ordered_recursive(rl, qn, o);
+		// recursively minimize the higher half
+		mcsh = ParetoCalculator::efficient_minimize_totally_ordered_recursive(rh, qn, o);
+	}
+	// merge the results
+	ConfigurationSetPtr res = ParetoCalculator::efficient_minimize_dcmerge(mcsl, mcsh, qn, v, o);
 
-	lcs->push_back(i.copyFromTo(0, mid - 1));
-	lcs->push_back(i.copyFromTo(mid, (int) (i.size() - 1)));
-	return lcs;
+	return res;
 }
 
 
 ConfigurationSetPtr ParetoCalculator::efficient_minimize(ConfigurationSetPtr cs, unsigned int filter_threshold,
 	unsigned int minimize_threshold)
 {
-	ParetoCalculator::_filter_threshold = filter_threshold;
-	ParetoCalculator::_minimize_threshold = minimize_threshold;
-	return ParetoCalculator::efficient_minimize_recursive(cs);
+	MinimizeOptions o;
+	o.filterThreshold = filter_threshold;
+	o.minimizeThreshold = minimize_threshold;
+	return ParetoCalculator::efficient_minimize(cs, o);
+}
+
+ConfigurationSetPtr ParetoCalculator::efficient_minimize(ConfigurationSetPtr cs, const MinimizeOptions& options)
+{
+	ProfileScope scope("efficient_minimize", cs->size());
+	// the recursion of a columnar set works on the view on its columns, which is materialized
+	// before any task reads it. The result is packed into columns again.
+	if (cs->isColumnar()) {
+		cs->materialize();
+	}
+	MinimizeTraceSpan span(options, MinimizePhase::Minimize, cs->size());
+	ConfigurationSetPtr res;
+	if (options.tuner != nullptr) {
+		res = ParetoCalculator::efficient_minimize_recursive(cs, options.tuner->tune(cs, options));
+	}
+	else {
+		res = ParetoCalculator::efficient_minimize_recursive(cs, options);
+	}
+	if (cs->isColumnar() && !res->isColumnar()) {
+		res = res->toColumnar();
+	}
+	return scope.result(res);
+}
+
+// minimize a subproblem with the base-case algorithm of the options
+ConfigurationSetPtr ParetoCalculator::efficient_minimize_base(ConfigurationSetPtr cs, const MinimizeOptions& o) {
+	COUNT_STEP(o, baseCases);
+	MinimizeTraceSpan span(o, MinimizePhase::Base, cs->confs().size());
+	switch (o.baseCase) {
+	case MinimizeAlgorithm::SimpleCull:
+		return ParetoCalculator::minimize_SC(cs);
+	case MinimizeAlgorithm::SortFilter:
+		return ParetoCalculator::minimize_SFS(cs);
+	default:
+		return ParetoCalculator::minimize(cs);
+	}
 }
 
 
 //
-ConfigurationSetPtr ParetoCalculator::efficient_minimize_recursive(ConfigurationSetPtr cs) {
+ConfigurationSetPtr ParetoCalculator::efficient_minimize_recursive(ConfigurationSetPtr cs, const MinimizeOptions& o) {
 
 	// The efficient way
+	ProfileRecursion level;
+
+	// Two or three totally ordered quantities are swept directly
+	if (o.sweepKernels && SweepKernel::appliesTo(*cs->confspace)) {
+		return ParetoCalculator::efficient_minimize_sweep(cs, o);
+	}
 
 	// Base case of recursion, when problem size small enough use
 	// ordinary minimization
-	if (cs->confs.size() < ParetoCalculator::_minimize_threshold) {
-		return ParetoCalculator::minimize(cs);
+	if (cs->confs().size() < 2 || cs->confs().size() < o.minimizeThreshold) {
+		return ParetoCalculator::efficient_minimize_base(cs, o);
 	}
 
 	QuantityNamePtr qn = cs->confspace->getUnorderedQuantity();
 	if (qn != nullptr) {
-		return ParetoCalculator::efficient_minimize_unordered(cs, *qn);
+		return ParetoCalculator::efficient_minimize_unordered(cs, *qn, o);
 	}
 	else {
 		qn = cs->confspace->getTotallyOrderedQuantity();
 		if (qn != nullptr) {
-			return ParetoCalculator::efficient_minimize_totally_ordered(cs, *qn);
+			return ParetoCalculator::efficient_minimize_totally_ordered(cs, *qn, o);
 		}
 		else {
-			return ParetoCalculator::minimize(cs);
+			return ParetoCalculator::efficient_minimize_base(cs, o);
 		}
 	}
 }
@@ -684,7 +963,7 @@ ConfigurationSetPtr ParetoCalculator::efficient_minimize_recursive(Configuration
 
 void ParetoCalculator::store(const StorableObjectPtr o, const std::string& key) {
 	// put the object in memory
-	memory.insert(std::pair<const std::string, StorableObjectPtr>(key, o));
+	memory.insert(std::pair<const std::string, StorableObjectPtr>(key, this->inStorageMode(o)));
 }
 
 void ParetoCalculator::store(StorableObjectPtr o) {
@@ -758,7 +1037,37 @@ void ParetoCalculator::eraseMemory(void)
 
 
 void ParetoCalculator::push(const StorableObjectPtr o) {
-	stack.push(o);
+	stack.push(this->inStorageMode(o));
+}
+
+void ParetoCalculator::setStorageMode(StorageMode m)
+{
+	this->storageMode = m;
+}
+
+void ParetoCalculator::enableAutotuning(const std::string& profile)
+{
+	this->tuner = profile.empty() ? std::make_shared<ThresholdTuner>() : std::make_shared<ThresholdTuner>(profile);
+}
+
+ThresholdTuner& ParetoCalculator::thresholdTuner(void)
+{
+	if (!this->tuner) {
+		this->tuner = std::make_shared<ThresholdTuner>();
+	}
+	return *this->tuner;
+}
+
+StorableObjectPtr ParetoCalculator::inStorageMode(const StorableObjectPtr o) const
+{
+	// configuration sets in node storage are packed into columns in columnar mode
+	if (this->storageMode == StorageMode::Columnar && o->isConfigurationSet()) {
+		ConfigurationSetPtr cs = std::dynamic_pointer_cast<ConfigurationSet>(o);
+		if (!cs->isColumnar()) {
+			return cs->toColumnar();
+		}
+	}
+	return o;
 }
 
 void ParetoCalculator::push(const std::string& oname)
@@ -840,7 +1149,7 @@ void ParetoCalculator::minimize(void) {
 	this->push(csn);
 }
 
-void ParetoCalculator::efficient_minimize(void) {
+void ParetoCalculator::minimize_SFS(void) {
 	// operate on the stack
 	StorableObjectPtr so = this->pop();
 	if (!so->isConfigurationSet()) {
@@ -848,10 +1157,33 @@ void ParetoCalculator::efficient_minimize(void) {
 		return;
 	}
 	ConfigurationSetPtr cs = std::dynamic_pointer_cast<ConfigurationSet>(so);
-	ConfigurationSetPtr csn = this->efficient_minimize_recursive(cs);
+	ConfigurationSetPtr csn = this->minimize_SFS(cs);
 	this->push(csn);
 }
 
+void ParetoCalculator::efficient_minimize(void) {
+	this->efficient_minimize(MinimizeOptions());
+}
+
+void ParetoCalculator::efficient_minimize(const MinimizeOptions& options) {
+	// operate on the stack
+	StorableObjectPtr so = this->pop();
+	if (!so->isConfigurationSet()) {
+		throw EParetoCalculatorError("Minimization requires configuration set on the stack");
+		return;
+	}
+	ConfigurationSetPtr cs = std::dynamic_pointer_cast<ConfigurationSet>(so);
+	// use the thresholds of the tuning profile and the trace of the calculator
+	MinimizeOptions o = options;
+	if (this->tuner && o.tuner == nullptr) {
+		o.tuner = this->tuner.get();
+	}
+	if (this->trace && o.trace == nullptr) {
+		o.trace = this->trace.get();
+	}
+	this->push(this->efficient_minimize(cs, o));
+}
+
 void ParetoCalculator::product(void) {
 	// operate on the stack
 	StorableObjectPtr o1 = this->pop();
@@ -916,6 +1248,44 @@ void ParetoCalculator::setStatusCallbackObject(StatusCallback* o) {
 	statusObject = o;
 }
 
+void ParetoCalculator::setProfilingCallbackObject(ProfilingCallback* o) {
+	profilingObject = o;
+}
+
+/// the number of configurations of the configuration sets in the range of the stack from 'b' to 'e'
+static size_t configurationsIn(StackOfStorageObjects::const_iterator b, StackOfStorageObjects::const_iterator e) {
+	size_t n = 0;
+	for (StackOfStorageObjects::const_iterator i = b; i != e; i++) {
+		if ((*i)->isConfigurationSet()) {
+			n += std::dynamic_pointer_cast<const ConfigurationSet>(*i)->size();
+		}
+	}
+	return n;
+}
+
+void ParetoCalculator::execute(ParetoCalculatorOperation& op) {
+	if (this->profilingObject == nullptr) {
+		op.executeOn(*this);
+		return;
+	}
+
+	// the operands are the objects the operation removes from the stack and its results
+	// the objects it leaves in their place
+	StackOfStorageObjects before = this->stack;
+	std::string name = op.describe();
+	if (name.empty()) {
+		name = op.message.substr(0, op.message.find('\n'));
+	}
+	ProfileScope scope(this->profilingObject, name);
+	op.executeOn(*this);
+	size_t k = 0;
+	while (k < before.size() && k < this->stack.size() && before[k] == this->stack[k]) {
+		k++;
+	}
+	scope.setInputSize(configurationsIn(before.begin() + k, before.end()));
+	scope.setOutputSize(configurationsIn(this->stack.begin() + k, this->stack.end()));
+}
+
 void ParetoCalculator::initParser() {
 	if (parser == nullptr) {
 		this->setStatus("Creating XML Parser");
@@ -924,7 +1294,22 @@ void ParetoCalculator::initParser() {
 	}
 }
 
+/// test if file name 'fn' has the extension of a .pareto specification
+static bool isDSLFileName(const std::string& fn) {
+	return fn.size() >= 7 && fn.compare(fn.size() - 7, 7, ".pareto") == 0;
+}
+
 void ParetoCalculator::LoadFile(const std::string& fn) {
+	if (isDSLFileName(fn)) {
+		this->setStatus("Loading .pareto input");
+		this->verbose("Loading .pareto input...");
+		this->dslParser = std::make_shared<ParetoDSLParser>(*this);
+		this->dslParser->LoadFile(fn);
+		this->setStatus(".pareto input loaded");
+		this->verbose("loaded\n");
+		return;
+	}
+	this->dslParser = nullptr;
 	this->initParser();
 	this->setStatus("Loading XML input");
 	this->verbose("Loading XML input...");
@@ -936,7 +1321,9 @@ void ParetoCalculator::LoadFile(const std::string& fn) {
 void ParetoCalculator::LoadQuantityTypes() {
 	this->setStatus("Loading quantity types from input");
 	this->verbose("Loading quantity types from input...");
-	parser->LoadQuantityTypes();
+	if (!this->dslParser) {
+		parser->LoadQuantityTypes();
+	}
 	this->setStatus("Quantity types loaded");
 	this->verbose("loaded\n");
 }
@@ -944,7 +1331,9 @@ void ParetoCalculator::LoadQuantityTypes() {
 void ParetoCalculator::LoadConfigurationSpaces() {
 	this->setStatus("Loading configuration spaces from input");
 	this->verbose("Loading configuration spaces from input...");
-	parser->LoadConfigurationSpaces();
+	if (!this->dslParser) {
+		parser->LoadConfigurationSpaces();
+	}
 	this->setStatus("Configuration spaces loaded");
 	this->verbose("loaded\n");
 }
@@ -952,7 +1341,9 @@ void ParetoCalculator::LoadConfigurationSpaces() {
 void ParetoCalculator::LoadConfigurationSets() {
 	this->setStatus("Loading configuration sets from input");
 	this->verbose("Loading configuration sets from input...");
-	parser->LoadConfigurationSets();
+	if (!this->dslParser) {
+		parser->LoadConfigurationSets();
+	}
 	this->setStatus("Configuration sets loaded");
 	this->verbose("loaded\n");
 }
@@ -960,27 +1351,132 @@ void ParetoCalculator::LoadConfigurationSets() {
 void ParetoCalculator::LoadOperations() {
 	this->setStatus("Executing operations from input");
 	this->verbose("Executing operations from input\n");
-	parser->LoadOperations();
+	if (this->dslParser) {
+		this->executeOperations(this->dslParser->operations);
+	}
+	else {
+		parser->LoadOperations();
+	}
 	this->setStatus("Operations from input executed");
 	this->verbose("Operations from input executed\n");
 }
 
+void ParetoCalculator::executeOperations(const ListOfOperations& operations) {
+	ListOfOperations ops = operations;
+
+	// fuse products with the constraints and minimizations that follow them
+	if (this->streamingPipelines) {
+		ops = POperation_ProductPipeline::fuse(ops);
+	}
+
+	// compile, optimize and execute the operations as a plan
+	if (this->optimizePlans || this->concurrentOperations) {
+		OperationPlan plan(ops, *this);
+		if (this->optimizePlans) {
+			plan.optimize();
+			std::ostringstream listing;
+			plan.streamOn(listing);
+			this->verbose("optimized plan of operations:\n" + listing.str());
+		}
+		plan.executeOn(*this, this->concurrentOperations ? &TaskPool::shared() : nullptr);
+		return;
+	}
+
+	// execute the operations
+	for (ListOfOperations::iterator i = ops.begin(); i != ops.end(); i++) {
+		(*i)->announce(*this);
+		this->execute(**i);
+	}
+}
+
+/// test if file name 'fn' has the extension of an XML file
+static bool isXMLFileName(const std::string& fn) {
+	return fn.size() >= 4 && fn.compare(fn.size() - 4, 4, ".xml") == 0;
+}
+
 void ParetoCalculator::SaveAllFile(const std::string& fn) {
-	this->setStatus("Saving XML file");
-	this->verbose("Saving XML file...");
-	parser->SaveAll(fn);
-	this->setStatus("XML input saved");
+	if (isXMLFileName(fn)) {
+		this->initParser();
+		this->setStatus("Saving XML file");
+		this->verbose("Saving XML file...");
+		parser->SaveAll(fn);
+		this->setStatus("XML input saved");
+		this->verbose("saved\n");
+		return;
+	}
+	this->setStatus("Saving binary file");
+	this->verbose("Saving binary file...");
+	BinaryEntries entries(this->memory.begin(), this->memory.end());
+	BinaryFormat::save(entries, fn);
+	this->setStatus("Binary file saved");
 	this->verbose("saved\n");
 }
 
 void ParetoCalculator::SaveItemFile(const std::string& itemToSave, const std::string& fn) {
-	this->setStatus("Saving XML item ");
-	this->verbose("Saving XML item...");
-	parser->Save(itemToSave, fn);
-	this->setStatus("XML item saved");
+	if (isXMLFileName(fn)) {
+		this->initParser();
+		this->setStatus("Saving XML item ");
+		this->verbose("Saving XML item...");
+		parser->Save(itemToSave, fn);
+		this->setStatus("XML item saved");
+		this->verbose("saved\n");
+		return;
+	}
+	this->setStatus("Saving binary item");
+	this->verbose("Saving binary item...");
+	BinaryEntries entries;
+	entries.push_back(std::make_pair(itemToSave, this->retrieve(itemToSave)));
+	BinaryFormat::save(entries, fn);
+	this->setStatus("Binary item saved");
 	this->verbose("saved\n");
 }
 
+void ParetoCalculator::LoadBinaryFile(const std::string& fn) {
+	this->setStatus("Loading binary file");
+	this->verbose("Loading binary file...");
+	BinaryEntries entries = BinaryFormat::load(fn);
+	for (BinaryEntries::const_iterator e = entries.begin(); e != entries.end(); e++) {
+		this->store(e->second, e->first);
+	}
+	this->setStatus("Binary file loaded");
+	this->verbose("loaded\n");
+}
+
+void ParetoCalculator::MinimizeRecordFile(const std::string& spaceName, const std::string& inFile, const std::string& outFile, RecordFormat f) {
+	ConfigurationSpacePtr cs = this->retrieveConfigurationSpace(spaceName);
+	std::ios_base::openmode mode = (f == RecordFormat::Binary) ? std::ios::binary : std::ios_base::openmode();
+
+	std::ifstream ifs;
+	if (inFile != "-") {
+		ifs.open(inFile, std::ios::in | mode);
+		if (!ifs) {
+			throw EParetoCalculatorError("Cannot open record file " + inFile);
+		}
+	}
+	this->setStatus("Minimizing records online");
+	this->verbose("Minimizing records of " + spaceName + " online...");
+	ConfigurationReader reader(inFile == "-" ? std::cin : ifs, cs, f);
+	ConfigurationSetPtr front = ParetoCalculator::minimize_Online(reader, "min(" + inFile + ")");
+	std::ostringstream myString;
+	myString << reader.count << " configurations read, " << (front ? front->confs().size() : 0) << " on the Pareto front\n";
+	this->verbose(myString.str());
+
+	std::ofstream ofs;
+	if (outFile != "-") {
+		ofs.open(outFile, std::ios::out | mode);
+		if (!ofs) {
+			throw EParetoCalculatorError("Cannot open record file " + outFile);
+		}
+	}
+	ConfigurationWriter writer(outFile == "-" ? std::cout : ofs, f);
+	if (front) {
+		for (const ConfigurationPtr& c : front->confs()) {
+			writer.write(*c);
+		}
+	}
+	this->setStatus("Pareto front written");
+}
+
 long int testComplexity(long int N, long int d) {
 	if (N <= 1) return 1;
 	if (d == 1) return N;
@@ -39,15 +39,15 @@
 #include <functional>
 #include <string>
 #include "operations.h"
-
-
-#define DEFAULT_MINIMIZE_THRESHOLD 2048
-#define DEFAULT_FILTER_THRESHOLD 2048
+#include "minimizeoptions.h"
+#include "profiling.h"
+#include "records.h"
 
 
 namespace Pareto {
 
 	class ParetoParser;
+	class ParetoDSLParser;
 
 	/// An abstract superclass from which to derive objects to monitor
 	/// information from the calculator about its activities.
@@ -114,6 +114,39 @@ namespace Pareto {
 		/// erase all memory
 		void eraseMemory(void);
 
+		/// The storage mode of the configuration sets that are stored in memory or pushed on the stack.
+		/// In columnar mode the operations work directly on the columns of the sets.
+		StorageMode storageMode = StorageMode::Nodes;
+
+		/// Select the storage mode for configuration sets
+		void setStorageMode(StorageMode m);
+
+		/// Fuse chains of a product or join followed by constraints, abstractions, hiding and a minimization
+		/// into streaming pipelines (see ProductPipeline) when loading operations from a file.
+		bool streamingPipelines = false;
+
+		/// Compile the operations loaded from a file into an optimized plan (see OperationPlan),
+		/// report the plan and execute it, instead of executing the operations one by one.
+		bool optimizePlans = false;
+
+		/// Execute the independent operations of the plan of the operations loaded from a file
+		/// concurrently on the shared task pool. Implies optimizePlans.
+		bool concurrentOperations = false;
+
+		/// Tunes the thresholds of the minimizations of the stack operations, if not nullptr
+		std::shared_ptr<ThresholdTuner> tuner;
+
+		/// Enable autotuning of the minimization thresholds with the tuning profile in file 'profile'.
+		/// The profile is loaded if the file exists and updated when new thresholds are tuned.
+		/// With an empty file name the profile is kept in memory only.
+		void enableAutotuning(const std::string& profile);
+
+		/// the threshold tuner of the calculator, created when it does not exist
+		ThresholdTuner& thresholdTuner(void);
+
+		/// Traces the recursion of the minimizations of the stack operations, if not nullptr
+		std::shared_ptr<MinimizeTrace> trace;
+
 
 		/// push an object 'o' onto the calculator stack
 		void push(const StorableObjectPtr o);
@@ -169,6 +202,17 @@ namespace Pareto {
 		// called by the calculator to log its activities
 		void verbose(const std::string& addText);
 
+		/// reference to a ProfilingCallback object that receives the profiles of the operations
+		/// and the algebra functions they call, or nullptr. Use setProfilingCallbackObject to
+		/// register the object.
+		ProfilingCallback* profilingObject = nullptr;
+
+		/// Register a ProfilingCallback object.
+		void setProfilingCallbackObject(ProfilingCallback* o);
+
+		/// execute operation 'op' on the calculator and profile it if a ProfilingCallback is registered
+		void execute(ParetoCalculatorOperation& op);
+
 		//
 		// static functions which can be used without an instance of the calculator
 		//
@@ -179,6 +223,9 @@ namespace Pareto {
 		// compute the product of the two configuration sets in an already defined predefined configuration space
 		static ConfigurationSetPtr productInSpace(ConfigurationSetPtr cs1, ConfigurationSetPtr cs2, ConfigurationSpacePtr cspace);
 
+		// the configuration space of the abstraction of the n-th dimension from space cs
+		static ConfigurationSpacePtr abstractionSpace(ConfigurationSpacePtr cs, unsigned int n);
+
 		// abstract the n-th dimension from the configuration set
 		static ConfigurationSetPtr abstraction(ConfigurationSetPtr cs, unsigned int n);
 
@@ -201,13 +248,24 @@ namespace Pareto {
 		static ConfigurationSetPtr alternative(ConfigurationSetPtr cs1, ConfigurationSetPtr cs2);
 		static ConfigurationSetPtr minimize(ConfigurationSetPtr cs);
 		static ConfigurationSetPtr minimize_SC(ConfigurationSetPtr cs);
+		static ConfigurationSetPtr minimize_SFS(ConfigurationSetPtr cs);
+
+		/// minimize the configurations read one at a time from 'r' into a set with name 'name'.
+		/// Only the current Pareto front is kept in memory, indexed by a ParetoArchive.
+		static ConfigurationSetPtr minimize_Online(ConfigurationReader& r, const std::string& name);
 		static ConfigurationSetPtr efficient_minimize(ConfigurationSetPtr cs, unsigned int filter_threshold=DEFAULT_FILTER_THRESHOLD, 
 			unsigned int minimize_threshold=DEFAULT_MINIMIZE_THRESHOLD);
+		/// minimize 'cs' by divide and conquer with 'options'. The result of a columnar set is columnar.
+		static ConfigurationSetPtr efficient_minimize(ConfigurationSetPtr cs, const MinimizeOptions& options);
 
 		/// execute block-based minimization
 		void minimize(void);
+		/// execute sort-filter-skyline minimization
+		void minimize_SFS(void);
 		/// execute generalized multi-dimensional Divide-and-Conquer minimization
-		void efficient_minimize();
+		void efficient_minimize(void);
+		/// execute generalized multi-dimensional Divide-and-Conquer minimization with 'options'
+		void efficient_minimize(const MinimizeOptions& options);
 		/// compute product
 		void product(void);
 		/// compute abstraction
@@ -227,7 +285,12 @@ namespace Pareto {
 		/// call this function before using the parser function below.
 		void initParser();
 
-		/// load an XML file 'fn' into memory
+		/// parser of .pareto specifications
+		std::shared_ptr<ParetoDSLParser> dslParser;
+
+		/// load an XML file or a .pareto specification 'fn' into memory. A .pareto specification
+		/// is parsed in a single pass, which stores its quantity types, configuration spaces and
+		/// configuration sets right away; the functions below then only execute its operations.
 		void LoadFile(const std::string& fn);
 
 		/// load the quantity types specified in the loaded XML file into memory
@@ -242,29 +305,47 @@ namespace Pareto {
 		/// load and execute operations
 		void LoadOperations();
 
+		/// execute the operations 'ops' as set up by 'streamingPipelines', 'optimizePlans'
+		/// and 'concurrentOperations'
+		void executeOperations(const ListOfOperations& ops);
+
+		/// save the memory of the calculator to file 'fn'. Files with extension .xml are written
+		/// by the XML parser, other files in the binary format (see BinaryFormat).
 		void SaveAllFile(const std::string& fn);
+
+		/// save the object 'itemToSave' from memory to file 'fn', in the format of SaveAllFile.
+		/// A binary file includes the quantity types and spaces the object depends on.
 		void SaveItemFile(const std::string& itemToSave, const std::string& fn);
 
+		/// load the objects of the binary file 'fn' into memory
+		void LoadBinaryFile(const std::string& fn);
+
+		/// minimize the configurations of the configuration space 'spaceName' in the record file
+		/// 'inFile' online and write the Pareto front to the record file 'outFile', both in
+		/// format 'f'. The file name "-" stands for the standard input or output.
+		void MinimizeRecordFile(const std::string& spaceName, const std::string& inFile, const std::string& outFile, RecordFormat f);
+
 	private:
-		static ConfigurationSetPtr efficient_minimize_unordered(ConfigurationSetPtr cs, const QuantityName& qn);
+		static ConfigurationSetPtr efficient_minimize_unordered(ConfigurationSetPtr cs, const QuantityName& qn, const MinimizeOptions& o);
 		static ListOfConfSetPtr splitClasses(ConfigurationSetPtr cs, const QuantityName& qn);
-		static ConfigurationSetPtr efficient_minimize_totally_ordered(ConfigurationSetPtr cs, const QuantityName& qn);
-		static ConfigurationSetPtr efficient_minimize_totally_ordered_recursive(ConfigurationSetPtr cs, const QuantityName& qn);
-		static ListOfConfSetPtr splitLowHigh(ConfigurationSetPtr cs, const QuantityName& qn, QuantityValuePtr *v);
-		static ConfigurationSetPtr efficient_minimize_dcmerge(ConfigurationSetPtr csl, ConfigurationSetPtr csh, const QuantityName& qn, const QuantityValue& v);
-		static ConfigurationSetPtr efficient_minimize_filter1(ConfigurationSetPtr csl, ConfigurationSetPtr csh, const QuantityName& qn);
-		static ConfigurationSetPtr efficient_minimize_filter2(ConfigurationSetPtr csa, ConfigurationSetPtr csb);
-		static ConfigurationSetPtr efficient_minimize_filter3(ConfigurationSetPtr csa, ConfigurationSetPtr csb);
-		static ConfigurationSetPtr efficient_minimize_filter4(ConfigurationSetPtr csa, ConfigurationSetPtr csb);
-		static QuantityValuePtr efficient_minimize_getPivot(ConfigurationSetPtr cs, const QuantityName& qn);
-		static void efficient_minimize_filter_split(ConfigurationSetPtr cs, const QuantityName& qn, QuantityValuePtr pivot, ConfigurationSetPtr *csl, ConfigurationSetPtr *csh);
-		static ConfigurationSetPtr efficient_minimize_recursive(ConfigurationSetPtr cs);
+		static ConfigurationSetPtr efficient_minimize_totally_ordered(ConfigurationSetPtr cs, const QuantityName& qn, const MinimizeOptions& o);
+		static ConfigurationSetPtr efficient_minimize_totally_ordered(const SortedConfigurationRange& r, const QuantityName& qn, const MinimizeOptions& o);
+		static ConfigurationSetPtr efficient_minimize_totally_ordered_recursive(const SortedConfigurationRange& r, const QuantityName& qn, const MinimizeOptions& o);
+		static ConfigurationSetPtr efficient_minimize_dcmerge(ConfigurationSetPtr csl, ConfigurationSetPtr csh, const QuantityName& qn, const QuantityValue& v, const MinimizeOptions& o);
+		static ConfigurationSetPtr efficient_minimize_filter1(ConfigurationSetPtr csl, ConfigurationSetPtr csh, const QuantityName& qn, const MinimizeOptions& o);
+		static ConfigurationSetPtr efficient_minimize_filter2(ConfigurationSetPtr csa, ConfigurationSetPtr csb, const MinimizeOptions& o);
+		static ConfigurationSetPtr efficient_minimize_filter2(const SortedConfigurationRange& ra, const SortedConfigurationRange& rb, const QuantityName& qn, const MinimizeOptions& o);
+		static ConfigurationSetPtr efficient_minimize_filter3(ConfigurationSetPtr csa, ConfigurationSetPtr csb, const MinimizeOptions& o);
+		static ConfigurationSetPtr efficient_minimize_filter4(ConfigurationSetPtr csa, ConfigurationSetPtr csb, const MinimizeOptions& o);
+		static ConfigurationSetPtr efficient_minimize_filter_sweep(ConfigurationSetPtr csa, ConfigurationSetPtr csb, const MinimizeOptions& o);
+		static ConfigurationSetPtr efficient_minimize_sweep(ConfigurationSetPtr cs, const MinimizeOptions& o);
+		static ConfigurationSetPtr efficient_minimize_recursive(ConfigurationSetPtr cs, const MinimizeOptions& o);
+		static ConfigurationSetPtr efficient_minimize_base(ConfigurationSetPtr cs, const MinimizeOptions& o);
 		static ConfigurationSetPtr hiding(const ConfigurationSetPtr cs, const QuantityName& qn, ConfigurationSpacePtr targetSpace);
 		static ConfigurationSetPtr hiding(ConfigurationSetPtr cs, const ListOfQuantityNames& lqn, ConfigurationSpacePtr targetSpace);
 
-	private:
-		static unsigned int _filter_threshold;
-		static unsigned int _minimize_threshold;
+		/// convert a configuration set to the storage mode of the calculator
+		StorableObjectPtr inStorageMode(const StorableObjectPtr o) const;
 
 	};
 
@@ -0,0 +1,319 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Implements columnar storage of configuration sets and the Pareto Algebra
+// operations on columns
+//
+
+
+#include <algorithm>
+#include <numeric>
+#include "columns.h"
+#include "profiling.h"
+
+
+namespace Pareto {
+
+	ColumnKind columnKindOf(const QuantityType& t) {
+		if (t.isUnordered()) return ColumnKind::Unordered;
+		if (t.isQuantityTypeEnum()) return ColumnKind::Enum;
+		if (dynamic_cast<const QuantityType_Integer*>(&t) != nullptr) return ColumnKind::Integer;
+		if (dynamic_cast<const QuantityType_Real*>(&t) != nullptr) return ColumnKind::Real;
+		throw EParetoCalculatorError("Quantity type " + t.name + " cannot be stored in a column");
+	}
+
+	/////////////// QuantityColumn ///////////////////
+
+	QuantityColumn::QuantityColumn(QuantityTypePtr t) :
+		qtype(t),
+		kind(columnKindOf(*t))
+	{
+	}
+
+	void QuantityColumn::append(const QuantityValue& v) {
+		switch (kind) {
+		case ColumnKind::Real:
+			reals.push_back(((const QuantityValue_Real&)v).value);
+			break;
+		case ColumnKind::Integer:
+			codes.push_back(((const QuantityValue_Integer&)v).value);
+			break;
+		default:
+			codes.push_back((int32_t)((const QuantityValue_Enum&)v).index());
+		}
+	}
+
+	void QuantityColumn::appendFrom(const QuantityColumn& c, size_t r) {
+		if (kind == ColumnKind::Real) reals.push_back(c.reals[r]);
+		else codes.push_back(c.codes[r]);
+	}
+
+	QuantityValuePtr QuantityColumn::valueAt(size_t r, const ConfigurationArenaPtr& arena) const {
+		switch (kind) {
+		case ColumnKind::Real:
+			return allocateInArena<QuantityValue_Real>(arena, *qtype, reals[r]);
+		case ColumnKind::Integer:
+			return allocateInArena<QuantityValue_Integer>(arena, *qtype, codes[r]);
+		default:
+			// use the canonical value object of the enumerated type
+			return ((const QuantityType_Enum&)(*qtype)).quantities[codes[r]];
+		}
+	}
+
+	void QuantityColumn::reserve(size_t n) {
+		if (kind == ColumnKind::Real) reals.reserve(n);
+		else codes.reserve(n);
+	}
+
+
+	/////////////// ConfigurationColumns ///////////////////
+
+	ConfigurationColumns::ConfigurationColumns(ConfigurationSpacePtr cs) :
+		confspace(cs)
+	{
+		for (unsigned int i = 0; i < cs->quantities.size(); i++) {
+			columns.push_back(QuantityColumn(cs->quantities[i]));
+			if (cs->quantityVisibility[i]) visible.push_back(i);
+		}
+	}
+
+	ConfigurationColumns::ConfigurationColumns(const ConfigurationSet& cs) :
+		ConfigurationColumns(cs.confspace)
+	{
+		this->reserve(cs.confs().size());
+		SetOfConfigurations::const_iterator i;
+		for (i = cs.confs().begin(); i != cs.confs().end(); i++) {
+			this->appendConfiguration(**i);
+		}
+		// the order of enumerated values in the set is by name, in the columns by index
+		this->normalize();
+	}
+
+	void ConfigurationColumns::reserve(size_t n) {
+		for (QuantityColumn& c : columns) c.reserve(n);
+	}
+
+	void ConfigurationColumns::resize(size_t n) {
+		for (QuantityColumn& c : columns) {
+			if (c.kind == ColumnKind::Real) c.reals.resize(n);
+			else c.codes.resize(n);
+		}
+		nrOfRows = n;
+	}
+
+	void ConfigurationColumns::appendConfiguration(const Configuration& c) {
+		for (unsigned int i = 0; i < columns.size(); i++) {
+			columns[i].append(*c.quantities[i]);
+		}
+		nrOfRows++;
+	}
+
+	void ConfigurationColumns::appendRow(const ConfigurationColumns& cc, size_t r) {
+		for (unsigned int i = 0; i < columns.size(); i++) {
+			columns[i].appendFrom(cc.columns[i], r);
+		}
+		nrOfRows++;
+	}
+
+	void ConfigurationColumns::appendProductRow(const ConfigurationColumns& a, size_t r, const ConfigurationColumns& b, size_t s) {
+		size_t na = a.columns.size();
+		for (unsigned int i = 0; i < na; i++) {
+			columns[i].appendFrom(a.columns[i], r);
+		}
+		for (unsigned int i = 0; i < b.columns.size(); i++) {
+			columns[na + i].appendFrom(b.columns[i], s);
+		}
+		nrOfRows++;
+	}
+
+	ConfigurationPtr ConfigurationColumns::configurationAt(size_t r, const ConfigurationArenaPtr& arena) const {
+		ConfigurationPtr c = allocateInArena<Configuration>(arena, confspace, arena);
+		for (const QuantityColumn& col : columns) {
+			c->addQuantity(col.valueAt(r, arena));
+		}
+		return c;
+	}
+
+	bool ConfigurationColumns::dominates(size_t r, const ConfigurationColumns& cc, size_t s) const {
+		ProfileCounters::dominanceTests++;
+		for (unsigned int q : visible) {
+			if (!columns[q].dominates(r, cc.columns[q], s)) return false;
+		}
+		return true;
+	}
+
+	bool ConfigurationColumns::rowEqual(size_t r, const ConfigurationColumns& cc, size_t s) const {
+		for (unsigned int q = 0; q < columns.size(); q++) {
+			if (!columns[q].equal(r, cc.columns[q], s)) return false;
+		}
+		return true;
+	}
+
+	bool ConfigurationColumns::rowSmaller(size_t r, const ConfigurationColumns& cc, size_t s) const {
+		for (unsigned int q = 0; q < columns.size(); q++) {
+			if (columns[q].smaller(r, cc.columns[q], s)) return true;
+			if (cc.columns[q].smaller(s, columns[q], r)) return false;
+		}
+		return false;
+	}
+
+	void ConfigurationColumns::normalize(void) {
+		std::vector<size_t> rows(nrOfRows);
+		std::iota(rows.begin(), rows.end(), 0);
+		std::sort(rows.begin(), rows.end(), [this](size_t r, size_t s) { return this->rowSmaller(r, *this, s); });
+		rows.erase(std::unique(rows.begin(), rows.end(), [this](size_t r, size_t s) { return this->rowEqual(r, *this, s); }), rows.end());
+		ConfigurationColumnsPtr sorted = this->select(rows);
+		this->columns.swap(sorted->columns);
+		this->nrOfRows = sorted->nrOfRows;
+	}
+
+	ConfigurationColumnsPtr ConfigurationColumns::select(const std::vector<size_t>& rows) const {
+		ConfigurationColumnsPtr res = std::make_shared<ConfigurationColumns>(confspace);
+		for (unsigned int q = 0; q < columns.size(); q++) {
+			const QuantityColumn& from = columns[q];
+			QuantityColumn& to = res->columns[q];
+			if (from.kind == ColumnKind::Real) {
+				to.reals.resize(rows.size());
+				for (size_t k = 0; k < rows.size(); k++) to.reals[k] = from.reals[rows[k]];
+			}
+			else {
+				to.codes.resize(rows.size());
+				for (size_t k = 0; k < rows.size(); k++) to.codes[k] = from.codes[rows[k]];
+			}
+		}
+		res->nrOfRows = rows.size();
+		return res;
+	}
+
+
+	/// Minimization by Sort-Filter-Skyline. When the rows are visited in lexicographic order
+	/// of their visible values, a row can only be dominated by rows visited before it, so
+	/// every row needs to be compared against the minimal rows found so far only.
+	ConfigurationColumnsPtr ConfigurationColumns::minimize(const ConfigurationColumns& cc) {
+		std::vector<size_t> order(cc.nrOfRows);
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&cc](size_t r, size_t s) {
+			for (unsigned int q : cc.visible) {
+				if (cc.columns[q].smaller(r, cc.columns[q], s)) return true;
+				if (cc.columns[q].smaller(s, cc.columns[q], r)) return false;
+			}
+			// ties are broken by row number, i.e., by the order of the set
+			return r < s;
+		});
+
+		std::vector<size_t> kept;
+		for (size_t r : order) {
+			bool dominated = false;
+			for (size_t k : kept) {
+				if (cc.dominates(k, cc, r)) {
+					dominated = true;
+					break;
+				}
+			}
+			if (!dominated) kept.push_back(r);
+		}
+
+		// restore the order of the set
+		std::sort(kept.begin(), kept.end());
+		return cc.select(kept);
+	}
+
+	ConfigurationColumnsPtr ConfigurationColumns::product(const ConfigurationColumns& a, const ConfigurationColumns& b, ConfigurationSpacePtr cspace) {
+		ConfigurationColumnsPtr res = std::make_shared<ConfigurationColumns>(cspace);
+		if (res->columns.size() != a.columns.size() + b.columns.size()) {
+			throw EParetoCalculatorError("Product space does not match the operands in ConfigurationColumns::product");
+		}
+		res->reserve(a.nrOfRows * b.nrOfRows);
+		// the product of two sorted sets, in this order, is sorted
+		for (size_t r = 0; r < a.nrOfRows; r++) {
+			for (size_t s = 0; s < b.nrOfRows; s++) {
+				res->appendProductRow(a, r, b, s);
+			}
+		}
+		return res;
+	}
+
+	ConfigurationColumnsPtr ConfigurationColumns::constraint(const ConfigurationColumns& a, const ConfigurationColumns& b) {
+		if (a.columns.size() != b.columns.size()) {
+			throw EParetoCalculatorError("Configuration sets of different spaces in ConfigurationColumns::constraint");
+		}
+		std::vector<size_t> rows;
+		// merge the two sorted sets
+		size_t r = 0, s = 0;
+		while (r < a.nrOfRows && s < b.nrOfRows) {
+			if (a.rowSmaller(r, b, s)) r++;
+			else if (b.rowSmaller(s, a, r)) s++;
+			else {
+				rows.push_back(r);
+				r++; s++;
+			}
+		}
+		return a.select(rows);
+	}
+
+	ConfigurationColumnsPtr ConfigurationColumns::constraint(const ConfigurationColumns& cc, std::function<bool(const ConfigurationColumns&, size_t)> testConstraint) {
+		std::vector<size_t> rows;
+		for (size_t r = 0; r < cc.nrOfRows; r++) {
+			if (testConstraint(cc, r)) rows.push_back(r);
+		}
+		return cc.select(rows);
+	}
+
+	ConfigurationColumnsPtr ConfigurationColumns::abstraction(const ConfigurationColumns& cc, unsigned int n, ConfigurationSpacePtr cspace) {
+		ConfigurationColumnsPtr res = std::make_shared<ConfigurationColumns>(cspace);
+		unsigned int k = 0;
+		for (unsigned int q = 0; q < cc.columns.size(); q++) {
+			if (q != n) {
+				res->columns[k].reals = cc.columns[q].reals;
+				res->columns[k].codes = cc.columns[q].codes;
+				k++;
+			}
+		}
+		res->nrOfRows = cc.nrOfRows;
+		// removing a quantity may break the order and introduce duplicates
+		res->normalize();
+		return res;
+	}
+
+	ConfigurationColumnsPtr ConfigurationColumns::hiding(const ConfigurationColumns& cc, ConfigurationSpacePtr cspace) {
+		ConfigurationColumnsPtr res = std::make_shared<ConfigurationColumns>(cspace);
+		if (res->columns.size() != cc.columns.size()) {
+			throw EParetoCalculatorError("Target space does not match in ConfigurationColumns::hiding");
+		}
+		for (unsigned int q = 0; q < cc.columns.size(); q++) {
+			res->columns[q].reals = cc.columns[q].reals;
+			res->columns[q].codes = cc.columns[q].codes;
+		}
+		// the order includes hidden quantities, so it is not affected
+		res->nrOfRows = cc.nrOfRows;
+		return res;
+	}
+
+}
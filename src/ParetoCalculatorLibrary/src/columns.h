@@ -0,0 +1,200 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Columnar (structure-of-arrays) storage of the configurations of a configuration
+// set, and the Pareto Algebra operations that work directly on the columns.
+//
+
+#ifndef PARETO_COLUMNS_H
+#define PARETO_COLUMNS_H
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstdint>
+#include "configuration.h"
+
+
+namespace Pareto {
+
+	/// The kind of values stored in a column
+	enum class ColumnKind { Real, Integer, Enum, Unordered };
+
+	/// determine the kind of column to use for values of quantity type 't'
+	ColumnKind columnKindOf(const QuantityType& t);
+
+	/// A column holding the values of one quantity for all configurations of a set.
+	///
+	/// Real values are stored as doubles, integer values as 32-bit integers and the
+	/// values of (ordered or unordered) enumerated types as their index in the list
+	/// of values of their type.
+	class QuantityColumn {
+	public:
+		/// Constructor of an empty column for quantity type 't'
+		QuantityColumn(QuantityTypePtr t);
+
+		/// the quantity type of the values in the column
+		QuantityTypePtr qtype;
+
+		/// the kind of values stored in the column
+		ColumnKind kind;
+
+		/// the values of a column of kind Real
+		std::vector<double> reals;
+
+		/// the values of a column of kind Integer, Enum or Unordered
+		std::vector<int32_t> codes;
+
+		/// number of values in the column
+		size_t size(void) const { return kind == ColumnKind::Real ? reals.size() : codes.size(); }
+
+		/// append the raw value of quantity value 'v'
+		void append(const QuantityValue& v);
+
+		/// append value number 'r' of column 'c', which must be of the same kind
+		void appendFrom(const QuantityColumn& c, size_t r);
+
+		/// create a quantity value object for value number 'r', in 'arena' if it is not nullptr
+		QuantityValuePtr valueAt(size_t r, const ConfigurationArenaPtr& arena = nullptr) const;
+
+		/// test if value 'r' of this column dominates (<=) value 's' of column 'c'
+		bool dominates(size_t r, const QuantityColumn& c, size_t s) const {
+			switch (kind) {
+			case ColumnKind::Real: return reals[r] <= c.reals[s];
+			case ColumnKind::Unordered: return codes[r] == c.codes[s];
+			default: return codes[r] <= c.codes[s];
+			}
+		}
+
+		/// test if value 'r' of this column is equal to value 's' of column 'c'
+		bool equal(size_t r, const QuantityColumn& c, size_t s) const {
+			if (kind == ColumnKind::Real) return reals[r] == c.reals[s];
+			return codes[r] == c.codes[s];
+		}
+
+		/// an arbitrary total order on the values, consistent with equal
+		bool smaller(size_t r, const QuantityColumn& c, size_t s) const {
+			if (kind == ColumnKind::Real) return reals[r] < c.reals[s];
+			return codes[r] < c.codes[s];
+		}
+
+		/// reserve space for 'n' values
+		void reserve(size_t n);
+	};
+
+	/// Stores a set of configurations as one contiguous column per quantity of the
+	/// configuration space.
+	///
+	/// Rows are kept in an order consistent with 'rowSmaller' and free of duplicates,
+	/// so that the columns represent a set in the same way as SetOfConfigurations.
+	/// Operations that may violate this invariant call normalize().
+	class ConfigurationColumns {
+	public:
+		/// Constructor of empty columns for configuration space 'cs'
+		ConfigurationColumns(ConfigurationSpacePtr cs);
+
+		/// Constructor packing the configurations of the node based set 'cs'
+		ConfigurationColumns(const ConfigurationSet& cs);
+
+		/// the configuration space of the configurations
+		ConfigurationSpacePtr confspace;
+
+		/// the columns, one for each quantity of the configuration space
+		std::vector<QuantityColumn> columns;
+
+		/// the number of configurations (rows)
+		size_t size(void) const { return nrOfRows; }
+
+		/// reserve space for 'n' rows
+		void reserve(size_t n);
+
+		/// set the number of rows to 'n', to fill the columns directly.
+		/// Call normalize() afterwards if the rows may not be in order.
+		void resize(size_t n);
+
+		/// append configuration 'c' as a new row.
+		void appendConfiguration(const Configuration& c);
+
+		/// append row 'r' of columns 'cc' which have the same shape
+		void appendRow(const ConfigurationColumns& cc, size_t r);
+
+		/// append the product of row 'r' of 'a' and row 's' of 'b'
+		void appendProductRow(const ConfigurationColumns& a, size_t r, const ConfigurationColumns& b, size_t s);
+
+		/// create a configuration object for row 'r', in 'arena' if it is not nullptr
+		ConfigurationPtr configurationAt(size_t r, const ConfigurationArenaPtr& arena = nullptr) const;
+
+		/// test whether row 'r' dominates row 's' of 'cc' in the visible quantities
+		bool dominates(size_t r, const ConfigurationColumns& cc, size_t s) const;
+
+		/// test whether row 'r' is equal to row 's' of 'cc' in all quantities
+		bool rowEqual(size_t r, const ConfigurationColumns& cc, size_t s) const;
+
+		/// lexicographic total order on the rows, including hidden quantities
+		bool rowSmaller(size_t r, const ConfigurationColumns& cc, size_t s) const;
+
+		/// sort the rows and remove duplicates
+		void normalize(void);
+
+		/// create new columns with the rows selected by 'rows', in that order
+		ConfigurationColumnsPtr select(const std::vector<size_t>& rows) const;
+
+		//
+		// Pareto Algebra operations on columns
+		//
+
+		/// compute the minimal configurations
+		static ConfigurationColumnsPtr minimize(const ConfigurationColumns& cc);
+
+		/// compute the product in the product space 'cspace'
+		static ConfigurationColumnsPtr product(const ConfigurationColumns& a, const ConfigurationColumns& b, ConfigurationSpacePtr cspace);
+
+		/// compute the intersection of two sets of configurations in the same space
+		static ConfigurationColumnsPtr constraint(const ConfigurationColumns& a, const ConfigurationColumns& b);
+
+		/// keep the rows that satisfy the characteristic function 'testConstraint'
+		static ConfigurationColumnsPtr constraint(const ConfigurationColumns& cc, std::function<bool(const ConfigurationColumns&, size_t)> testConstraint);
+
+		/// remove quantity number 'n' in the new configuration space 'cspace'
+		static ConfigurationColumnsPtr abstraction(const ConfigurationColumns& cc, unsigned int n, ConfigurationSpacePtr cspace);
+
+		/// copy the rows into the configuration space 'cspace' which differs only in visibility
+		static ConfigurationColumnsPtr hiding(const ConfigurationColumns& cc, ConfigurationSpacePtr cspace);
+
+	private:
+		size_t nrOfRows = 0;
+
+		/// indices of the visible quantities of the configuration space
+		std::vector<unsigned int> visible;
+	};
+
+}
+
+#endif
@@ -34,6 +34,8 @@
 //
 
 #include "configuration.h"
+#include "columns.h"
+#include "dominance.h"
 #include "exceptions.h"
 #include <sstream> 
 #include <algorithm>
@@ -61,6 +63,8 @@ namespace Pareto {
 		quantities.push_back(q);
 		quantityNames[qname] = (unsigned int) (quantities.size() - 1);
 		this->quantityVisibility.push_back(vis);
+		// the shape of the space has changed
+		std::atomic_store(&this->kernel, std::shared_ptr<const DominanceKernel>());
 	}
 
 	void ConfigurationSpace::addQuantitiesOf(const ConfigurationSpace& cs) {
@@ -116,7 +120,7 @@ namespace Pareto {
 		unsigned int k;
 		for (k = 0, i = this->quantityNames.begin(); i != this->quantityNames.end(); i++, k++) {
 			QuantityTypePtr t = this->quantities[(*i).second];
-			if ((this->quantityVisibility[k]) && (t->isUnordered())) {
+			if ((this->quantityVisibility[(*i).second]) && (t->isUnordered())) {
 				QuantityNamePtr qn = std::make_shared<QuantityName>((*i).first);
 				return qn;
 			}
@@ -131,7 +135,7 @@ namespace Pareto {
 		unsigned int k;
 		for (k = 0, i = this->quantityNames.begin(); i != this->quantityNames.end(); i++, k++) {
 			QuantityTypePtr t = this->quantities[(*i).second];
-			if ((this->quantityVisibility[k]) && (t->isTotallyOrdered())) {
+			if ((this->quantityVisibility[(*i).second]) && (t->isTotallyOrdered())) {
 				QuantityNamePtr qn = std::make_shared<QuantityName>((*i).first);
 				return qn;
 			}
@@ -163,16 +167,20 @@ namespace Pareto {
 	/// compare two configurations according to Pareto dominance in this configuration space
 	/// Note that invisible quantities are not compared
 	bool ConfigurationSpace::compare(const Configuration& c1, const Configuration& c2) const {
-		unsigned int i = 0;
+		return this->dominanceKernel().dominates(c1, c2);
+	}
 
-		for (ListOfQuantityTypes::const_iterator j = this->quantities.begin(); j != this->quantities.end(); i++, j++) 
-		{
-			if (this->quantityVisibility[i] && !((*c1.getQuantity(i)) <= (*c2.getQuantity(i)))) 
-			{ 
-				return false;
+	/// return the dominance kernel of the space, create it if necessary
+	const DominanceKernel& ConfigurationSpace::dominanceKernel(void) const {
+		std::shared_ptr<const DominanceKernel> k = std::atomic_load(&this->kernel);
+		if (!k) {
+			// if another thread installs a kernel first, k is replaced by that kernel
+			std::shared_ptr<const DominanceKernel> nk = std::make_shared<const DominanceKernel>(*this);
+			if (std::atomic_compare_exchange_strong(&this->kernel, &k, nk)) {
+				k = nk;
 			}
 		}
-		return true;
+		return *k;
 	}
 
 	/// compare two configurations for equality in this configuration space
@@ -298,7 +306,7 @@ namespace Pareto {
 	/// create a new configuration in this configuration space with default values for the quantities
 	ConfigurationPtr ConfigurationSpace::newConfiguration(void) {
 
-		ConfigurationPtr c = std::make_shared<Configuration>(this->shared_from_this());
+		ConfigurationPtr c = allocateInArena<Configuration>(nullptr, this->shared_from_this());
 
 		// add default values
 		ListOfQuantityTypes::iterator i;
@@ -318,14 +326,20 @@ namespace Pareto {
 	/////////////////// Configuration //////////////////////
 
 	/// constructor Configuration
-	Configuration::Configuration(ConfigurationSpacePtr cs) :confspace(cs) {
+	Configuration::Configuration(ConfigurationSpacePtr cs, const ConfigurationArenaPtr& arena) :
+		confspace(cs),
+		quantities(ArenaAllocator<QuantityValuePtr>(arena))
+	{
+		quantities.reserve(cs->quantities.size());
 	}
 
 	/// 'copy constructor' from pointer
-	Configuration::Configuration(ConfigurationPtr c) :
-		confspace(c->confspace)
+	Configuration::Configuration(ConfigurationPtr c, const ConfigurationArenaPtr& arena) :
+		confspace(c->confspace),
+		quantities(ArenaAllocator<QuantityValuePtr>(arena))
 	{
 		// copy quantity values
+		quantities.reserve(c->quantities.size());
 		ListOfQuantityValues::iterator i;
 		for (i = c->quantities.begin(); i != c->quantities.end(); i++) {
 			this->quantities.push_back(*i);
@@ -425,20 +439,42 @@ namespace Pareto {
 
 
 	/// copy constructor for ConfigurationSet 
+	/// The copy is in node storage mode, so that its configurations can be modified.
 	ConfigurationSet::ConfigurationSet(ConfigurationSetPtr cs) :
 		StorableObject(cs->name),
 		confspace(cs->confspace)
 	{
+		cs->materialize();
 		SetOfConfigurations::const_iterator i;
-		for (i = cs->confs.begin(); i != cs->confs.end(); i++)
+		for (i = cs->confs().begin(); i != cs->confs().end(); i++)
 		{
-			ConfigurationPtr c = std::make_shared<Configuration>(*i);
-			this->confs.insert(c);
+			ConfigurationPtr c = allocateInArena<Configuration>(this->arena, *i, this->arena);
+			this->configurations.insert(c);
 		}
 
 	}
 
 
+	/// constructor of a ConfigurationSet in columnar storage mode
+	ConfigurationSet::ConfigurationSet(ConfigurationColumnsPtr cc, const std::string n) :
+		StorableObject(n),
+		columns(cc),
+		confspace(cc->confspace)
+	{
+	}
+
+	/// create a new empty configuration in the arena of the set
+	ConfigurationPtr ConfigurationSet::createConfiguration(void) const {
+		return allocateInArena<Configuration>(this->arena, this->confspace, this->arena);
+	}
+
+	/// create a new configuration in space cs and in the arena of the set, with the values of c
+	ConfigurationPtr ConfigurationSet::createConfiguration(ConfigurationSpacePtr cs, const ConfigurationPtr& c) const {
+		ConfigurationPtr nc = allocateInArena<Configuration>(this->arena, cs, this->arena);
+		nc->addQuantitiesOf(c);
+		return nc;
+	}
+
 	/// add configuration c to the configuration set
 	void ConfigurationSet::addConfiguration(ConfigurationPtr c) {
 #ifdef _DEBUG
@@ -446,7 +482,8 @@ namespace Pareto {
 			throw EParetoCalculatorError("Error: configuration is of wrong type in ConfigurationSet::addConfiguration");
 		}
 #endif
-		confs.insert(c);
+		this->toNodes();
+		configurations.insert(c);
 	}
 
 	/// Add a new configuration to the configuration set.
@@ -457,7 +494,8 @@ namespace Pareto {
 			throw EParetoCalculatorError("Error: configuration is of wrong type in ConfigurationSet::addConfiguration");
 		}
 #endif
-		confs.insert(c);
+		this->toNodes();
+		configurations.insert(c);
 	}
 
 	/// insert a new configuration while maintaining Pareto minimality
@@ -467,30 +505,33 @@ namespace Pareto {
 	void ConfigurationSet::addConfigurationAndFilter(ConfigurationPtr c) {
 		// assumes the configurations set is minimal
 		// post: set is minimal version of set plus new configuration
-		SetOfConfigurations::iterator i = this->confs.begin();
-		while (i != this->confs.end()) {
-			ConfigurationPtr a = *i;
-			if (*a <= *c) {
+		this->toNodes();
+		const DominanceKernel& dk = this->confspace->dominanceKernel();
+		SetOfConfigurations::iterator i = this->configurations.begin();
+		while (i != this->configurations.end()) {
+			const ConfigurationPtr& a = *i;
+			if (dk.dominates(*a, *c)) {
 				// c is dominated by a conf in this -> don't use c
 				return;
 			}
-			else if (*c <= *a) {
+			else if (dk.dominates(*c, *a)) {
 				// remove a
 				SetOfConfigurations::iterator it = i;
 				i++;
-				this->confs.erase(it);
+				this->configurations.erase(it);
 			}
 			else
 				i++;
 		}
 		// c is not dominated by any conf in this -> add c to this
-		this->confs.insert(c);
+		this->configurations.insert(c);
 	}
 
 	/// add all configurations from configuration set cs as unique (non-existing configurations
 	/// Note: assumes that the new configurations do not yet exist in the set
 	void ConfigurationSet::addUniqueConfigurationsOf(ConfigurationSetPtr cs) {
-		for (SetOfConfigurations::iterator i = cs->confs.begin(); i != cs->confs.end(); i++) {
+		cs->materialize();
+		for (SetOfConfigurations::iterator i = cs->confs().begin(); i != cs->confs().end(); i++) {
 			ConfigurationPtr c = (*i);
 			this->addUniqueConfiguration(c);
 		}
@@ -498,26 +539,73 @@ namespace Pareto {
 
 	/// check if the set contains configuration c
 	bool ConfigurationSet::containsConfiguration(ConfigurationPtr c) {
-		return confs.find(c) != confs.end();
+		this->materialize();
+		return configurations.find(c) != configurations.end();
+	}
+
+	/// return the number of configurations in the set
+	size_t ConfigurationSet::size(void) const {
+		return columns ? columns->size() : configurations.size();
+	}
+
+	/// fill the view with configuration objects for the rows of a columnar set
+	void ConfigurationSet::materialize(void) const {
+		if (!columns || materialized) return;
+		configurations.clear();
+		for (size_t r = 0; r < columns->size(); r++) {
+			configurations.insert(configurations.end(), columns->configurationAt(r, this->arena));
+		}
+		materialized = true;
+	}
+
+	/// switch from columnar storage to node storage, keeping the configurations
+	void ConfigurationSet::toNodes(void) {
+		if (!columns) return;
+		this->materialize();
+		columns = nullptr;
+		materialized = false;
+	}
+
+	/// return the configurations of the set as columns
+	ConfigurationColumnsPtr ConfigurationSet::asColumns(void) const {
+		if (columns) return columns;
+		return std::make_shared<ConfigurationColumns>(*this);
+	}
+
+	/// return a copy of the set in columnar storage mode
+	ConfigurationSetPtr ConfigurationSet::toColumnar(void) const {
+		return std::make_shared<ConfigurationSet>(this->asColumns(), this->name);
 	}
 
 	/// produce a textual representation of the configuration set on the stream os
 	void ConfigurationSet::streamOn(std::ostream& os) const {
+		// a columnar set is shown in the same order as the set in node storage
+		SetOfConfigurations view;
+		if (columns && !materialized) {
+			for (size_t r = 0; r < columns->size(); r++) {
+				view.insert(columns->configurationAt(r));
+			}
+		}
+		const SetOfConfigurations& cfs = (columns && !materialized) ? view : configurations;
+
 		os << "{";
-		SetOfConfigurations::iterator i;
+		SetOfConfigurations::const_iterator i;
 		unsigned int n = 0;
-		for (i = confs.begin(); i != confs.end(); i++, n++) {
+		for (i = cfs.begin(); i != cfs.end(); i++, n++) {
 			ConfigurationPtr c = *i;
 			os << c;
-			if (n < confs.size() - 1) os << ", " << std::endl;
+			if (n < cfs.size() - 1) os << ", " << std::endl;
 		}
 		os << "}";
 	}
 
 	bool ConfigurationSet::checkConfSpaceConsistency(void) const
 	{
+		if (columns) {
+			return columns->confspace->isIdenticalTo(this->confspace);
+		}
 		SetOfConfigurations::const_iterator i;
-		for (i = this->confs.begin(); i != this->confs.end(); i++)
+		for (i = this->configurations.begin(); i != this->configurations.end(); i++)
 		{
 			if (!(*i)->confspace->isIdenticalTo(this->confspace)) {
 				return false;
@@ -528,9 +616,10 @@ namespace Pareto {
 
 	void ConfigurationSet::adoptConfigurationSpaceOf(ConfigurationSetPtr cs)
 	{
+		this->toNodes();
 		this->confspace = cs->confspace;
-		SetOfConfigurations::iterator i = this->confs.begin();
-		while (i != this->confs.end())
+		SetOfConfigurations::iterator i = this->configurations.begin();
+		while (i != this->configurations.end())
 		{
 			(*i)->adoptConfigurationSpace(this->confspace);
 			i++;
@@ -576,9 +665,10 @@ namespace Pareto {
 	IndexOnTotalOrderConfigurationSet::IndexOnTotalOrderConfigurationSet(const QuantityName& qn, ConfigurationSetPtr cs) : 
 		IndexOnConfigurationSet(qn, cs) 
 	{
+		cs->materialize();
 		// make a list of references for the index
 		SetOfConfigurations::iterator i;
-		for (i = cs->confs.begin(); i != cs->confs.end(); i++) {
+		for (i = cs->confs().begin(); i != cs->confs().end(); i++) {
 			ConfigurationIndexOnTotalOrderReferencePtr r = std::make_shared<ConfigurationIndexOnTotalOrderReference>(*i, *this);
 			this->push_back(r);
 		}
@@ -590,7 +680,7 @@ namespace Pareto {
 		int a, b, m;
 		// use a binary search
 		a = -1; // S[a,Q]<v
-		b = (int)  this->confset->confs.size(); // S[b,Q]>=v;
+		b = (int)  this->confset->confs().size(); // S[b,Q]>=v;
 		while (b - a > 1) {
 			m = (a + b) / 2;
 			if (*(this->get(m)) < v) {
@@ -608,7 +698,7 @@ namespace Pareto {
 		int a, b, m;
 		// use a binary search
 		a = -1; // S[a,Q]<=v
-		b = (int) this->confset->confs.size(); // S[b,Q]>v;
+		b = (int) this->confset->confs().size(); // S[b,Q]>v;
 		while (b - a > 1) {
 			m = (a + b) / 2;
 			if (*(this->get(m)) > v) {
@@ -658,21 +748,117 @@ namespace Pareto {
 
 	/// a total order to organize the unordered quantities
 	bool ConfigurationIndexOnUnorderedReference::operator<(const ConfigurationIndexReference& right) const {
-		QuantityValuePtr addrA = this->value();
-		QuantityValuePtr addrB = right.value();
-		// compare the pointers instead
-		return addrA < addrB;
-		// TODO: check, it this always safe. maybe replace by efficient direct comparison of strings without making too many copies.
-		// was:	return this->value().asString()<right.value().asString();
+		// compare the values in the total order of their type, which for enumerated types compares indices
+		return this->value()->totalOrderSmaller(*(right.value()));
+	}
+
+	bool operator<(const ConfigurationIndexOnUnorderedReferencePtr pa, const ConfigurationIndexOnUnorderedReferencePtr pb)
+	{
+		return *pa < *pb;
+	}
+
+	/// constructor of SortedConfigurationRange from quantity name and configuration set
+	SortedConfigurationRange::SortedConfigurationRange(const QuantityName& qn, ConfigurationSetPtr cs) :
+		confset(cs),
+		first(0)
+	{
+		cs->materialize();
+		// look up the quantity once, and the values of the configurations while sorting
+		unsigned int n = cs->confspace->indexOfQuantity(qn);
+		std::shared_ptr<std::vector<Entry>> e = std::make_shared<std::vector<Entry>>();
+		e->reserve(cs->confs().size());
+		for (const ConfigurationPtr& c : cs->confs()) {
+			e->push_back(Entry{ c->getQuantity(n).get(), c });
+		}
+		std::sort(e->begin(), e->end(), [](const Entry& a, const Entry& b) { return *a.value < *b.value; });
+		this->last = e->size();
+		this->entries = e;
+	}
+
+	/// the part of the range from position f up to t, sharing the sorted configurations
+	SortedConfigurationRange SortedConfigurationRange::range(size_t f, size_t t) const {
+		SortedConfigurationRange r(*this);
+		r.first = this->first + f;
+		r.last = this->first + t;
+		return r;
+	}
+
+	/// lower returns the smallest position k such that value(k)>=v
+	size_t SortedConfigurationRange::lower(const QuantityValue& v) const {
+		// use a binary search
+		size_t a = 0; // value(k)<v for all k<a
+		size_t b = this->size(); // value(k)>=v for all k>=b
+		while (a < b) {
+			size_t m = (a + b) / 2;
+			if (this->value(m) < v) {
+				a = m + 1;
+			}
+			else {
+				b = m;
+			}
+		}
+		return b;
+	}
+
+	/// upper returns the smallest position k such that value(k)>v
+	size_t SortedConfigurationRange::upper(const QuantityValue& v) const {
+		// use a binary search
+		size_t a = 0; // value(k)<=v for all k<a
+		size_t b = this->size(); // value(k)>v for all k>=b
+		while (a < b) {
+			size_t m = (a + b) / 2;
+			if (this->value(m) <= v) {
+				a = m + 1;
+			}
+			else {
+				b = m;
+			}
+		}
+		return b;
+	}
+
+	/// select the value at position k of the merge of a and b, without merging them
+	const QuantityValue& SortedConfigurationRange::select(const SortedConfigurationRange& a, const SortedConfigurationRange& b, size_t k) {
+		if (k >= a.size() + b.size()) {
+			throw EParetoCalculatorError("Position out of bounds in SortedConfigurationRange::select.");
+		}
+		// binary search for the number i of the first k values of the merge that come from a
+		size_t l = k > b.size() ? k - b.size() : 0;
+		size_t u = std::min(k, a.size());
+		while (l < u) {
+			size_t i = (l + u) / 2;
+			if (a.value(i) < b.value(k - i - 1)) {
+				l = i + 1;
+			}
+			else {
+				u = i;
+			}
+		}
+		// the value at position k is the smallest of the next values of a and b
+		size_t j = k - l;
+		if (l == a.size()) return b.value(j);
+		if (j == b.size()) return a.value(l);
+		return b.value(j) < a.value(l) ? b.value(j) : a.value(l);
+	}
+
+	/// copy the range as a new configuration set
+	ConfigurationSetPtr SortedConfigurationRange::copy() const {
+		// make the resulting configuration set in the same configuration space
+		ConfigurationSetPtr res = std::make_shared<ConfigurationSet>(this->confset->confspace, this->confset->name + " range");
+		for (size_t k = 0; k < this->size(); k++) {
+			res->addConfiguration(this->conf(k));
+		}
+		return res;
 	}
 
 
 	/// constructor of IndexOnUnorderedConfigurationSet, given a name of the quantity and a configuration set to index
 	IndexOnUnorderedConfigurationSet::IndexOnUnorderedConfigurationSet(const QuantityName& qn, ConfigurationSetPtr cs) : IndexOnConfigurationSet(qn, cs) {
+		cs->materialize();
 		// create the references
 		SetOfConfigurations::iterator i;
-		for (i = cs->confs.begin(); i != cs->confs.end(); i++) {
-			std::shared_ptr<ConfigurationIndexOnUnorderedReference> r = std::make_shared<ConfigurationIndexOnUnorderedReference>(*i, *this);
+		for (i = cs->confs().begin(); i != cs->confs().end(); i++) {
+			ConfigurationIndexOnUnorderedReferencePtr r = std::make_shared<ConfigurationIndexOnUnorderedReference>(*i, *this);
 			this->push_back(r);
 		}
 		// sort the index
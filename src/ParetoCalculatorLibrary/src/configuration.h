@@ -45,6 +45,7 @@
 #include <map>
 #include <memory>
 #include <iostream>
+#include "arena.h"
 #include "exceptions.h"
 #include "quantity.h"
 #include "storage.h"
@@ -94,10 +95,14 @@ namespace Pareto {
 	class ConfigurationSpace;
 	class ConfigurationSet;
 
+	class ConfigurationColumns;
+	class DominanceKernel;
+
 	/// Pointer definitions
 	using ConfigurationSpacePtr = std::shared_ptr<ConfigurationSpace>;
 	using ConfigurationPtr = std::shared_ptr<Configuration>;
 	using ConfigurationSetPtr = std::shared_ptr<ConfigurationSet>;
+	using ConfigurationColumnsPtr = std::shared_ptr<ConfigurationColumns>;
 
 	class ConfigurationSpace: public StorableObject, public std::enable_shared_from_this<ConfigurationSpace> {
 	public:
@@ -111,6 +116,10 @@ namespace Pareto {
 		/// compare tests the dominance relation between configurations
 		bool compare(const Configuration& c1, const Configuration& c2) const;
 
+		/// returns the dominance kernel specialized for the quantities of the space.
+		/// Prefer it over compare in loops over many configurations.
+		const DominanceKernel& dominanceKernel(void) const;
+
 		/// equal tests whether the configurations are the same
 		bool equal(const Configuration& c1, const Configuration& c2) const;
 
@@ -192,13 +201,19 @@ namespace Pareto {
 		virtual StorableObjectPtr copy(void) const;
 
 		bool isIdenticalTo(ConfigurationSpacePtr cs) const;
+
+	private:
+		/// the dominance kernel, created on first use and discarded when quantities are added
+		mutable std::shared_ptr<const DominanceKernel> kernel;
 	};
 
 
 	bool operator!=(ConfigurationSpace& cs1, ConfigurationSpace& cs2);
 
-	// An STL vector of QuantityValues
-	class ListOfQuantityValues : public std::vector<QuantityValuePtr> {
+	// An STL vector of QuantityValues, which may be allocated in the arena of a configuration set
+	class ListOfQuantityValues : public std::vector<QuantityValuePtr, ArenaAllocator<QuantityValuePtr>> {
+	public:
+		using std::vector<QuantityValuePtr, ArenaAllocator<QuantityValuePtr>>::vector;
 	};
 
 	/// A configuration of Pareto Algebra.
@@ -215,10 +230,11 @@ namespace Pareto {
 		ListOfQuantityValues quantities;
 
 	public:
-		/// Use ConfigurationSpace::newConfiguration() to create configurations!
-		Configuration(ConfigurationSpacePtr cs);
+		/// Use ConfigurationSpace::newConfiguration() or ConfigurationSet::createConfiguration()
+		/// to create configurations! The quantity values are listed in 'arena' if it is not nullptr.
+		Configuration(ConfigurationSpacePtr cs, const ConfigurationArenaPtr& arena = nullptr);
 		// 'copy constructor' from pointer
-		Configuration(ConfigurationPtr c);
+		Configuration(ConfigurationPtr c, const ConfigurationArenaPtr& arena = nullptr);
 
 		virtual ~Configuration(){};
 
@@ -297,6 +313,9 @@ namespace Pareto {
 		//ConfigurationIndexOnUnorderedReference& operator= (ConfigurationIndexOnUnorderedReference& right);
 	};
 
+	using ConfigurationIndexOnUnorderedReferencePtr = std::shared_ptr<ConfigurationIndexOnUnorderedReference>;
+	bool operator<(const ConfigurationIndexOnUnorderedReferencePtr pa, const ConfigurationIndexOnUnorderedReferencePtr pb);
+
 	class IndexOnConfigurationSet {
 	public:
 		const QuantityName& quantity;
@@ -320,13 +339,57 @@ namespace Pareto {
 
 	// Make an index on an unordered quantity, based on a total order derived from the string
 	// representation of the quantity values
-	class IndexOnUnorderedConfigurationSet: public std::vector<std::shared_ptr<ConfigurationIndexOnUnorderedReference>>, public IndexOnConfigurationSet {
+	class IndexOnUnorderedConfigurationSet: public std::vector<ConfigurationIndexOnUnorderedReferencePtr>, public IndexOnConfigurationSet {
 	public:
 		IndexOnUnorderedConfigurationSet(const QuantityName& qn, ConfigurationSetPtr cs);
 		virtual ConfigurationIndexReferencePtr get(int n) {return (this->at(n));}
 		virtual ConfigurationSetPtr copyFromTo(int f, int t);
 	};
 
+	// A range of the configurations of a configuration set, sorted on a totally ordered quantity.
+	// The set is sorted only once; the ranges of its lower and higher parts share the sorted
+	// permutation, such that the divide and conquer minimization can split them over and over
+	// without making and sorting a new index at every level of the recursion.
+	class SortedConfigurationRange {
+	public:
+		/// sort the configurations of 'cs' on quantity 'qn'
+		SortedConfigurationRange(const QuantityName& qn, ConfigurationSetPtr cs);
+
+		/// the number of configurations in the range
+		size_t size() const { return this->last - this->first; }
+
+		/// the configuration at position 'k' of the range
+		const ConfigurationPtr& conf(size_t k) const { return (*this->entries)[this->first + k].conf; }
+
+		/// the value of the sorted quantity at position 'k' of the range
+		const QuantityValue& value(size_t k) const { return *(*this->entries)[this->first + k].value; }
+
+		/// the part of the range from position 'f' up to, but not including, position 't'
+		SortedConfigurationRange range(size_t f, size_t t) const;
+
+		/// the first position of the range with a value that is not smaller than 'v'
+		size_t lower(const QuantityValue& v) const;
+
+		/// the first position of the range with a value that is larger than 'v'
+		size_t upper(const QuantityValue& v) const;
+
+		/// the value at position 'k' of the merge of the ranges 'a' and 'b'
+		static const QuantityValue& select(const SortedConfigurationRange& a, const SortedConfigurationRange& b, size_t k);
+
+		/// copy the range as a new configuration set
+		ConfigurationSetPtr copy() const;
+
+	private:
+		struct Entry {
+			const QuantityValue* value;
+			ConfigurationPtr conf;
+		};
+		std::shared_ptr<const std::vector<Entry>> entries;
+		ConfigurationSetPtr confset;
+		size_t first;
+		size_t last;
+	};
+
 
 
 
@@ -342,6 +405,12 @@ namespace Pareto {
 
 	class SetOfConfigurations: public std::set<ConfigurationPtr, CompareConfiguration> {};
 
+	/// The ways in which a configuration set can store its configurations
+	///
+	/// Nodes stores every configuration as a separate object in 'confs'.
+	/// Columnar stores one contiguous column of raw values per quantity (see ConfigurationColumns).
+	enum class StorageMode { Nodes, Columnar };
+
 
 	/// Represents a set of configurations
 	class ConfigurationSet : public StorableObject {
@@ -352,6 +421,17 @@ namespace Pareto {
 		/// copy constructor of a set of configurations on configuration space 'cs' and with name 'n'
 		ConfigurationSet(ConfigurationSetPtr cs);
 
+		/// constructor of a set in columnar storage mode from the columns 'cc' and with name 'n'
+		ConfigurationSet(ConfigurationColumnsPtr cc, const std::string n);
+
+		/// create a new configuration without quantity values in the space of the set and in
+		/// the arena of the set. It is not added to the set.
+		ConfigurationPtr createConfiguration(void) const;
+
+		/// create a new configuration in space 'cs' and in the arena of the set, with the
+		/// quantity values of 'c'. It is not added to the set.
+		ConfigurationPtr createConfiguration(ConfigurationSpacePtr cs, const ConfigurationPtr& c) const;
+
 		/// add a configuration to the set
 		void addConfiguration(ConfigurationPtr c);
 
@@ -371,6 +451,27 @@ namespace Pareto {
 		/// test whether the configuration is included in the set
 		bool containsConfiguration(ConfigurationPtr c);
 
+		/// return the number of configurations in the set, in either storage mode
+		size_t size(void) const;
+
+		/// return the storage mode of the set
+		StorageMode storageMode(void) const { return columns ? StorageMode::Columnar : StorageMode::Nodes; }
+
+		/// test whether the set is in columnar storage mode
+		bool isColumnar(void) const { return columns != nullptr; }
+
+		/// make the configurations of a columnar set available in confs(), if they are not yet.
+		/// The set stays in columnar storage mode, confs() is a view on the columns.
+		/// Call it before the set is shared between threads, as confs() materializes the view.
+		void materialize(void) const;
+
+		/// return the configurations as columns. For a set in node storage mode
+		/// the configurations are packed into new columns.
+		ConfigurationColumnsPtr asColumns(void) const;
+
+		/// return a copy of the set in columnar storage mode
+		ConfigurationSetPtr toColumnar(void) const;
+
 		/// stream a string representation of the configuration set to 'os'
 		virtual void streamOn(std::ostream& os) const;
 
@@ -384,14 +485,41 @@ namespace Pareto {
 		virtual StorableObjectPtr copy(void) const;
 	
 
-		// the actual configurations
-		SetOfConfigurations confs;
+		/// the actual configurations. For a set in columnar storage mode this is a view on the
+		/// columns that is materialized on the first access. Add configurations to a columnar set
+		/// with addConfiguration, which switches it to node storage mode, not through the view.
+		SetOfConfigurations& confs(void) {
+			if (columns && !materialized) this->materialize();
+			return configurations;
+		}
+		const SetOfConfigurations& confs(void) const {
+			if (columns && !materialized) this->materialize();
+			return configurations;
+		}
+
+		/// the columns of a set in columnar storage mode, nullptr in node storage mode
+		ConfigurationColumnsPtr columns;
 		
 		/// reference to the configuration space of the configurations in this set.
 		ConfigurationSpacePtr confspace;
 
+		/// the arena in which the configurations created for this set are allocated
+		ConfigurationArenaPtr arena = std::make_shared<ConfigurationArena>();
+
 		bool checkConfSpaceConsistency(void) const;
 		void adoptConfigurationSpaceOf(ConfigurationSetPtr cs);
+
+	private:
+		friend class ParetoArchive;
+
+		/// the configurations of a set in node storage mode, or the view on the columns
+		mutable SetOfConfigurations configurations;
+
+		/// true if 'configurations' holds the view on the columns of a columnar set
+		mutable bool materialized = false;
+
+		/// switch a columnar set to node storage mode before modifying 'confs'
+		void toNodes(void);
 	};
 
 
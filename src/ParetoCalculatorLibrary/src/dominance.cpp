@@ -0,0 +1,102 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Implements the dominance kernel of a configuration space
+//
+
+#include "dominance.h"
+#include "columns.h"
+#include "profiling.h"
+
+
+namespace Pareto {
+
+	DominanceKernel::DominanceKernel(const ConfigurationSpace& cs) {
+		for (unsigned int i = 0; i < cs.quantities.size(); i++) {
+			if (!cs.quantityVisibility[i]) continue;
+			switch (columnKindOf(*cs.quantities[i])) {
+			case ColumnKind::Real: reals.push_back(i); break;
+			case ColumnKind::Integer: integers.push_back(i); break;
+			case ColumnKind::Enum: enums.push_back(i); break;
+			case ColumnKind::Unordered: unordered.push_back(i); break;
+			}
+		}
+		if (reals.empty()) test = this->selectIntegers<false>();
+		else test = this->selectIntegers<true>();
+	}
+
+	template <bool R>
+	DominanceKernel::DominanceTest DominanceKernel::selectIntegers(void) const {
+		if (integers.empty()) return this->selectEnums<R, false>();
+		return this->selectEnums<R, true>();
+	}
+
+	template <bool R, bool I>
+	DominanceKernel::DominanceTest DominanceKernel::selectEnums(void) const {
+		if (enums.empty()) return this->selectUnordered<R, I, false>();
+		return this->selectUnordered<R, I, true>();
+	}
+
+	template <bool R, bool I, bool E>
+	DominanceKernel::DominanceTest DominanceKernel::selectUnordered(void) const {
+		if (unordered.empty()) return &DominanceKernel::dominatesShape<R, I, E, false>;
+		return &DominanceKernel::dominatesShape<R, I, E, true>;
+	}
+
+	template <bool R, bool I, bool E, bool U>
+	bool DominanceKernel::dominatesShape(const DominanceKernel& k, const Configuration& c1, const Configuration& c2) {
+		ProfileCounters::dominanceTests++;
+		const ListOfQuantityValues& q1 = c1.quantities;
+		const ListOfQuantityValues& q2 = c2.quantities;
+		// the unordered quantities are the most likely to fail the test, check them first
+		if (U) {
+			for (unsigned int i : k.unordered) {
+				if (static_cast<const QuantityValue_Enum&>(*q1[i]).code != static_cast<const QuantityValue_Enum&>(*q2[i]).code) return false;
+			}
+		}
+		if (R) {
+			for (unsigned int i : k.reals) {
+				if (static_cast<const QuantityValue_Real&>(*q1[i]).value > static_cast<const QuantityValue_Real&>(*q2[i]).value) return false;
+			}
+		}
+		if (I) {
+			for (unsigned int i : k.integers) {
+				if (static_cast<const QuantityValue_Integer&>(*q1[i]).value > static_cast<const QuantityValue_Integer&>(*q2[i]).value) return false;
+			}
+		}
+		if (E) {
+			for (unsigned int i : k.enums) {
+				if (static_cast<const QuantityValue_Enum&>(*q1[i]).code > static_cast<const QuantityValue_Enum&>(*q2[i]).code) return false;
+			}
+		}
+		return true;
+	}
+
+}
@@ -0,0 +1,94 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// A dominance test between configurations that is specialized for the shape
+// of a configuration space
+//
+
+#ifndef PARETO_DOMINANCE_H
+#define PARETO_DOMINANCE_H
+
+#include <vector>
+#include "configuration.h"
+
+
+namespace Pareto {
+
+	/// Tests dominance between configurations of a configuration space.
+	///
+	/// The visible quantities of the space are grouped by their kind (real, integer,
+	/// ordered enumeration, unordered enumeration). Dominance is then tested on the raw values,
+	/// without virtual calls and without copying shared pointers, by a test function that
+	/// is instantiated for the kinds that occur in the space.
+	/// Use ConfigurationSpace::dominanceKernel() to obtain the kernel of a space.
+	class DominanceKernel {
+	public:
+		/// Constructor of the kernel for configuration space 'cs'
+		DominanceKernel(const ConfigurationSpace& cs);
+
+		/// test if configuration 'c1' dominates (<=) configuration 'c2'
+		bool dominates(const Configuration& c1, const Configuration& c2) const {
+			return (*test)(*this, c1, c2);
+		}
+
+		/// indices of the visible real quantities
+		std::vector<unsigned int> reals;
+
+		/// indices of the visible integer quantities
+		std::vector<unsigned int> integers;
+
+		/// indices of the visible ordered enumerated quantities
+		std::vector<unsigned int> enums;
+
+		/// indices of the visible unordered quantities
+		std::vector<unsigned int> unordered;
+
+	private:
+		using DominanceTest = bool (*)(const DominanceKernel&, const Configuration&, const Configuration&);
+
+		/// the test function for the shape of the space
+		DominanceTest test;
+
+		/// the test function for a space with the given kinds of quantities
+		template <bool R, bool I, bool E, bool U>
+		static bool dominatesShape(const DominanceKernel& k, const Configuration& c1, const Configuration& c2);
+
+		/// select the instance of dominatesShape for the kinds of quantities that occur
+		template <bool R, bool I, bool E>
+		DominanceTest selectUnordered(void) const;
+		template <bool R, bool I>
+		DominanceTest selectEnums(void) const;
+		template <bool R>
+		DominanceTest selectIntegers(void) const;
+	};
+
+}
+
+#endif
@@ -0,0 +1,243 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Implements the vectorized dominance filter with run-time selection of the
+// instruction set
+//
+
+#include "dominancefilter.h"
+#include "dominance.h"
+#include "profiling.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define PARETO_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// MSVC compiles intrinsics for any instruction set without special flags
+#define PARETO_TARGET(s)
+#else
+#define PARETO_TARGET(s) __attribute__((target(s)))
+#endif
+#endif
+
+
+namespace Pareto {
+
+	/////////////// PackedConfigurations ///////////////////
+
+	PackedConfigurations::PackedConfigurations(const ConfigurationSpace& cs, const std::vector<const Configuration*>& confs) :
+		size(confs.size())
+	{
+		const DominanceKernel& dk = cs.dominanceKernel();
+		size_t padded = this->nrOfBlocks() * BlockSize;
+
+		// the unordered quantities first, they are the most likely to rule out dominance
+		for (unsigned int q : dk.unordered) {
+			std::vector<double> lane(padded, 0.0);
+			for (size_t k = 0; k < size; k++) lane[k] = static_cast<const QuantityValue_Enum&>(*confs[k]->quantities[q]).code;
+			lanes.push_back(std::move(lane));
+			equality.push_back(true);
+		}
+		for (unsigned int q : dk.reals) {
+			std::vector<double> lane(padded, 0.0);
+			for (size_t k = 0; k < size; k++) lane[k] = static_cast<const QuantityValue_Real&>(*confs[k]->quantities[q]).value;
+			lanes.push_back(std::move(lane));
+			equality.push_back(false);
+		}
+		for (unsigned int q : dk.integers) {
+			std::vector<double> lane(padded, 0.0);
+			for (size_t k = 0; k < size; k++) lane[k] = static_cast<const QuantityValue_Integer&>(*confs[k]->quantities[q]).value;
+			lanes.push_back(std::move(lane));
+			equality.push_back(false);
+		}
+		for (unsigned int q : dk.enums) {
+			std::vector<double> lane(padded, 0.0);
+			for (size_t k = 0; k < size; k++) lane[k] = static_cast<const QuantityValue_Enum&>(*confs[k]->quantities[q]).code;
+			lanes.push_back(std::move(lane));
+			equality.push_back(false);
+		}
+	}
+
+
+	/////////////// DominanceFilter ///////////////////
+
+	std::atomic<DominanceFilter::InstructionSet> DominanceFilter::instructionSet(DominanceFilter::detect());
+
+	DominanceFilter::InstructionSet DominanceFilter::detect(void) {
+#if defined(PARETO_X86) && defined(_MSC_VER) && !defined(__clang__)
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] < 7) return InstructionSet::Scalar;
+		__cpuid(info, 1);
+		// the OS must save the vector registers
+		bool osxsave = (info[2] & (1 << 27)) != 0;
+		if (!osxsave) return InstructionSet::Scalar;
+		unsigned long long xcr0 = _xgetbv(0);
+		__cpuidex(info, 7, 0);
+		if ((info[1] & (1 << 16)) && (xcr0 & 0xE6) == 0xE6) return InstructionSet::AVX512;
+		if ((info[1] & (1 << 5)) && (xcr0 & 0x6) == 0x6) return InstructionSet::AVX2;
+		return InstructionSet::Scalar;
+#elif defined(PARETO_X86)
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx512f")) return InstructionSet::AVX512;
+		if (__builtin_cpu_supports("avx2")) return InstructionSet::AVX2;
+		return InstructionSet::Scalar;
+#else
+		return InstructionSet::Scalar;
+#endif
+	}
+
+	DominanceFilter::InstructionSet DominanceFilter::active(void) {
+		return instructionSet.load();
+	}
+
+	void DominanceFilter::select(InstructionSet s) {
+		InstructionSet supported = DominanceFilter::detect();
+		instructionSet.store(s <= supported ? s : supported);
+	}
+
+	/// the survivor mask of a block of configurations of 'b' w.r.t. configuration 'i' of 'a'
+	static inline uint8_t scalarBlock(const PackedConfigurations& a, size_t i, const PackedConfigurations& b, size_t blk, uint8_t alive) {
+		for (size_t k = 0; k < PackedConfigurations::BlockSize; k++) {
+			if (!(alive & (1 << k))) continue;
+			size_t j = blk * PackedConfigurations::BlockSize + k;
+			bool dominated = true;
+			for (size_t d = 0; dominated && d < a.lanes.size(); d++) {
+				dominated = b.equality[d] ? a.lanes[d][i] == b.lanes[d][j] : a.lanes[d][i] <= b.lanes[d][j];
+			}
+			if (dominated) alive &= ~(1 << k);
+		}
+		return alive;
+	}
+
+	static unsigned long long survivorsScalar(const PackedConfigurations& a, const PackedConfigurations& b, std::vector<uint8_t>& alive) {
+		unsigned long long tested = 0;
+		for (size_t i = 0; i < a.size; i++) {
+			for (size_t blk = 0; blk < alive.size(); blk++) {
+				if (!alive[blk]) continue;
+				tested++;
+				alive[blk] = scalarBlock(a, i, b, blk, alive[blk]);
+			}
+		}
+		return tested;
+	}
+
+#ifdef PARETO_X86
+
+	PARETO_TARGET("avx2")
+	static unsigned long long survivorsAVX2(const PackedConfigurations& a, const PackedConfigurations& b, std::vector<uint8_t>& alive) {
+		unsigned long long tested = 0;
+		size_t nd = a.lanes.size();
+		std::vector<const double*> lanes(nd);
+		for (size_t d = 0; d < nd; d++) lanes[d] = b.lanes[d].data();
+		for (size_t i = 0; i < a.size; i++) {
+			for (size_t blk = 0; blk < alive.size(); blk++) {
+				if (!alive[blk]) continue;
+				tested++;
+				size_t o = blk * PackedConfigurations::BlockSize;
+				__m256d lo = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+				__m256d hi = lo;
+				for (size_t d = 0; d < nd; d++) {
+					__m256d va = _mm256_broadcast_sd(&a.lanes[d][i]);
+					__m256d blo = _mm256_loadu_pd(lanes[d] + o);
+					__m256d bhi = _mm256_loadu_pd(lanes[d] + o + 4);
+					if (b.equality[d]) {
+						lo = _mm256_and_pd(lo, _mm256_cmp_pd(va, blo, _CMP_EQ_OQ));
+						hi = _mm256_and_pd(hi, _mm256_cmp_pd(va, bhi, _CMP_EQ_OQ));
+					}
+					else {
+						lo = _mm256_and_pd(lo, _mm256_cmp_pd(va, blo, _CMP_LE_OQ));
+						hi = _mm256_and_pd(hi, _mm256_cmp_pd(va, bhi, _CMP_LE_OQ));
+					}
+					// stop when none of the block is dominated
+					if (_mm256_movemask_pd(lo) == 0 && _mm256_movemask_pd(hi) == 0) break;
+				}
+				uint8_t dominated = (uint8_t)(_mm256_movemask_pd(lo) | (_mm256_movemask_pd(hi) << 4));
+				alive[blk] &= ~dominated;
+			}
+		}
+		return tested;
+	}
+
+	PARETO_TARGET("avx512f")
+	static unsigned long long survivorsAVX512(const PackedConfigurations& a, const PackedConfigurations& b, std::vector<uint8_t>& alive) {
+		unsigned long long tested = 0;
+		size_t nd = a.lanes.size();
+		std::vector<const double*> lanes(nd);
+		for (size_t d = 0; d < nd; d++) lanes[d] = b.lanes[d].data();
+		for (size_t i = 0; i < a.size; i++) {
+			for (size_t blk = 0; blk < alive.size(); blk++) {
+				__mmask8 m = alive[blk];
+				if (!m) continue;
+				tested++;
+				size_t o = blk * PackedConfigurations::BlockSize;
+				for (size_t d = 0; m && d < nd; d++) {
+					__m512d va = _mm512_set1_pd(a.lanes[d][i]);
+					__m512d vb = _mm512_loadu_pd(lanes[d] + o);
+					if (b.equality[d]) m = _mm512_mask_cmp_pd_mask(m, va, vb, _CMP_EQ_OQ);
+					else m = _mm512_mask_cmp_pd_mask(m, va, vb, _CMP_LE_OQ);
+				}
+				alive[blk] &= (uint8_t)~m;
+			}
+		}
+		return tested;
+	}
+
+#endif
+
+	std::vector<uint8_t> DominanceFilter::survivors(const PackedConfigurations& a, const PackedConfigurations& b) {
+		if (a.lanes.size() != b.lanes.size()) {
+			throw EParetoCalculatorError("Configurations of different shape in DominanceFilter::survivors");
+		}
+		// initially all configurations of b survive, the padding does not
+		std::vector<uint8_t> alive(b.nrOfBlocks(), 0xFF);
+		size_t rest = b.size % PackedConfigurations::BlockSize;
+		if (rest > 0) alive.back() = (uint8_t)((1 << rest) - 1);
+
+		// the blocks of b tested against a configuration of a
+		unsigned long long tested;
+		switch (DominanceFilter::active()) {
+#ifdef PARETO_X86
+		case InstructionSet::AVX512:
+			tested = survivorsAVX512(a, b, alive);
+			break;
+		case InstructionSet::AVX2:
+			tested = survivorsAVX2(a, b, alive);
+			break;
+#endif
+		default:
+			tested = survivorsScalar(a, b, alive);
+		}
+		ProfileCounters::dominanceTests += tested * PackedConfigurations::BlockSize;
+		return alive;
+	}
+
+}
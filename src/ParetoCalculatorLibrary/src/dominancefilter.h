@@ -0,0 +1,98 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Vectorized filter that removes the configurations of one set that are dominated
+// by configurations of another set
+//
+
+#ifndef PARETO_DOMINANCEFILTER_H
+#define PARETO_DOMINANCEFILTER_H
+
+#include <vector>
+#include <cstdint>
+#include <atomic>
+#include "configuration.h"
+
+
+namespace Pareto {
+
+	/// The visible quantities of a list of configurations, packed as one contiguous
+	/// lane of doubles per quantity.
+	///
+	/// Integer values and the indices of enumerated values are represented exactly as doubles.
+	/// The lanes are padded to a multiple of the block size of the filter.
+	class PackedConfigurations {
+	public:
+		/// number of configurations processed together by the filter
+		static const size_t BlockSize = 8;
+
+		/// pack the configurations 'confs' of configuration space 'cs'
+		PackedConfigurations(const ConfigurationSpace& cs, const std::vector<const Configuration*>& confs);
+
+		/// the number of configurations
+		size_t size;
+
+		/// the number of blocks of BlockSize configurations
+		size_t nrOfBlocks(void) const { return (size + BlockSize - 1) / BlockSize; }
+
+		/// one lane per visible quantity
+		std::vector<std::vector<double>> lanes;
+
+		/// true for the lanes of unordered quantities, for which dominance requires equality
+		std::vector<bool> equality;
+	};
+
+	/// Removes the configurations dominated by the configurations of another set, using
+	/// the widest vector instructions supported by the processor.
+	class DominanceFilter {
+	public:
+		/// The instruction sets the filter can use
+		enum class InstructionSet { Scalar, AVX2, AVX512 };
+
+		/// determine the widest instruction set supported by the processor
+		static InstructionSet detect(void);
+
+		/// the instruction set that is currently used, by default the result of detect()
+		static InstructionSet active(void);
+
+		/// select the instruction set to use. If it is not supported, the widest supported one is used.
+		static void select(InstructionSet s);
+
+		/// determine which configurations of 'b' are not dominated by any configuration of 'a'.
+		/// Returns one byte per block of 'b', in which bit k is set if configuration k of the block survives.
+		static std::vector<uint8_t> survivors(const PackedConfigurations& a, const PackedConfigurations& b);
+
+	private:
+		static std::atomic<InstructionSet> instructionSet;
+	};
+
+}
+
+#endif
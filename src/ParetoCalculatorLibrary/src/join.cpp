@@ -0,0 +1,244 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Implements the hash join of sets of configurations
+//
+
+#include "join.h"
+#include "profiling.h"
+#include "taskpool.h"
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <limits>
+
+
+namespace Pareto {
+
+	/// the key word of an enumerated value that does not occur in the type of the other set
+	static const uint64_t NO_MATCH = std::numeric_limits<uint64_t>::max();
+
+	/// marks the end of a chain in a hash table
+	static const size_t NO_ROW = std::numeric_limits<size_t>::max();
+
+	/// mix the bits of 'h' (the finalizer of splitmix64)
+	static inline uint64_t mixHash(uint64_t h) {
+		h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+		h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+		return h ^ (h >> 31);
+	}
+
+	/// execute 'f' for every partition from 0 to 'parts', as parallel tasks on 'pool' if it is not nullptr
+	static void forEachPartition(TaskPool* pool, size_t parts, const std::function<void(size_t)>& f) {
+		if (pool == nullptr) {
+			for (size_t p = 0; p < parts; p++) f(p);
+			return;
+		}
+		std::vector<TaskPtr> tasks;
+		std::vector<ProfileTransfer> work(parts);
+		unsigned int depth = ProfileCounters::depth;
+		for (size_t p = 0; p < parts; p++) {
+			tasks.push_back(pool->fork([&f, &work, p, depth]() {
+				ProfileContinuation partition(depth, &work[p]);
+				f(p);
+			}));
+		}
+		// wait for all tasks, as they refer to local variables, before reporting an error
+		std::exception_ptr error;
+		for (const TaskPtr& t : tasks) {
+			try {
+				pool->join(t);
+			}
+			catch (...) {
+				if (!error) error = std::current_exception();
+			}
+		}
+		if (error) {
+			std::rethrow_exception(error);
+		}
+		for (const ProfileTransfer& w : work) {
+			w.addToCounters();
+		}
+	}
+
+	HashJoin::HashJoin(ConfigurationSetPtr a, ConfigurationSetPtr b, const StringMap& jmap, ConfigurationSpacePtr productspace) :
+		a(a),
+		b(b),
+		productspace(productspace)
+	{
+		for (StringMap::const_iterator i = jmap.begin(); i != jmap.end(); i++) {
+			if (!a->confspace->includesQuantityNamed(i->first)) {
+				throw EParetoCalculatorError("Quantity " + i->first + " does not exist in join");
+			}
+			if (!b->confspace->includesQuantityNamed(i->second)) {
+				throw EParetoCalculatorError("Quantity " + i->second + " does not exist in join");
+			}
+			unsigned int ia = a->confspace->indexOfQuantity(i->first);
+			unsigned int ib = b->confspace->indexOfQuantity(i->second);
+			const QuantityType& ta = *a->confspace->quantities[ia];
+			const QuantityType& tb = *b->confspace->quantities[ib];
+			ColumnKind kind = columnKindOf(ta);
+			if (columnKindOf(tb) != kind) {
+				throw EParetoCalculatorError("Cannot join quantities " + i->first + " and " + i->second + " of different types");
+			}
+			qa.push_back(ia);
+			qb.push_back(ib);
+			kinds.push_back(kind);
+
+			// values of different enumerated types are matched on their names
+			std::vector<uint64_t> t;
+			if ((kind == ColumnKind::Enum || kind == ColumnKind::Unordered) && &ta != &tb) {
+				const QuantityType_Enum& ea = (const QuantityType_Enum&)ta;
+				const QuantityType_Enum& eb = (const QuantityType_Enum&)tb;
+				for (const std::string& n : eb.names) {
+					std::vector<std::string>::const_iterator k = std::find(ea.names.begin(), ea.names.end(), n);
+					t.push_back(k == ea.names.end() ? NO_MATCH : (uint64_t)(k - ea.names.begin()));
+				}
+			}
+			translation.push_back(t);
+		}
+	}
+
+	HashJoin::Keys HashJoin::keysOf(const std::vector<const Configuration*>& confs, const std::vector<unsigned int>& q, bool translate) const {
+		Keys keys;
+		size_t w = this->width();
+		keys.words.resize(confs.size() * w);
+		keys.hashes.resize(confs.size());
+		for (size_t r = 0; r < confs.size(); r++) {
+			uint64_t h = 0x9e3779b97f4a7c15ull;
+			for (size_t k = 0; k < w; k++) {
+				const QuantityValue& v = *confs[r]->quantities[q[k]];
+				uint64_t word;
+				switch (kinds[k]) {
+				case ColumnKind::Real: {
+					// equal reals must have equal keys, including zero and negative zero
+					double d = ((const QuantityValue_Real&)v).value;
+					if (d == 0.0) d = 0.0;
+					std::memcpy(&word, &d, sizeof(word));
+					break;
+				}
+				case ColumnKind::Integer:
+					word = (uint64_t)(int64_t)((const QuantityValue_Integer&)v).value;
+					break;
+				default:
+					word = ((const QuantityValue_Enum&)v).code;
+					if (translate && !translation[k].empty()) word = translation[k][word];
+				}
+				keys.words[r * w + k] = word;
+				h = mixHash(h ^ word);
+			}
+			keys.hashes[r] = h;
+		}
+		return keys;
+	}
+
+	bool HashJoin::sameKey(const Keys& ka, size_t r, const Keys& kb, size_t s) const {
+		size_t w = this->width();
+		for (size_t k = 0; k < w; k++) {
+			if (ka.words[r * w + k] != kb.words[s * w + k]) return false;
+		}
+		return true;
+	}
+
+	ConfigurationSetPtr HashJoin::join(const JoinOptions& o) {
+		a->materialize();
+		b->materialize();
+		std::vector<ConfigurationPtr> pa(a->confs().begin(), a->confs().end());
+		std::vector<ConfigurationPtr> pb(b->confs().begin(), b->confs().end());
+		std::vector<const Configuration*> ca, cb;
+		for (const ConfigurationPtr& c : pa) ca.push_back(c.get());
+		for (const ConfigurationPtr& c : pb) cb.push_back(c.get());
+
+		// the keys of 'b' are expressed in the values of 'a'
+		Keys ka = this->keysOf(ca, qa, false);
+		Keys kb = this->keysOf(cb, qb, true);
+
+		// partition both sets on the high bits of the hash, the hash tables use the low bits
+		TaskPool* tasks = nullptr;
+		size_t parts = 1;
+		if (o.parallel && ca.size() + cb.size() >= o.grain) {
+			tasks = o.pool != nullptr ? o.pool : &TaskPool::shared();
+			if (tasks->size() > 1) parts = 4 * (size_t)tasks->size();
+			else tasks = nullptr;
+		}
+		std::vector<std::vector<size_t>> ra(parts), rb(parts);
+		for (size_t r = 0; r < ca.size(); r++) ra[(ka.hashes[r] >> 32) % parts].push_back(r);
+		for (size_t s = 0; s < cb.size(); s++) rb[(kb.hashes[s] >> 32) % parts].push_back(s);
+
+		// find the matching pairs per partition
+		std::vector<std::vector<std::pair<size_t, size_t>>> matches(parts);
+		forEachPartition(tasks, parts, [&](size_t p) {
+			const std::vector<size_t>& rows = rb[p];
+			size_t buckets = 1;
+			while (buckets < 2 * rows.size()) buckets <<= 1;
+			std::vector<size_t> head(buckets, NO_ROW);
+			std::vector<size_t> next(rows.size());
+			for (size_t i = 0; i < rows.size(); i++) {
+				size_t h = (size_t)(kb.hashes[rows[i]] & (buckets - 1));
+				next[i] = head[h];
+				head[h] = i;
+			}
+			for (size_t r : ra[p]) {
+				size_t h = (size_t)(ka.hashes[r] & (buckets - 1));
+				for (size_t i = head[h]; i != NO_ROW; i = next[i]) {
+					size_t s = rows[i];
+					if (ka.hashes[r] == kb.hashes[s] && this->sameKey(ka, r, kb, s)) {
+						matches[p].emplace_back(r, s);
+					}
+				}
+			}
+		});
+
+		// create the configurations in a preallocated buffer, every partition in its own range and arena
+		std::vector<size_t> offsets(parts + 1, 0);
+		for (size_t p = 0; p < parts; p++) offsets[p + 1] = offsets[p] + matches[p].size();
+		std::vector<ConfigurationPtr> out(offsets[parts]);
+		forEachPartition(tasks, parts, [&](size_t p) {
+			ConfigurationArenaPtr arena = std::make_shared<ConfigurationArena>();
+			size_t o = offsets[p];
+			for (const std::pair<size_t, size_t>& m : matches[p]) {
+				ConfigurationPtr c = allocateInArena<Configuration>(arena, productspace, arena);
+				c->addQuantitiesOf(pa[m.first]);
+				c->addQuantitiesOf(pb[m.second]);
+				out[o++] = c;
+			}
+		});
+
+		// the configurations of a product are unique, insert them in order
+		std::sort(out.begin(), out.end(), CompareConfiguration());
+		ConfigurationSetPtr result = std::make_shared<ConfigurationSet>(productspace, "Join(" + a->name + ", " + b->name + ")");
+		for (const ConfigurationPtr& c : out) {
+			result->confs().insert(result->confs().end(), c);
+		}
+		return result;
+	}
+
+}
@@ -0,0 +1,102 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Hash join of sets of configurations on equal values of pairs of quantities
+//
+
+#ifndef PARETO_JOIN_H
+#define PARETO_JOIN_H
+
+#include <cstdint>
+#include <vector>
+#include "columns.h"
+#include "configuration.h"
+#include "minimizeoptions.h"
+#include "support.h"
+
+
+namespace Pareto {
+
+	class TaskPool;
+
+	/// Computes the join of two sets of configurations: the configurations of their product
+	/// in which the values of the joined pairs of quantities are equal.
+	///
+	/// Every configuration gets a composite key of the raw values of all its joined quantities:
+	/// the bits of real values, integer values and the indices of enumerated values. The keys
+	/// are hashed once and both sets are partitioned on the hash. Per partition the
+	/// configurations of the second set are entered in a hash table that is probed with those
+	/// of the first set. If requested, partitions are joined as parallel tasks. The matching
+	/// pairs are then turned into configurations in a preallocated output buffer.
+	class HashJoin {
+	public:
+		/// Constructor of a join of the quantities in 'a' with the names of the keys of 'jmap'
+		/// with the quantities in 'b' with the corresponding names, with configurations in space 'productspace'
+		HashJoin(ConfigurationSetPtr a, ConfigurationSetPtr b, const StringMap& jmap, ConfigurationSpacePtr productspace);
+
+		/// compute the join, sequentially unless the options request a parallel join and the sets
+		/// together have at least the grain of configurations.
+		ConfigurationSetPtr join(const JoinOptions& o = JoinOptions());
+
+	private:
+		/// the composite keys of the configurations of one set
+		struct Keys {
+			/// the words of the keys, 'width' per configuration
+			std::vector<uint64_t> words;
+			/// the hash of the key of every configuration
+			std::vector<uint64_t> hashes;
+		};
+
+		ConfigurationSetPtr a, b;
+		ConfigurationSpacePtr productspace;
+
+		/// the indices of the joined quantities in 'a' and in 'b'
+		std::vector<unsigned int> qa, qb;
+
+		/// the kinds of values of the joined quantities
+		std::vector<ColumnKind> kinds;
+
+		/// per joined pair of enumerated quantities of different types, the index in the type
+		/// of 'a' of every value of the type in 'b'; empty otherwise
+		std::vector<std::vector<uint64_t>> translation;
+
+		/// the number of words in a key
+		size_t width(void) const { return qa.size(); }
+
+		/// compute the keys of 'confs', taking the values of quantities 'q'
+		Keys keysOf(const std::vector<const Configuration*>& confs, const std::vector<unsigned int>& q, bool translate) const;
+
+		/// test if the key of configuration 'r' in 'ka' equals the key of configuration 's' in 'kb'
+		bool sameKey(const Keys& ka, size_t r, const Keys& kb, size_t s) const;
+	};
+
+}
+
+#endif
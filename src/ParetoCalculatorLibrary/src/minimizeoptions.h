@@ -0,0 +1,119 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Options and statistics of the divide-and-conquer minimization and options of the hash join
+//
+
+#ifndef PARETO_MINIMIZEOPTIONS_H
+#define PARETO_MINIMIZEOPTIONS_H
+
+#include <atomic>
+
+
+#define DEFAULT_MINIMIZE_THRESHOLD 2048
+#define DEFAULT_FILTER_THRESHOLD 2048
+#define DEFAULT_PARALLEL_GRAIN 8192
+
+
+namespace Pareto {
+
+	class MinimizeTrace;
+	class TaskPool;
+	class ThresholdTuner;
+
+	/// The algorithms to minimize the subproblems below the minimize threshold
+	enum class MinimizeAlgorithm { Block, SimpleCull, SortFilter };
+
+	/// Counters of the steps taken by a divide-and-conquer minimization.
+	/// The counters may be updated concurrently by parallel subproblems.
+	class MinimizeStatistics {
+	public:
+		/// subproblems solved with the base-case algorithm
+		std::atomic<unsigned long> baseCases{ 0 };
+		/// splits of a set into a lower and higher half
+		std::atomic<unsigned long> splits{ 0 };
+		/// classes of an unordered quantity minimized separately
+		std::atomic<unsigned long> classes{ 0 };
+		/// merges of two minimized halves
+		std::atomic<unsigned long> merges{ 0 };
+		/// filters solved by splitting
+		std::atomic<unsigned long> filterSplits{ 0 };
+		/// filters solved by a direct comparison of all configurations
+		std::atomic<unsigned long> simpleFilters{ 0 };
+		/// subproblems forked as parallel tasks
+		std::atomic<unsigned long> tasks{ 0 };
+		/// minimizations and filters solved by a sweep over two or three quantities
+		std::atomic<unsigned long> sweeps{ 0 };
+
+		/// set all counters to zero
+		void reset(void) {
+			baseCases = 0; splits = 0; classes = 0; merges = 0;
+			filterSplits = 0; simpleFilters = 0; tasks = 0; sweeps = 0;
+		}
+	};
+
+	/// The settings of a divide-and-conquer minimization. A minimization only reads
+	/// its options, so concurrent minimizations with different options do not interfere.
+	struct MinimizeOptions {
+		/// sets with fewer configurations are minimized with the base-case algorithm
+		unsigned int minimizeThreshold = DEFAULT_MINIMIZE_THRESHOLD;
+		/// filters between sets with fewer configurations compare all configurations
+		unsigned int filterThreshold = DEFAULT_FILTER_THRESHOLD;
+		/// the base-case algorithm
+		MinimizeAlgorithm baseCase = MinimizeAlgorithm::Block;
+		/// sweep sets with two or three totally ordered visible quantities instead of dividing them
+		bool sweepKernels = true;
+		/// solve subproblems concurrently
+		bool parallel = false;
+		/// subproblems with fewer configurations than the grain are solved sequentially
+		unsigned int grain = DEFAULT_PARALLEL_GRAIN;
+		/// the pool executing parallel subproblems, nullptr selects the shared pool
+		TaskPool* pool = nullptr;
+		/// if not nullptr, the steps of the minimization are counted here
+		MinimizeStatistics* statistics = nullptr;
+		/// if not nullptr, the phases of the recursion are traced here (see MinimizeTrace)
+		MinimizeTrace* trace = nullptr;
+		/// if not nullptr, the thresholds are replaced by the ones tuned for the set
+		ThresholdTuner* tuner = nullptr;
+	};
+
+	/// The settings of a hash join (see HashJoin).
+	struct JoinOptions {
+		/// join the partitions concurrently
+		bool parallel = false;
+		/// joins of sets with fewer configurations together than the grain are computed sequentially
+		unsigned int grain = DEFAULT_PARALLEL_GRAIN;
+		/// the pool executing the parallel partitions, nullptr selects the shared pool
+		TaskPool* pool = nullptr;
+	};
+
+}
+
+#endif
@@ -0,0 +1,204 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Implements the trace of the recursion of the divide-and-conquer minimization
+//
+
+#include "minimizetrace.h"
+#include "profiling.h"
+#include <iomanip>
+
+
+namespace Pareto {
+
+	const char* minimizePhaseName(MinimizePhase p) {
+		static const char* names[NR_OF_MINIMIZE_PHASES] = { "minimize", "base", "sweep", "classes", "split", "index",
+			"merge", "filter1", "filter2", "filter3", "filter4", "filter_sweep" };
+		return names[static_cast<size_t>(p)];
+	}
+
+	MinimizeTrace::MinimizeTrace() : origin(std::chrono::steady_clock::now()) {
+	}
+
+	std::vector<MinimizeTrace::Event> MinimizeTrace::events(void) const {
+		std::lock_guard<std::mutex> guard(this->lock);
+		return this->recordedEvents;
+	}
+
+	std::vector<MinimizeTrace::Level> MinimizeTrace::levels(void) const {
+		std::lock_guard<std::mutex> guard(this->lock);
+		return this->recordedLevels;
+	}
+
+	void MinimizeTrace::clear(void) {
+		std::lock_guard<std::mutex> guard(this->lock);
+		this->recordedEvents.clear();
+		this->recordedLevels.clear();
+		this->threads.clear();
+		this->origin = std::chrono::steady_clock::now();
+	}
+
+	MinimizeTrace::Level& MinimizeTrace::at(unsigned int level) {
+		if (level >= this->recordedLevels.size()) {
+			this->recordedLevels.resize(level + 1);
+		}
+		return this->recordedLevels[level];
+	}
+
+	void MinimizeTrace::recordSplit(unsigned int level, size_t low, size_t high) {
+		std::lock_guard<std::mutex> guard(this->lock);
+		Level& l = this->at(level);
+		l.splits++;
+		l.lowSizes += low;
+		l.highSizes += high;
+	}
+
+	void MinimizeTrace::recordFilter2(unsigned int level, bool fallsThrough) {
+		std::lock_guard<std::mutex> guard(this->lock);
+		Level& l = this->at(level);
+		l.filter2++;
+		if (fallsThrough) l.filter2ToFilter3++;
+	}
+
+	void MinimizeTrace::recordProjection(unsigned int level, size_t low, size_t high) {
+		std::lock_guard<std::mutex> guard(this->lock);
+		Level& l = this->at(level);
+		l.projections++;
+		l.projectedLowSizes += low;
+		l.projectedHighSizes += high;
+	}
+
+	void MinimizeTrace::record(Event e, std::chrono::steady_clock::time_point start) {
+		std::lock_guard<std::mutex> guard(this->lock);
+		e.start = std::chrono::duration<double, std::micro>(start - this->origin).count();
+		std::map<std::thread::id, unsigned int>::iterator t = this->threads.find(std::this_thread::get_id());
+		if (t == this->threads.end()) {
+			t = this->threads.insert(std::make_pair(std::this_thread::get_id(), (unsigned int) this->threads.size() + 1)).first;
+		}
+		e.thread = t->second;
+		Level& l = this->at(e.level);
+		l.dominanceTests[static_cast<size_t>(e.phase)] += e.dominanceTests;
+		if (e.phase == MinimizePhase::Index) {
+			l.indexes++;
+			l.indexSeconds += e.duration / 1e6;
+		}
+		this->recordedEvents.push_back(e);
+	}
+
+	void MinimizeTrace::writeChromeTrace(std::ostream& os) const {
+		std::lock_guard<std::mutex> guard(this->lock);
+		os << "{\"traceEvents\":[" << std::endl;
+		bool first = true;
+		for (const std::pair<const std::thread::id, unsigned int>& t : this->threads) {
+			os << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << t.second
+				<< ",\"args\":{\"name\":\"thread " << t.second << "\"}}";
+			first = false;
+		}
+		for (const Event& e : this->recordedEvents) {
+			os << (first ? "" : ",\n") << "{\"name\":\"" << minimizePhaseName(e.phase) << "\",\"cat\":\"minimize\",\"ph\":\"X\""
+				<< ",\"ts\":" << std::fixed << std::setprecision(3) << e.start << ",\"dur\":" << e.duration
+				<< ",\"pid\":1,\"tid\":" << e.thread << ",\"args\":{\"level\":" << e.level << ",\"size\":" << e.size;
+			if (e.otherSize > 0) {
+				os << ",\"other_size\":" << e.otherSize;
+			}
+			os << ",\"dominance_tests\":" << e.dominanceTests << "}}";
+			first = false;
+		}
+		os << std::endl << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+	}
+
+	void MinimizeTrace::streamOn(std::ostream& os) const {
+		std::vector<Level> levels = this->levels();
+		os << std::setw(6) << "level" << std::setw(8) << "splits" << std::setw(12) << "low" << std::setw(12) << "high"
+			<< std::setw(9) << "filter2" << std::setw(10) << "->filter3" << std::setw(12) << "projections"
+			<< std::setw(12) << "projected" << std::setw(9) << "indexes" << std::setw(12) << "index (ms)"
+			<< "  dominance tests per phase" << std::endl;
+		for (size_t k = 0; k < levels.size(); k++) {
+			const Level& l = levels[k];
+			os << std::setw(6) << k << std::setw(8) << l.splits << std::setw(12) << l.lowSizes << std::setw(12) << l.highSizes
+				<< std::setw(9) << l.filter2 << std::setw(10) << l.filter2ToFilter3 << std::setw(12) << l.projections
+				<< std::setw(12) << l.projectedLowSizes + l.projectedHighSizes << std::setw(9) << l.indexes
+				<< std::setw(12) << std::fixed << std::setprecision(3) << l.indexSeconds * 1000.0 << " ";
+			for (size_t p = 0; p < NR_OF_MINIMIZE_PHASES; p++) {
+				if (l.dominanceTests[p] > 0) {
+					os << " " << minimizePhaseName(static_cast<MinimizePhase>(p)) << ":" << l.dominanceTests[p];
+				}
+			}
+			os << std::endl;
+		}
+	}
+
+	unsigned int MinimizeTrace::currentLevel(void) {
+		// the depth counts the subproblems entered, the complete set is the first
+		return ProfileCounters::depth > 0 ? ProfileCounters::depth - 1 : 0;
+	}
+
+	MinimizeTraceSpan::MinimizeTraceSpan(const MinimizeOptions& o, MinimizePhase p, size_t size, size_t otherSize) {
+		if (o.trace != nullptr) this->start(o.trace, p, size, otherSize);
+	}
+
+	void MinimizeTraceSpan::start(MinimizeTrace* t, MinimizePhase p, size_t size, size_t otherSize) {
+		this->tr = t;
+		this->event.phase = p;
+		this->event.level = MinimizeTrace::currentLevel();
+		this->event.size = size;
+		this->event.otherSize = otherSize;
+		// a task that runs in the join of another task is not part of the phases of that task
+		this->task = ProfileCounters::task;
+		this->outer = MinimizeTraceSpan::current;
+		if (this->outer != nullptr && this->outer->task == this->task) {
+			this->parent = this->outer;
+		}
+		MinimizeTraceSpan::current = this;
+		this->dominanceTests = ProfileCounters::dominanceTests;
+		this->joinedTests = ProfileCounters::joinedTests;
+		this->startTime = std::chrono::steady_clock::now();
+	}
+
+	MinimizeTraceSpan::~MinimizeTraceSpan() {
+		if (this->tr == nullptr) return;
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		this->event.duration = std::chrono::duration<double, std::micro>(end - this->startTime).count();
+		// the tests of this phase and its nested phases, without those of the joined tasks
+		unsigned long long tests = ProfileCounters::dominanceTests - this->dominanceTests - (ProfileCounters::joinedTests - this->joinedTests);
+		this->event.dominanceTests = tests - this->nestedTests;
+		MinimizeTraceSpan::current = this->outer;
+		if (this->parent != nullptr) {
+			this->parent->nestedTests += tests;
+		}
+		try {
+			this->tr->record(this->event, this->startTime);
+		}
+		catch (...) {
+			// a destructor must not throw
+		}
+	}
+
+}
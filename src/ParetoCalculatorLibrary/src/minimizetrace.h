@@ -0,0 +1,217 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// A trace of the recursion of the divide-and-conquer minimization
+//
+
+#ifndef PARETO_MINIMIZETRACE_H
+#define PARETO_MINIMIZETRACE_H
+
+#include <array>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+#include "minimizeoptions.h"
+
+
+namespace Pareto {
+
+	/// The phases of the divide-and-conquer minimization
+	enum class MinimizePhase {
+		/// the complete minimization
+		Minimize,
+		/// a subproblem minimized with the base-case algorithm
+		Base,
+		/// a subproblem minimized with a sweep
+		Sweep,
+		/// the separate minimization of the classes of an unordered quantity
+		Classes,
+		/// the division of a sorted range into a lower and higher half
+		Split,
+		/// the sort of a set on a totally ordered quantity (SortedConfigurationRange)
+		Index,
+		/// the merge of two minimized halves
+		Merge,
+		/// the filter of the higher half on the projection that hides the split quantity
+		Filter1,
+		/// the filter by division of the sets
+		Filter2,
+		/// the filter by a comparison of all configurations
+		Filter3,
+		/// the filter of a single totally ordered quantity
+		Filter4,
+		/// the filter by a sweep
+		FilterSweep
+	};
+
+	/// the number of phases
+	const size_t NR_OF_MINIMIZE_PHASES = 12;
+
+	/// the name of phase 'p'
+	const char* minimizePhaseName(MinimizePhase p);
+
+	/// A trace of the recursion of divide-and-conquer minimizations with MinimizeOptions::trace
+	/// set to it. The trace keeps an event for every phase of the recursion and totals per
+	/// level of the recursion, level 0 being the complete set. It can be written in the Chrome
+	/// trace-event format, to be inspected with a trace viewer in a browser.
+	///
+	/// The trace may be updated concurrently by parallel subproblems. Its events and totals
+	/// are meant to be inspected after the minimizations.
+	class MinimizeTrace {
+	public:
+		/// A phase of the recursion
+		class Event {
+		public:
+			MinimizePhase phase;
+			/// the level of the recursion
+			unsigned int level;
+			/// the number of the thread, in order of appearance
+			unsigned int thread;
+			/// the start since the creation of the trace and the duration, in microseconds
+			double start;
+			double duration;
+			/// the number of configurations of the (first) operand and of the second operand
+			size_t size;
+			size_t otherSize;
+			/// the dominance tests of the phase, excluding those of the phases within it
+			unsigned long long dominanceTests;
+		};
+
+		/// The totals of a level of the recursion
+		class Level {
+		public:
+			/// the number of divisions of a set and the total sizes of their lower and higher halves
+			unsigned long splits = 0;
+			size_t lowSizes = 0;
+			size_t highSizes = 0;
+			/// the number of filters by division and how many of them compare all configurations instead
+			unsigned long filter2 = 0;
+			unsigned long filter2ToFilter3 = 0;
+			/// the number of projections of filter1 and the total sizes of the projected halves
+			unsigned long projections = 0;
+			size_t projectedLowSizes = 0;
+			size_t projectedHighSizes = 0;
+			/// the number of index constructions and their total time in seconds
+			unsigned long indexes = 0;
+			double indexSeconds = 0.0;
+			/// the dominance tests per phase
+			std::array<unsigned long long, NR_OF_MINIMIZE_PHASES> dominanceTests{};
+		};
+
+		MinimizeTrace();
+
+		/// the events recorded so far
+		std::vector<Event> events(void) const;
+
+		/// the totals per level recorded so far
+		std::vector<Level> levels(void) const;
+
+		/// remove all events and totals
+		void clear(void);
+
+		/// record the division of a set at 'level' into halves of 'low' and 'high' configurations
+		void recordSplit(unsigned int level, size_t low, size_t high);
+
+		/// record a filter by division at 'level' that compares all configurations if 'fallsThrough'
+		void recordFilter2(unsigned int level, bool fallsThrough);
+
+		/// record the projection by filter1 at 'level' to halves of 'low' and 'high' configurations
+		void recordProjection(unsigned int level, size_t low, size_t high);
+
+		/// record event 'e' that started at 'start'
+		void record(Event e, std::chrono::steady_clock::time_point start);
+
+		/// write the events in the Chrome trace-event format to 'os'
+		void writeChromeTrace(std::ostream& os) const;
+
+		/// stream a table of the totals per level to 'os'
+		void streamOn(std::ostream& os) const;
+
+		/// the level of the recursion of the minimization on the current thread
+		static unsigned int currentLevel(void);
+
+	private:
+		/// the totals of 'level', the lock must be held
+		Level& at(unsigned int level);
+
+		mutable std::mutex lock;
+		std::chrono::steady_clock::time_point origin;
+		std::map<std::thread::id, unsigned int> threads;
+		std::vector<Event> recordedEvents;
+		std::vector<Level> recordedLevels;
+	};
+
+	/// Records a phase of a minimization from construction to destruction in a MinimizeTrace
+	class MinimizeTraceSpan {
+	public:
+		/// trace phase 'p' of a minimization with options 'o', on operands of 'size' and
+		/// 'otherSize' configurations. Nothing is recorded if the options have no trace.
+		MinimizeTraceSpan(const MinimizeOptions& o, MinimizePhase p, size_t size, size_t otherSize = 0);
+
+		~MinimizeTraceSpan();
+
+		MinimizeTraceSpan(const MinimizeTraceSpan&) = delete;
+		MinimizeTraceSpan& operator=(const MinimizeTraceSpan&) = delete;
+
+		/// the trace, or nullptr if the phase is not traced
+		MinimizeTrace* trace(void) const { return this->tr; }
+
+		/// the level of the recursion of the phase
+		unsigned int level(void) const { return this->event.level; }
+
+	private:
+		/// start recording in trace 't'
+		void start(MinimizeTrace* t, MinimizePhase p, size_t size, size_t otherSize);
+
+		MinimizeTrace* tr = nullptr;
+		/// the phase this one is part of, nullptr if it starts a task, and the phase that
+		/// was traced on this thread before
+		MinimizeTraceSpan* parent = nullptr;
+		MinimizeTraceSpan* outer = nullptr;
+		/// the task of the phase (see ProfileContinuation)
+		const void* task = nullptr;
+		MinimizeTrace::Event event;
+		std::chrono::steady_clock::time_point startTime;
+		/// the dominance tests at the start, those of the phases within this one and those
+		/// of the joined tasks at the start, which their own phases count
+		unsigned long long dominanceTests = 0;
+		unsigned long long nestedTests = 0;
+		unsigned long long joinedTests = 0;
+
+		/// the innermost phase traced on this thread
+		static inline thread_local MinimizeTraceSpan* current = nullptr;
+	};
+
+}
+
+#endif
@@ -34,12 +34,39 @@
 
 #include "operations.h"
 #include "calculator.h"
+#include "columns.h"
+#include "join.h"
 #include <string>
 #include <sstream>
 
 using namespace Pareto;
 
 
+/// report the progress message of the operation
+void ParetoCalculatorOperation::announce(ParetoCalculator& c) const {
+	c.verbose(this->message);
+}
+
+/// a comma separated list of the names in lqn
+static std::string listOfNames(const ListOfQuantityNames& lqn) {
+	std::string s;
+	for (ListOfQuantityNames::const_iterator i = lqn.begin(); i != lqn.end(); i++) {
+		if (i != lqn.begin()) s += ", ";
+		s += *i;
+	}
+	return s;
+}
+
+/// a comma separated list of the pairs of names in jm
+static std::string listOfPairs(const JoinMap& jm) {
+	std::string s;
+	for (JoinMap::const_iterator i = jm.begin(); i != jm.end(); i++) {
+		if (i != jm.begin()) s += ", ";
+		s += i->first + "=" + i->second;
+	}
+	return s;
+}
+
 /// POperation_Minimize constructor
 POperation_Minimize::POperation_Minimize() : ParetoCalculatorOperation() {
 }
@@ -49,13 +76,42 @@ void POperation_Minimize::executeOn(ParetoCalculator& c) {
 	c.efficient_minimize();
 }
 
+/// describe the operation
+std::string POperation_Minimize::describe(void) const {
+	return "minimize";
+}
+
 /// POperation_EfficientMinimize constructor
 POperation_EfficientMinimize::POperation_EfficientMinimize() : ParetoCalculatorOperation() {
 }
 
+/// POperation_EfficientMinimize constructor with minimization options
+POperation_EfficientMinimize::POperation_EfficientMinimize(const MinimizeOptions& o) : ParetoCalculatorOperation(), 
+	options(o) {
+}
+
 /// execute the operation represented by the object
 void POperation_EfficientMinimize::executeOn(ParetoCalculator& c) {
-	c.efficient_minimize();
+	c.efficient_minimize(this->options);
+}
+
+/// describe the operation
+std::string POperation_EfficientMinimize::describe(void) const {
+	return "minimize_eff";
+}
+
+/// POperation_SortFilterMinimize constructor
+POperation_SortFilterMinimize::POperation_SortFilterMinimize() : ParetoCalculatorOperation() {
+}
+
+/// execute the operation represented by the object
+void POperation_SortFilterMinimize::executeOn(ParetoCalculator& c) {
+	c.minimize_SFS();
+}
+
+/// describe the operation
+std::string POperation_SortFilterMinimize::describe(void) const {
+	return "minimize_sfs";
 }
 
 /// POperation_Product constructor
@@ -67,6 +123,11 @@ void POperation_Product::executeOn(ParetoCalculator& c) {
 	c.product();
 };
 
+/// describe the operation
+std::string POperation_Product::describe(void) const {
+	return "product";
+}
+
 /// POperation_Push constructor
 POperation_Push::POperation_Push(const std::string& oname) : ParetoCalculatorOperation() {
 	o = oname;
@@ -77,6 +138,11 @@ void POperation_Push::executeOn(ParetoCalculator& c) {
 	c.push(o);
 }
 
+/// describe the operation
+std::string POperation_Push::describe(void) const {
+	return "push " + this->o;
+}
+
 /// POperation_Store constructor
 POperation_Store::POperation_Store(const std::string& oname) : ParetoCalculatorOperation() {
 	o = oname;
@@ -90,6 +156,11 @@ void POperation_Store::executeOn(ParetoCalculator& c) {
 	c.store(nob);
 }
 
+/// describe the operation
+std::string POperation_Store::describe(void) const {
+	return "store " + this->o;
+}
+
 /// POperation_Duplicate constructor
 POperation_Duplicate::POperation_Duplicate() : ParetoCalculatorOperation() {
 }
@@ -99,6 +170,11 @@ void POperation_Duplicate::executeOn(ParetoCalculator& c) {
 	c.duplicate();
 }
 
+/// describe the operation
+std::string POperation_Duplicate::describe(void) const {
+	return "duplicate";
+}
+
 /// POperation_Pop constructor
 POperation_Pop::POperation_Pop() : ParetoCalculatorOperation() {
 }
@@ -108,6 +184,11 @@ void POperation_Pop::executeOn(ParetoCalculator& c) {
 	c.pop();
 }
 
+/// describe the operation
+std::string POperation_Pop::describe(void) const {
+	return "pop";
+}
+
 /// POperation_Print constructor
 POperation_Print::POperation_Print() : ParetoCalculatorOperation() {
 }
@@ -117,6 +198,11 @@ void POperation_Print::executeOn(ParetoCalculator& c) {
 	c.print();
 }
 
+/// describe the operation
+std::string POperation_Print::describe(void) const {
+	return "print";
+}
+
 /// POperation_ProdCons constructor
 POperation_ProdCons::POperation_ProdCons(const std::string& pqname, const std::string& cqname) : ParetoCalculatorOperation(),
 	p_quant(pqname),
@@ -128,6 +214,19 @@ POperation_ProdCons::POperation_ProdCons(const std::string& pqname, const std::s
 /// execute the operation represented by the object
 void POperation_ProdCons::executeOn(ParetoCalculator& c) {
 	ConfigurationSetPtr cs = c.popConfigurationSet();
+	if (cs->isColumnar()) {
+		// test the constraint directly on the real valued columns
+		const QuantityColumn& pc = cs->columns->columns[cs->confspace->indexOfQuantity(this->p_quant)];
+		const QuantityColumn& cc = cs->columns->columns[cs->confspace->indexOfQuantity(this->c_quant)];
+		if (pc.kind != ColumnKind::Real || cc.kind != ColumnKind::Real) {
+			throw EParetoCalculatorError("Producer-consumer constraint requires real valued quantities");
+		}
+		ConfigurationColumnsPtr ncc = ConfigurationColumns::constraint(*cs->columns, [&pc, &cc](const ConfigurationColumns&, size_t r) {
+			return cc.reals[r] <= (1.0 / pc.reals[r]);
+		});
+		c.push(std::make_shared<ConfigurationSet>(ncc, "Constraint"));
+		return;
+	}
 	ConfigurationSetPtr ncs = c.constraint(cs, 
 		[this](const Pareto::Configuration& c) {
 			return POperation_ProdCons::testConstraint(c, this->p_quant, this->c_quant);
@@ -136,6 +235,11 @@ void POperation_ProdCons::executeOn(ParetoCalculator& c) {
 	c.push(ncs);
 }
 
+/// describe the operation
+std::string POperation_ProdCons::describe(void) const {
+	return "prodcons " + this->p_quant + ", " + this->c_quant;
+}
+
 /// evaluate the producer-consumer constraint on the configuration
 bool POperation_ProdCons::testConstraint(const Pareto::Configuration& c, const std::string& p_quant, const std::string& c_quant) {
 	QuantityValue_RealPtr pq = std::dynamic_pointer_cast<QuantityValue_Real>(c.getQuantity(p_quant));
@@ -143,6 +247,11 @@ bool POperation_ProdCons::testConstraint(const Pareto::Configuration& c, const s
 	return cq->value <= (1.0 / pq->value);
 }
 
+/// the producer-consumer constraint as a streaming stage
+StreamStagePtr POperation_ProdCons::streamStage(void) const {
+	return std::make_shared<StreamStage_ProdCons>(this->p_quant, this->c_quant);
+}
+
 /// POperation_Derived constructor
 POperation_Derived::POperation_Derived(const std::string& aqname, const std::string& bqname) : ParetoCalculatorOperation(),
 	a_quant(aqname),
@@ -150,15 +259,19 @@ POperation_Derived::POperation_Derived(const std::string& aqname, const std::str
 {
 }
 
+/// the name of the derived quantity
+std::string POperation_Derived::derivedName(void) const {
+	return this->description() + " of " + this->a_quant + " and " + this->b_quant;
+}
+
 /// execute the operation represented by the object
 void POperation_Derived::executeOn(ParetoCalculator& c) {
 
 	ConfigurationSetPtr cs = c.popConfigurationSet();
+	cs->materialize();
 
 	// define new sum quantity type
-	std::ostringstream sqn;
-	sqn << this->description() << " of " << a_quant << " and " << b_quant;
-	QuantityTypePtr sqt = std::make_shared<QuantityType_Real>(sqn.str());
+	QuantityTypePtr sqt = std::make_shared<QuantityType_Real>(this->derivedName());
 
 	// build new configuration space
 	std::ostringstream sqsn;
@@ -174,23 +287,27 @@ void POperation_Derived::executeOn(ParetoCalculator& c) {
 	ConfigurationSetPtr sconfs = std::make_shared<ConfigurationSet>(scs, sconfsn.str());
 
 	SetOfConfigurations::iterator i;
-	for (i = cs->confs.begin(); i != cs->confs.end(); i++) {
+	for (i = cs->confs().begin(); i != cs->confs().end(); i++) {
 		ConfigurationPtr c = *i;
-		ConfigurationPtr scf = std::make_shared<Configuration>(scs);
-		scf->addQuantitiesOf(c);
+		ConfigurationPtr scf = sconfs->createConfiguration(scs, c);
 
 		double va = (*(std::dynamic_pointer_cast<QuantityValue_RealPtr>(c->getQuantity(a_quant))))->value;
 		double vb = (*(std::dynamic_pointer_cast<QuantityValue_RealPtr>(c->getQuantity(b_quant))))->value;
 
-		QuantityValue_RealPtr sqv = std::make_shared<QuantityValue_Real>(*sqt, this->derive(va, +vb));
+		QuantityValue_RealPtr sqv = allocateInArena<QuantityValue_Real>(sconfs->arena, *sqt, this->derive(va, +vb));
 		scf->addQuantity(sqv);
 		sconfs->addUniqueConfiguration(scf);
 	}
 	c.push(sconfs);
 }
 
+/// describe the operation
+std::string POperation_Derived::describe(void) const {
+	return this->description() + " " + this->a_quant + ", " + this->b_quant;
+}
+
 /// POperation_Agggregate constructor
-POperation_Aggregate::POperation_Aggregate(ListOfQuantityNames& ag_quants, std::string& agname):
+POperation_Aggregate::POperation_Aggregate(const ListOfQuantityNames& ag_quants, const std::string& agname):
 	aggregate_quants(ag_quants),
 	newName(agname)
 {
@@ -201,6 +318,7 @@ void POperation_Aggregate::executeOn(ParetoCalculator& c)
 {
 	// get the configuratoin set to aggregate on
 	ConfigurationSetPtr cs = c.popConfigurationSet();
+	cs->materialize();
 
 	// define new aggregate quantity type
 	QuantityTypePtr sqt = std::make_shared<QuantityType_Real>(this->newName);
@@ -226,12 +344,11 @@ void POperation_Aggregate::executeOn(ParetoCalculator& c)
 
 	// create the new configurations
 	SetOfConfigurations::iterator i;
-	for (i = cs->confs.begin(); i != cs->confs.end(); i++) {
+	for (i = cs->confs().begin(); i != cs->confs().end(); i++) {
 		ConfigurationPtr cf = *i;
 
 		// create new configuration with all values of cf
-		ConfigurationPtr scf = std::make_shared<Configuration>(scs);
-		scf->addQuantitiesOf(cf);
+		ConfigurationPtr scf = sconfs->createConfiguration(scs, cf);
 
 		// compute the aggregated value
 		double sum = 0.0;
@@ -243,7 +360,7 @@ void POperation_Aggregate::executeOn(ParetoCalculator& c)
 
 		}
 		// add the aggregated value to the new configuration
-		QuantityValue_RealPtr sqv = std::make_shared<QuantityValue_Real>(*sqt, sum);
+		QuantityValue_RealPtr sqv = allocateInArena<QuantityValue_Real>(sconfs->arena, *sqt, sum);
 		scf->addQuantity(sqv);
 
 		// add the new configuraiton to the result set
@@ -253,6 +370,16 @@ void POperation_Aggregate::executeOn(ParetoCalculator& c)
 	c.push(sconfs);
 }
 
+/// describe the operation
+std::string POperation_Aggregate::describe(void) const {
+	return "aggregate " + listOfNames(this->aggregate_quants) + " into " + this->newName;
+}
+
+/// the aggregation as a streaming stage
+StreamStagePtr POperation_Aggregate::streamStage(void) const {
+	return std::make_shared<StreamStage_Aggregate>(this->aggregate_quants, this->newName);
+}
+
 
 /// POperation_Sum constructor
 POperation_Sum::POperation_Sum(const std::string& aqname, const std::string& bqname) : POperation_Derived(aqname, bqname) {
@@ -264,7 +391,7 @@ double POperation_Sum::derive(double a, double b) {
 }
 
 // provide a description of the derived operator
-std::string POperation_Sum::description() {
+std::string POperation_Sum::description() const {
 	return "Sum";
 }
 
@@ -279,7 +406,7 @@ double POperation_Max::derive(double a, double b) {
 }
 
 // provide a description of the derived operator
-std::string POperation_Max::description() {
+std::string POperation_Max::description() const {
 	return "Max";
 }
 
@@ -294,7 +421,7 @@ double POperation_Min::derive(double a, double b) {
 }
 
 // provide a description of the derived operator
-std::string POperation_Min::description() {
+std::string POperation_Min::description() const {
 	return "Min";
 }
 
@@ -308,12 +435,12 @@ double POperation_Multiply::derive(double a, double b) {
 }
 
 // provide a description of the derived operator
-std::string POperation_Multiply::description() {
+std::string POperation_Multiply::description() const {
 	return "Multiply";
 }
 
 /// POperation_Abstract constructor
-POperation_Abstract::POperation_Abstract(ListOfQuantityNames& qnames):
+POperation_Abstract::POperation_Abstract(const ListOfQuantityNames& qnames):
 	lqn(qnames)
 {
 }
@@ -330,8 +457,18 @@ void POperation_Abstract::executeOn(ParetoCalculator& c) {
 	}
 }
 
+/// describe the operation
+std::string POperation_Abstract::describe(void) const {
+	return "abstract " + listOfNames(this->lqn);
+}
+
+/// the abstraction as a streaming stage
+StreamStagePtr POperation_Abstract::streamStage(void) const {
+	return std::make_shared<StreamStage_Abstract>(this->lqn);
+}
+
 /// POperation_Hide constructor
-POperation_Hide::POperation_Hide(ListOfQuantityNames& qnames): lqn(qnames) {
+POperation_Hide::POperation_Hide(const ListOfQuantityNames& qnames): lqn(qnames) {
 }
 
 /// execute the operation represented by the object
@@ -341,6 +478,16 @@ void POperation_Hide::executeOn(ParetoCalculator& c) {
 	c.hide(lqn);
 }
 
+/// describe the operation
+std::string POperation_Hide::describe(void) const {
+	return "hide " + listOfNames(this->lqn);
+}
+
+/// the hiding as a streaming stage
+StreamStagePtr POperation_Hide::streamStage(void) const {
+	return std::make_shared<StreamStage_Hide>(this->lqn);
+}
+
 /// POperation_Join constructor
 POperation_Join::POperation_Join(const JoinMap& jqnamemap) :
 	j_quants(jqnamemap)
@@ -363,6 +510,18 @@ bool POperation_Join::testConstraint(const Pareto::Configuration& c, const std::
 	return !diff;
 }
 
+/// the join constraint as a stage on the product of csa and csb
+StreamStagePtr POperation_Join::joinStage(const ConfigurationSet& csa, const ConfigurationSet& csb) const {
+	// get the indices of the quantities to be joined in the product
+	std::vector<int> qan, qbn;
+	JoinMap::const_iterator i;
+	for (i = j_quants.begin(); i != j_quants.end(); i++) {
+		qan.push_back(csa.confspace->indexOfQuantity(i->first));
+		qbn.push_back(csb.confspace->indexOfQuantity(i->second) + (int)csa.confspace->quantities.size());
+	}
+	return std::make_shared<StreamStage_Join>(qan, qbn);
+}
+
 /// execute the operation represented by the object
 void POperation_Join::executeOn(ParetoCalculator& c) {
 	if (c.stack.size() < 2) {
@@ -373,110 +532,25 @@ void POperation_Join::executeOn(ParetoCalculator& c) {
 	ConfigurationSetPtr csa = c.popConfigurationSet();
 	ConfigurationSetPtr csb = c.popConfigurationSet();
 
-	// get the indices of the quantities to be joined
-	std::vector<int> qan, qbn;
-	JoinMap::const_iterator i;
-	for (i = j_quants.begin(); i != j_quants.end(); i++) {
-		qan.push_back(csa->confspace->indexOfQuantity(i->first));
-		qbn.push_back(csb->confspace->indexOfQuantity(i->second) + (int)csa->confspace->quantities.size());
-	}
-
-	// compute the free product first
-	c.push(csb);
-	c.push(csa);
-	c.product();
-
-	// apply the join constraint
-	ConfigurationSetPtr cs = c.popConfigurationSet();
-	ConfigurationSetPtr ncs = c.constraint(cs, 
-		[qan,qbn](const Configuration& c) {
-			return POperation_Join::testConstraint(c, qan, qbn);
-		}
-	);
+	// apply the join constraint to the configurations of the product as they are enumerated
+	ProductPipeline pipeline(csa, csb);
+	pipeline.addStage(this->joinStage(*csa, *csb));
 
 	// push the result on the stack
-	c.push(ncs);
+	c.push(pipeline.run());
 };
 
-/// POperation_EfficientJoin constructor
-POperation_EfficientJoin::POperation_EfficientJoin(JoinMap& jqnamemap): j_quants(jqnamemap) {
+/// describe the operation
+std::string POperation_Join::describe(void) const {
+	return "join " + listOfPairs(this->j_quants);
 }
 
-// execute efficient join operation
-ConfigurationSetPtr recursiveEfficientJoin(ParetoCalculator& c, JoinMap& jqnamemap, ConfigurationSetPtr A, ConfigurationSetPtr B, ConfigurationSpacePtr productspace) {
-	// check if anything needs to be joined
-	// the base case of the recursion
-	if (jqnamemap.size() == 0) {
-		// return the product of A and B
-		return ParetoCalculator::productInSpace(A, B, productspace);
-	}
-	// if either of the configuration sets is empty
-	else if (A->confs.size() == 0 || B->confs.size() == 0) {
-		// return an empty set in the product space
-		ConfigurationSetPtr result = std::make_shared<ConfigurationSet>(productspace, "result");
-		return result;
-	}
-	else {
-		QuantityName qa = jqnamemap.begin()->first;
-		QuantityName qb = jqnamemap.begin()->second;
-		std::shared_ptr<IndexOnConfigurationSet> ia, ib;
-		// check if the quantity to be joined is totally ordered 
-		if (A->confspace->getQuantity(qa)->isTotallyOrdered()) {
-			// make an index on the ordered quantity qa
-			ia = std::make_shared<IndexOnTotalOrderConfigurationSet>(qa, A);
-		}
-		else {
-			// make an index on the unordered quantity qa
-			ia = std::make_shared<IndexOnUnorderedConfigurationSet>(qa, A);
-		}
-		if (B->confspace->getQuantity(qb)->isTotallyOrdered()) {
-			// make an index on the ordered quantity qb
-			ib = std::make_shared<IndexOnTotalOrderConfigurationSet>(qb, B);
-		}
-		else {
-			// make an index on the unordered quantity qb
-			ib = std::make_shared<IndexOnUnorderedConfigurationSet>(qb, B);
-		}
-
-		// create a copy of the joinmap, excluding the first pair (which is handled in this call)
-		JoinMap newnamemap;
-		JoinMap::iterator i = jqnamemap.begin();
-		i++;
-		for (; i != jqnamemap.end(); i++) {
-			newnamemap[i->first] = i->second;
-		}
+/// POperation_EfficientJoin constructor
+POperation_EfficientJoin::POperation_EfficientJoin(const JoinMap& jqnamemap): j_quants(jqnamemap) {
+}
 
-		// create the result configuraiton set
-		ConfigurationSetPtr result = std::make_shared<ConfigurationSet>(productspace, "result");
-
-		// until all configurations in index ia have been covered...
-		unsigned int j = 0;
-		while (j < ia->confset->confs.size()) {
-			int l_x, u_x, v_x, w_x;
-			// get the value v (refered to by x) for index ia on position j
-			std::shared_ptr<ConfigurationIndexReference> x = ia->get(j);
-			
-			// determine the ranges [l_x,u_x] and [v_x,w_x] in indices ia and ib, respectively, for which the value is equal to v
-			l_x = ia->lower(*x);
-			u_x = ia->upper(*x);
-			v_x = ib->lower(*x);
-			w_x = ib->upper(*x);
-
-			// copy the configurations from both sets in which the value to be joined is equal to v
-			ConfigurationSetPtr Asub = ia->copyFromTo(l_x, u_x);
-			ConfigurationSetPtr Bsub = ib->copyFromTo(v_x, w_x);
-
-			// recursively join the remaining join pairs in newnamemap
-			ConfigurationSetPtr temp = recursiveEfficientJoin(c, newnamemap, Asub, Bsub, productspace);
-
-			// add the result to the result set
-			result->addUniqueConfigurationsOf(temp);
-
-			// continue with the first index with a value different from v
-			j = u_x + 1;
-		}
-		return result;
-	}
+/// POperation_EfficientJoin constructor with join options
+POperation_EfficientJoin::POperation_EfficientJoin(const JoinMap& jqnamemap, const JoinOptions& o): j_quants(jqnamemap), options(o) {
 }
 
 /// execute the operation represented by the object
@@ -486,12 +560,18 @@ void POperation_EfficientJoin::executeOn(ParetoCalculator& c) {
 	ConfigurationSetPtr csb = c.popConfigurationSet();
 	// create the resulting configuraiton space
 	ConfigurationSpacePtr productspace = csa->confspace->productWith(csb->confspace);
-	// compute the join operation recursively
-	ConfigurationSetPtr result = recursiveEfficientJoin(c, this->j_quants, csa, csb, productspace);
+	// compute the join operation with a hash join
+	HashJoin join(csa, csb, this->j_quants, productspace);
+	ConfigurationSetPtr result = join.join(this->options);
 	// push the result on the stack
 	c.push(result);
 };
 
+/// describe the operation
+std::string POperation_EfficientJoin::describe(void) const {
+	return "join_eff " + listOfPairs(this->j_quants);
+}
+
 
 /// POperation_EfficientProdCons constructor
 POperation_EfficientProdCons::POperation_EfficientProdCons(const std::string& pqname, const std::string& cqname) : 
@@ -551,7 +631,7 @@ void POperation_EfficientProdCons::executeOn(ParetoCalculator& c) {
 		// check if the current pair (i,j) of configurations match the producer-consumer constraint
 		if (default_match(*(ip.at(j)->value()), *(ic.at(i)->value()))) {
 			// they match, so create a resulting configuration
-			ConfigurationPtr c = std::make_shared<Configuration>(nspace);
+			ConfigurationPtr c = ns->createConfiguration();
 			c->addQuantitiesOf(ic.at(i)->conf);
 			c->addQuantitiesOf(ip.at(j)->conf);
 			// and add it to the result set
@@ -568,7 +648,7 @@ void POperation_EfficientProdCons::executeOn(ParetoCalculator& c) {
 				// because (i-1, j+1) is matching
 				for (unsigned int k = 0; k < i; k++) {
 					// make a configuration for the pair (k,j)
-					ConfigurationPtr c = std::make_shared<Configuration>(nspace);
+					ConfigurationPtr c = ns->createConfiguration();
 					c->addQuantitiesOf(ic.at(k)->conf);
 					c->addQuantitiesOf(ip.at(j)->conf);
 					// add the configuration to the result set
@@ -593,7 +673,7 @@ void POperation_EfficientProdCons::executeOn(ParetoCalculator& c) {
 			// for all consuming configurations k
 			for (unsigned int k = 0; k < ic.size(); k++) {
 				// create resulting configuration (k,l)
-				ConfigurationPtr c = std::make_shared<Configuration>(nspace);
+				ConfigurationPtr c = ns->createConfiguration();
 				c->addQuantitiesOf(ic.at(k)->conf);
 				c->addQuantitiesOf(ip.at(l)->conf);
 				// add it to the result set
@@ -604,3 +684,153 @@ void POperation_EfficientProdCons::executeOn(ParetoCalculator& c) {
 	// push the result to the stack
 	c.push(ns);
 }
+
+/// describe the operation
+std::string POperation_EfficientProdCons::describe(void) const {
+	return "prodcons_eff " + this->p_quant + ", " + this->c_quant;
+}
+
+
+/// POperation_ProductPipeline constructor
+POperation_ProductPipeline::POperation_ProductPipeline(ParetoCalculatorOperationPtr src) :
+	source(src)
+{
+}
+
+/// report the progress messages of all fused operations
+void POperation_ProductPipeline::announce(ParetoCalculator& c) const {
+	this->source->announce(c);
+	for (ListOfOperations::const_iterator i = this->stages.begin(); i != this->stages.end(); i++) {
+		(*i)->announce(c);
+	}
+	if (this->minimization) {
+		this->minimization->announce(c);
+	}
+}
+
+/// execute the operation represented by the object
+void POperation_ProductPipeline::executeOn(ParetoCalculator& c) {
+	if (c.stack.size() < 2) {
+		throw EParetoCalculatorError("Not enough configuration sets on stack to perform product.");
+	}
+
+	// pop the configuration sets of the product in the order of ParetoCalculator::product
+	ConfigurationSetPtr csa = c.popConfigurationSet();
+	ConfigurationSetPtr csb = c.popConfigurationSet();
+
+	ProductPipeline pipeline(csa, csb);
+	std::shared_ptr<POperation_Join> join = std::dynamic_pointer_cast<POperation_Join>(this->source);
+	if (join) {
+		pipeline.addStage(join->joinStage(*csa, *csb));
+	}
+	for (ListOfOperations::const_iterator i = this->stages.begin(); i != this->stages.end(); i++) {
+		pipeline.addStage((*i)->streamStage());
+	}
+
+	// minimize the blocks with the minimization operation on the stack of the calculator
+	if (this->minimization) {
+		ParetoCalculatorOperationPtr m = this->minimization;
+		pipeline.setMinimization([&c, m](ConfigurationSetPtr cs) {
+			c.push(cs);
+			m->executeOn(c);
+			return c.popConfigurationSet();
+		});
+	}
+
+	// push the result on the stack
+	c.push(pipeline.run());
+}
+
+/// fuse products and joins with the streamable operations and minimization following them
+ListOfOperations POperation_ProductPipeline::fuse(const ListOfOperations& ops) {
+	ListOfOperations res;
+	size_t k = 0;
+	while (k < ops.size()) {
+		ParetoCalculatorOperationPtr op = ops[k];
+		k++;
+		if (std::dynamic_pointer_cast<POperation_Product>(op) && k < ops.size()) {
+			// product, aggregation, optional abstraction and minimization
+			std::shared_ptr<POperation_Aggregate> ag = std::dynamic_pointer_cast<POperation_Aggregate>(ops[k]);
+			size_t m = k + 1;
+			std::shared_ptr<POperation_Abstract> ab;
+			if (ag && m < ops.size()) {
+				ab = std::dynamic_pointer_cast<POperation_Abstract>(ops[m]);
+				if (ab) m++;
+			}
+			if (ag && m < ops.size() && ops[m]->isMinimization()) {
+				std::shared_ptr<POperation_ProductAggregateMinimize> pam = std::make_shared<POperation_ProductAggregateMinimize>(
+					ag->aggregate_quants, ag->newName, ab ? ab->lqn : ListOfQuantityNames());
+				for (size_t n = k - 1; n <= m; n++) {
+					pam->messages.push_back(ops[n]->message);
+				}
+				res.push_back(pam);
+				k = m + 1;
+				continue;
+			}
+		}
+		if (std::dynamic_pointer_cast<POperation_Product>(op) || std::dynamic_pointer_cast<POperation_Join>(op)) {
+			std::shared_ptr<POperation_ProductPipeline> pipeline = std::make_shared<POperation_ProductPipeline>(op);
+			size_t m = k;
+			while (m < ops.size() && ops[m]->streamStage()) {
+				pipeline->stages.push_back(ops[m]);
+				m++;
+			}
+			if (m < ops.size() && ops[m]->isMinimization()) {
+				pipeline->minimization = ops[m];
+				m++;
+			}
+			// a product that is not followed by anything to fuse is kept as it is
+			if (m > k) {
+				op = pipeline;
+				k = m;
+			}
+		}
+		res.push_back(op);
+	}
+	return res;
+}
+
+
+/// POperation_ProductAggregateMinimize constructor
+POperation_ProductAggregateMinimize::POperation_ProductAggregateMinimize(const ListOfQuantityNames& ag_quants, const std::string& agname, const ListOfQuantityNames& qnames) :
+	aggregate_quants(ag_quants),
+	newName(agname),
+	lqn(qnames)
+{
+}
+
+/// report the progress messages of the replaced operations, or the message of the operation
+void POperation_ProductAggregateMinimize::announce(ParetoCalculator& c) const {
+	if (this->messages.empty()) {
+		ParetoCalculatorOperation::announce(c);
+		return;
+	}
+	for (std::vector<std::string>::const_iterator i = this->messages.begin(); i != this->messages.end(); i++) {
+		c.verbose(*i);
+	}
+}
+
+/// execute the operation represented by the object
+void POperation_ProductAggregateMinimize::executeOn(ParetoCalculator& c) {
+	if (c.stack.size() < 2) {
+		throw EParetoCalculatorError("Not enough configuration sets on stack to perform product.");
+	}
+
+	// pop the configuration sets of the product in the order of ParetoCalculator::product
+	ConfigurationSetPtr csa = c.popConfigurationSet();
+	ConfigurationSetPtr csb = c.popConfigurationSet();
+
+	ProductFront front(csa, csb);
+	front.addStage(std::make_shared<StreamStage_Aggregate>(this->aggregate_quants, this->newName));
+	if (!this->lqn.empty()) {
+		front.addStage(std::make_shared<StreamStage_Abstract>(this->lqn));
+	}
+
+	// push the result on the stack
+	c.push(front.run());
+}
+
+/// describe the operation
+std::string POperation_ProductAggregateMinimize::describe(void) const {
+	return "product_aggregate_min " + listOfNames(this->aggregate_quants) + " into " + this->newName + " abstract " + listOfNames(this->lqn);
+}
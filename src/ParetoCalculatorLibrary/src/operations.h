@@ -41,6 +41,8 @@
 #include "support.h"
 #include "storage.h"
 #include "configuration.h"
+#include "minimizeoptions.h"
+#include "pipeline.h"
 
 
 namespace Pareto {
@@ -50,22 +52,65 @@ namespace Pareto {
 	/// An operation to be executed on a Pareto Calculator
 	class ParetoCalculatorOperation {
 	public:		
+		virtual ~ParetoCalculatorOperation() {};
+
+		/// the progress message of the operation
+		std::string message;
+
 		/// executes the operation on calculator 'c'
 		virtual void executeOn(ParetoCalculator& c) = 0;
+
+		/// reports the progress message of the operation to calculator 'c'
+		virtual void announce(ParetoCalculator& c) const;
+
+		/// returns the operation as a stage of a streaming pipeline, or nullptr if the
+		/// operation cannot be applied to configurations one at a time
+		virtual StreamStagePtr streamStage(void) const { return nullptr; }
+
+		/// true if the operation minimizes the set of configurations on top of the stack
+		virtual bool isMinimization(void) const { return false; }
+
+		/// the number of objects the operation pops from the stack
+		virtual unsigned int arity(void) const { return 1; }
+
+		/// a description of the operation and its parameters. Operations with the same non-empty
+		/// description compute the same result from the same arguments (see OperationPlan).
+		virtual std::string describe(void) const { return ""; }
 	};
 
+	using ParetoCalculatorOperationPtr = std::shared_ptr<ParetoCalculatorOperation>;
+
+	/// A sequence of operations
+	class ListOfOperations : public std::vector<ParetoCalculatorOperationPtr> {};
+
 	/// The block-based minimization operator
 	class POperation_Minimize: public ParetoCalculatorOperation {
 	public:
 		POperation_Minimize(void);
 		virtual void executeOn(ParetoCalculator& c);
+		virtual std::string describe(void) const;
+		virtual bool isMinimization(void) const { return true; }
 	};
 
 	/// The generalized multidimansional Dividide-and-Conquer minimization operator
 	class POperation_EfficientMinimize: public ParetoCalculatorOperation {
 	public:
+		/// the settings of the minimization
+		MinimizeOptions options;
 		POperation_EfficientMinimize(void);
+		POperation_EfficientMinimize(const MinimizeOptions& o);
 		virtual void executeOn(ParetoCalculator& c);
+		virtual std::string describe(void) const;
+		virtual bool isMinimization(void) const { return true; }
+	};
+
+	/// The sort-filter-skyline minimization operator
+	class POperation_SortFilterMinimize: public ParetoCalculatorOperation {
+	public:
+		POperation_SortFilterMinimize(void);
+		virtual void executeOn(ParetoCalculator& c);
+		virtual std::string describe(void) const;
+		virtual bool isMinimization(void) const { return true; }
 	};
 
 	/// The product operator
@@ -73,6 +118,8 @@ namespace Pareto {
 	public:
 		POperation_Product(void);
 		virtual void executeOn(ParetoCalculator& c);
+		virtual unsigned int arity(void) const { return 2; }
+		virtual std::string describe(void) const;
 	};
 
 	/// A push operation to push a named element from the memory onto the stack
@@ -81,22 +128,27 @@ namespace Pareto {
 		std::string o;
 		POperation_Push(const std::string& oname);
 		virtual void executeOn(ParetoCalculator& c);
+		virtual std::string describe(void) const;
 	};
 
 	/// The abstraction operator
 	class POperation_Abstract: public ParetoCalculatorOperation {
 	public:
-		ListOfQuantityNames& lqn;
-		POperation_Abstract(ListOfQuantityNames& qnames);
+		ListOfQuantityNames lqn;
+		POperation_Abstract(const ListOfQuantityNames& qnames);
 		virtual void executeOn(ParetoCalculator& c);
+		virtual std::string describe(void) const;
+		virtual StreamStagePtr streamStage(void) const;
 	};
 
 	/// The hiding operator
 	class POperation_Hide: public ParetoCalculatorOperation {
 	public:
-		ListOfQuantityNames& lqn;
-		POperation_Hide(ListOfQuantityNames& qnames);
+		ListOfQuantityNames lqn;
+		POperation_Hide(const ListOfQuantityNames& qnames);
 		virtual void executeOn(ParetoCalculator& c);
+		virtual std::string describe(void) const;
+		virtual StreamStagePtr streamStage(void) const;
 	};
 
 	/// A store operation pops an object from the stack and stores it in the 
@@ -106,6 +158,7 @@ namespace Pareto {
 		std::string o;
 		POperation_Store(const std::string& oname);
 		virtual void executeOn(ParetoCalculator& c);
+		virtual std::string describe(void) const;
 	};
 
 	/// Pops an element from the calculator stack
@@ -113,6 +166,7 @@ namespace Pareto {
 	public:
 		POperation_Pop(void);
 		virtual void executeOn(ParetoCalculator& c);
+		virtual std::string describe(void) const;
 	};
 
 	/// Duplicates the object on top of the stack
@@ -120,6 +174,7 @@ namespace Pareto {
 	public:
 		POperation_Duplicate(void);
 		virtual void executeOn(ParetoCalculator& c);
+		virtual std::string describe(void) const;
 	};
 
 	/// pops an object from the stack and prints it if the caalculator
@@ -128,6 +183,7 @@ namespace Pareto {
 	public:
 		POperation_Print(void);
 		virtual void executeOn(ParetoCalculator& c);
+		virtual std::string describe(void) const;
 	};
 
 	/// The (naive implementation of) producer-consumer constraint operation between two quantities.
@@ -137,6 +193,8 @@ namespace Pareto {
 		POperation_ProdCons(const std::string& pqname, const std::string& cqname);
 		static bool testConstraint(const Configuration& c, const std::string& p_quant, const std::string& c_quant);
 		virtual void executeOn(ParetoCalculator& c);
+		virtual std::string describe(void) const;
+		virtual StreamStagePtr streamStage(void) const;
 	};
 
 	/// An efficient implementation of a producer-concumer constraint operation. Dimensions 
@@ -146,6 +204,8 @@ namespace Pareto {
 		std::string p_quant, c_quant;
 		POperation_EfficientProdCons(const std::string& pqname, const std::string& cqname);
 		virtual void executeOn(ParetoCalculator& c);
+		virtual unsigned int arity(void) const { return 2; }
+		virtual std::string describe(void) const;
 		bool default_match(const QuantityValue& va, const QuantityValue& vb) const;
 	};
 
@@ -153,11 +213,14 @@ namespace Pareto {
 	class POperation_Derived: public ParetoCalculatorOperation {
 	public:
 		POperation_Derived(const std::string& aqname, const std::string& bqname);
+		/// the name of the derived quantity
+		std::string derivedName(void) const;
 		virtual void executeOn(ParetoCalculator& c);
+		virtual std::string describe(void) const;
 	private:
 		std::string a_quant, b_quant;
 		virtual double derive(double a, double b) = 0;
-		virtual std::string description() = 0;
+		virtual std::string description() const = 0;
 	};
 
 	/// Operation for computing derived quantity: sum of two quantities
@@ -166,7 +229,7 @@ namespace Pareto {
 		POperation_Sum(const std::string& aqname, const std::string& bqname);
 	private:
 		virtual double derive(double a, double b);
-		virtual std::string description();
+		virtual std::string description() const;
 	};
 
 	/// Operation for computing derived quantity: max of two quantities
@@ -175,7 +238,7 @@ namespace Pareto {
 		POperation_Max(const std::string& aqname, const std::string& bqname);
 	private:
 		virtual double derive(double a, double b);
-		virtual std::string description();
+		virtual std::string description() const;
 	};
 
 	/// Operation for computing derived quantity: min of two quantities
@@ -184,7 +247,7 @@ namespace Pareto {
 		POperation_Min(const std::string& aqname, const std::string& bqname);
 	private:
 		virtual double derive(double a, double b);
-		virtual std::string description();
+		virtual std::string description() const;
 	};
 
 	/// Operation for computing derived quantity: product of two quantities
@@ -193,44 +256,94 @@ namespace Pareto {
 		POperation_Multiply(const std::string& aqname, const std::string& bqname);
 	private:
 		virtual double derive(double a, double b);
-		virtual std::string description();
+		virtual std::string description() const;
 	};
 
 	/// Operation for computing the aggregation (sum) of all quantities given in
 	/// a list of quantity names
 	class POperation_Aggregate: public ParetoCalculatorOperation {
 	public:
-		POperation_Aggregate(ListOfQuantityNames& ag_quants, std::string& agname);
-		virtual void executeOn(ParetoCalculator& c);
-	private:
-		ListOfQuantityNames& aggregate_quants;
+		ListOfQuantityNames aggregate_quants;
 		std::string newName;
+		POperation_Aggregate(const ListOfQuantityNames& ag_quants, const std::string& agname);
+		virtual void executeOn(ParetoCalculator& c);
+		virtual std::string describe(void) const;
+		virtual StreamStagePtr streamStage(void) const;
 	};
 
 	/// An STL map from strings to string expressing how two configuration
 	/// are going to be joined in teh join operation
 	class JoinMap : public StringMap{};
 
-	/// The (naive) join operation. First constructs the entire product, then selects.
-	/// Consider using EfficientJoin
+	/// The (naive) join operation. Tests every configuration of the product, which is
+	/// enumerated lazily (see LazyProduct) rather than constructed. Consider using EfficientJoin
 	class POperation_Join: public ParetoCalculatorOperation {
 	public:
-		const JoinMap& j_quants;
+		JoinMap j_quants;
 		POperation_Join(const JoinMap& jqnamemap);
 		static bool testConstraint(const Configuration& c, const std::vector<int>& qan, const std::vector<int>& qbn);
+		/// the join constraint as a stage on the product of 'csa' and 'csb'
+		StreamStagePtr joinStage(const ConfigurationSet& csa, const ConfigurationSet& csb) const;
 		virtual void executeOn(ParetoCalculator& c);
+		virtual unsigned int arity(void) const { return 2; }
+		virtual std::string describe(void) const;
 	};
 
-	/// An efficient sort-merge join operation. Works with an arbitrary number of totally ordered or
-	/// unorderedquantities
-	/// 
-	/// The operation will be extended to multiple quantities and non-totally-ordered quantities 
-	/// in future versions. For now consider using the naive join operation...
+	/// An efficient hash join operation (see HashJoin). Works with an arbitrary number of totally
+	/// ordered or unordered quantities and never constructs the entire product. The join is
+	/// sequential unless the options request a parallel join.
 	class POperation_EfficientJoin: public ParetoCalculatorOperation {
 	public:
-		JoinMap& j_quants;
-		POperation_EfficientJoin(JoinMap& jqnamemap);
+		JoinMap j_quants;
+		JoinOptions options;
+		POperation_EfficientJoin(const JoinMap& jqnamemap);
+		POperation_EfficientJoin(const JoinMap& jqnamemap, const JoinOptions& o);
+		virtual void executeOn(ParetoCalculator& c);
+		virtual unsigned int arity(void) const { return 2; }
+		virtual std::string describe(void) const;
+	};
+
+	/// A product or (naive) join, followed by constraints, abstractions and hiding and
+	/// optionally by a minimization, fused into a single streaming pipeline (see ProductPipeline).
+	/// The product is never constructed; the minimization is applied to blocks of the
+	/// configurations that pass the stages.
+	class POperation_ProductPipeline: public ParetoCalculatorOperation {
+	public:
+		/// the product or join operation
+		ParetoCalculatorOperationPtr source;
+		/// the operations that are applied as streaming stages
+		ListOfOperations stages;
+		/// the minimization, or nullptr
+		ParetoCalculatorOperationPtr minimization;
+
+		POperation_ProductPipeline(ParetoCalculatorOperationPtr src);
+		virtual void executeOn(ParetoCalculator& c);
+		virtual unsigned int arity(void) const { return 2; }
+		virtual void announce(ParetoCalculator& c) const;
+
+		/// returns the operations 'ops' in which every product that is followed by an aggregation,
+		/// an optional abstraction and a minimization is fused into a POperation_ProductAggregateMinimize,
+		/// and every other product or join that is followed by streamable operations or a
+		/// minimization is fused with them into a pipeline
+		static ListOfOperations fuse(const ListOfOperations& ops);
+	};
+
+	/// A product followed by an aggregation, an abstraction and a minimization, computed with
+	/// an incremental Pareto front (see ProductFront). The product is never constructed and
+	/// configurations are pruned with bounds from the sorted input sets.
+	class POperation_ProductAggregateMinimize: public ParetoCalculatorOperation {
+	public:
+		ListOfQuantityNames aggregate_quants;
+		std::string newName;
+		/// the quantities abstracted after the aggregation
+		ListOfQuantityNames lqn;
+		/// the progress messages of the operations it replaces, if any
+		std::vector<std::string> messages;
+		POperation_ProductAggregateMinimize(const ListOfQuantityNames& ag_quants, const std::string& agname, const ListOfQuantityNames& qnames);
 		virtual void executeOn(ParetoCalculator& c);
+		virtual unsigned int arity(void) const { return 2; }
+		virtual std::string describe(void) const;
+		virtual void announce(ParetoCalculator& c) const;
 	};
 
 }
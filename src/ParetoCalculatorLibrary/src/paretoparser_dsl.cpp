@@ -0,0 +1,494 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// A native parser of the textual Pareto specification language (see the dsl folder),
+// which loads .pareto files without converting them to XML
+//
+
+#include "paretoparser_dsl.h"
+#include "calculator.h"
+#include "columns.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using namespace Pareto;
+
+/// the keywords of the language, which cannot be used as names
+static const char* const dslKeywords[] = {
+	"pareto", "specification", "description", "quantity", "types", "real", "int", "ordered",
+	"unordered", "configuration", "spaces", "sets", "in", "as", "calculation", "push", "product",
+	"prodcons", "prod", "cons", "abstract", "from", "hide", "minimize", "store", "join", "with",
+	"aggregate", "duplicate", "print"
+};
+
+static bool isKeywordText(const char* b, const char* e) {
+	size_t n = (size_t)(e - b);
+	for (const char* kw : dslKeywords) {
+		if (std::strlen(kw) == n && std::strncmp(kw, b, n) == 0) return true;
+	}
+	return false;
+}
+
+static bool isIdentifierChar(char c) {
+	return std::isalnum((unsigned char)c) || c == '_';
+}
+
+static bool isDigit(char c) {
+	return std::isdigit((unsigned char)c) != 0;
+}
+
+
+ParetoDSLParser::ParetoDSLParser(ParetoCalculator& forPC) : pc(forPC)
+{
+}
+
+void ParetoDSLParser::LoadFile(const std::string& f) {
+	std::ifstream ifs(f, std::ios::in | std::ios::binary);
+	if (!ifs) {
+		throw EParetoCalculatorError("Cannot open specification file " + f);
+	}
+	std::ostringstream text;
+	text << ifs.rdbuf();
+	this->Load(text.str(), f);
+}
+
+void ParetoDSLParser::Load(const std::string& text, const std::string& src) {
+	this->source = src;
+	this->pos = text.data();
+	this->end = text.data() + text.size();
+	this->line = 1;
+	this->operations.clear();
+	this->tok = this->scan();
+	this->next = this->scan();
+
+	// header
+	this->expectKeyword("pareto");
+	this->expectKeyword("specification");
+	this->name = this->expectIdentifier();
+	this->expectKeyword("description");
+	if (this->tok.kind != TokenKind::Block) {
+		this->error(this->tok, "description between '<' and '>' expected");
+	}
+	this->advance();
+
+	// the sections, of which the entries all start with a name
+	this->expectKeyword("quantity");
+	this->expectKeyword("types");
+	while (this->tok.kind == TokenKind::Identifier) {
+		this->parseQuantityType();
+	}
+	this->expectKeyword("configuration");
+	this->expectKeyword("spaces");
+	while (this->tok.kind == TokenKind::Identifier) {
+		this->parseConfigurationSpace();
+	}
+	this->expectKeyword("configuration");
+	this->expectKeyword("sets");
+	while (this->tok.kind == TokenKind::Identifier) {
+		this->parseConfigurationSet();
+	}
+	this->expectKeyword("calculation");
+	do {
+		this->parseOperation();
+	} while (this->tok.kind != TokenKind::End);
+
+	this->pos = this->end = nullptr;
+}
+
+
+ParetoDSLParser::Token ParetoDSLParser::scan(void) {
+	// skip white space and comments
+	while (this->pos != this->end) {
+		char c = *this->pos;
+		if (c == '\n') {
+			this->line++;
+			this->pos++;
+		}
+		else if (std::isspace((unsigned char)c)) {
+			this->pos++;
+		}
+		else if (c == '/' && this->pos + 1 != this->end && this->pos[1] == '/') {
+			while (this->pos != this->end && *this->pos != '\n') this->pos++;
+		}
+		else if (c == '/' && this->pos + 1 != this->end && this->pos[1] == '*') {
+			Token t;
+			t.line = this->line;
+			this->pos += 2;
+			while (this->pos != this->end && !(*this->pos == '*' && this->pos + 1 != this->end && this->pos[1] == '/')) {
+				if (*this->pos == '\n') this->line++;
+				this->pos++;
+			}
+			if (this->pos == this->end) {
+				this->error(t, "unterminated comment");
+			}
+			this->pos += 2;
+		}
+		else {
+			break;
+		}
+	}
+
+	Token t;
+	t.line = this->line;
+	t.b = this->pos;
+	if (this->pos == this->end) {
+		t.e = this->pos;
+		return t;
+	}
+
+	char c = *this->pos;
+	if (std::isalpha((unsigned char)c) || c == '_' || c == '^') {
+		// a name or keyword, a name can be escaped with '^'
+		bool escaped = (c == '^');
+		if (escaped) t.b = ++this->pos;
+		while (this->pos != this->end && isIdentifierChar(*this->pos)) this->pos++;
+		if (t.b == this->pos) {
+			this->error(t, "name expected after '^'");
+		}
+		t.kind = (!escaped && isKeywordText(t.b, this->pos)) ? TokenKind::Keyword : TokenKind::Identifier;
+	}
+	else if (isDigit(c) || ((c == '-' || c == '+') && this->pos + 1 != this->end && isDigit(this->pos[1]))) {
+		// a number: sign, digits, fraction and exponent
+		this->pos++;
+		while (this->pos != this->end && isDigit(*this->pos)) this->pos++;
+		if (this->pos + 1 < this->end && *this->pos == '.' && isDigit(this->pos[1])) {
+			this->pos++;
+			while (this->pos != this->end && isDigit(*this->pos)) this->pos++;
+		}
+		if (this->pos != this->end && (*this->pos == 'e' || *this->pos == 'E')) {
+			const char* x = this->pos + 1;
+			if (x != this->end && (*x == '-' || *x == '+')) x++;
+			if (x != this->end && isDigit(*x)) {
+				this->pos = x;
+				while (this->pos != this->end && isDigit(*this->pos)) this->pos++;
+			}
+		}
+		t.kind = TokenKind::Number;
+	}
+	else if (c == '<') {
+		// a text block up to the first '>'
+		while (this->pos != this->end && *this->pos != '>') {
+			if (*this->pos == '\n') this->line++;
+			this->pos++;
+		}
+		if (this->pos == this->end) {
+			this->error(t, "unterminated description, '>' expected");
+		}
+		this->pos++;
+		t.kind = TokenKind::Block;
+	}
+	else if (std::strchr(":,()[]{}=", c) != nullptr) {
+		this->pos++;
+		t.kind = TokenKind::Symbol;
+	}
+	else {
+		this->error(t, std::string("unexpected character '") + c + "'");
+	}
+	t.e = this->pos;
+	return t;
+}
+
+void ParetoDSLParser::advance(void) {
+	this->tok = this->next;
+	this->next = this->scan();
+}
+
+bool ParetoDSLParser::isKeyword(const Token& t, const char* kw) const {
+	size_t n = (size_t)(t.e - t.b);
+	return t.kind == TokenKind::Keyword && std::strlen(kw) == n && std::strncmp(kw, t.b, n) == 0;
+}
+
+bool ParetoDSLParser::isSymbol(const Token& t, char c) const {
+	return t.kind == TokenKind::Symbol && *t.b == c;
+}
+
+bool ParetoDSLParser::acceptKeyword(const char* kw) {
+	if (!this->isKeyword(this->tok, kw)) return false;
+	this->advance();
+	return true;
+}
+
+bool ParetoDSLParser::acceptSymbol(char c) {
+	if (!this->isSymbol(this->tok, c)) return false;
+	this->advance();
+	return true;
+}
+
+void ParetoDSLParser::expectKeyword(const char* kw) {
+	if (!this->acceptKeyword(kw)) {
+		this->error(this->tok, std::string("'") + kw + "' expected");
+	}
+}
+
+void ParetoDSLParser::expectSymbol(char c) {
+	if (!this->acceptSymbol(c)) {
+		this->error(this->tok, std::string("'") + c + "' expected");
+	}
+}
+
+std::string ParetoDSLParser::expectIdentifier(void) {
+	if (this->tok.kind != TokenKind::Identifier) {
+		this->error(this->tok, "name expected");
+	}
+	std::string n(this->tok.b, this->tok.e);
+	this->advance();
+	return n;
+}
+
+StorableObjectPtr ParetoDSLParser::lookup(const Token& t) {
+	std::string n(t.b, t.e);
+	StorageMap::iterator i = this->pc.memory.find(n);
+	if (i == this->pc.memory.end()) {
+		this->error(t, "unknown name " + n);
+	}
+	return i->second;
+}
+
+void ParetoDSLParser::error(const Token& t, const std::string& msg) const {
+	std::string found;
+	if (t.b != nullptr && t.b == this->end) {
+		found = " at end of file";
+	}
+	else if (t.e != nullptr && t.e > t.b) {
+		found = " at '" + std::string(t.b, std::min(t.e, t.b + 40)) + "'";
+	}
+	throw EParetoCalculatorError(this->source + ":" + std::to_string(t.line) + ": " + msg + found);
+}
+
+
+/// parse 'name : real | int | ordered [v, ...] | unordered [v, ...]'
+void ParetoDSLParser::parseQuantityType(void) {
+	std::string qtname = this->expectIdentifier();
+	this->expectSymbol(':');
+	std::shared_ptr<QuantityType> qt;
+	if (this->acceptKeyword("real")) {
+		qt = std::make_shared<QuantityType_Real>(qtname);
+	}
+	else if (this->acceptKeyword("int")) {
+		qt = std::make_shared<QuantityType_Integer>(qtname);
+	}
+	else if (this->isKeyword(this->tok, "ordered") || this->isKeyword(this->tok, "unordered")) {
+		bool ordered = this->isKeyword(this->tok, "ordered");
+		this->advance();
+		std::shared_ptr<QuantityType_Enum> qte;
+		if (ordered)
+			qte = std::make_shared<QuantityType_Enum>(qtname);
+		else
+			qte = std::make_shared<QuantityType_Enum_Unordered>(qtname);
+		this->expectSymbol('[');
+		do {
+			qte->addQuantity(this->expectIdentifier());
+		} while (this->acceptSymbol(','));
+		this->expectSymbol(']');
+		qt = qte;
+	}
+	else {
+		this->error(this->tok, "quantity type real, int, ordered or unordered expected");
+	}
+	this->pc.store(qt);
+}
+
+/// parse 'name : quantity [as name] ...'
+void ParetoDSLParser::parseConfigurationSpace(void) {
+	ConfigurationSpacePtr cs = std::make_shared<ConfigurationSpace>(this->expectIdentifier());
+	this->expectSymbol(':');
+	do {
+		Token t = this->tok;
+		this->expectIdentifier();
+		QuantityTypePtr qt = std::dynamic_pointer_cast<const QuantityType>(this->lookup(t));
+		if (!qt) {
+			this->error(t, "quantity type expected");
+		}
+		if (this->acceptKeyword("as")) {
+			cs->addQuantityAs(qt, this->expectIdentifier());
+		}
+		else {
+			cs->addQuantityAs(qt, qt->name);
+		}
+		// the next entry is a quantity unless it starts the next space
+	} while (this->tok.kind == TokenKind::Identifier && !this->isSymbol(this->next, ':'));
+	this->pc.store(cs);
+}
+
+/// parse 'name in space = { (value, ...), ... }'
+void ParetoDSLParser::parseConfigurationSet(void) {
+	std::string csname = this->expectIdentifier();
+	this->expectKeyword("in");
+	Token t = this->tok;
+	this->expectIdentifier();
+	ConfigurationSpacePtr sp = std::dynamic_pointer_cast<ConfigurationSpace>(this->lookup(t));
+	if (!sp) {
+		this->error(t, "configuration space expected");
+	}
+	this->expectSymbol('=');
+	this->expectSymbol('{');
+
+	// fill the columns of the set and sort them once, instead of inserting every configuration
+	ConfigurationColumnsPtr cc = std::make_shared<ConfigurationColumns>(sp);
+	QuantityValueParser values(sp);
+	size_t rows = 0;
+	do {
+		this->parseConfiguration(*cc, values, csname);
+		rows++;
+	} while (this->acceptSymbol(','));
+	this->expectSymbol('}');
+	cc->resize(rows);
+	cc->normalize();
+
+	ConfigurationSetPtr cs;
+	if (this->pc.storageMode == StorageMode::Columnar) {
+		cs = std::make_shared<ConfigurationSet>(cc, csname);
+	}
+	else {
+		// the rows are in order, so every configuration is inserted at the end of the set
+		cs = std::make_shared<ConfigurationSet>(sp, csname);
+		for (size_t r = 0; r < cc->size(); r++) {
+			cs->confs().insert(cs->confs().end(), cc->configurationAt(r, cs->arena));
+		}
+	}
+	this->pc.store(cs);
+}
+
+/// parse '(value, ...)' and append the configuration to the columns 'cc' of set 'setName'
+void ParetoDSLParser::parseConfiguration(ConfigurationColumns& cc, const QuantityValueParser& values, const std::string& setName) {
+	this->expectSymbol('(');
+	unsigned int k = 0;
+	do {
+		if (k >= values.size()) {
+			this->error(this->tok, "too many values in a configuration of " + setName);
+		}
+		if (this->tok.kind != TokenKind::Number && this->tok.kind != TokenKind::Identifier) {
+			this->error(this->tok, "value expected");
+		}
+		// std::from_chars does not accept a leading '+'
+		const char* b = this->tok.b;
+		if (*b == '+') b++;
+		if (!values.appendTo(k, b, this->tok.e, cc.columns[k])) {
+			this->error(this->tok, "invalid value of quantity type " + cc.columns[k].qtype->name);
+		}
+		k++;
+		this->advance();
+	} while (this->acceptSymbol(','));
+	if (k < values.size()) {
+		this->error(this->tok, "too few values in a configuration of " + setName);
+	}
+	this->expectSymbol(')');
+}
+
+/// parse 'name, ...'
+ListOfQuantityNames ParetoDSLParser::parseListOfQuantityNames(void) {
+	ListOfQuantityNames lqn;
+	do {
+		lqn.push_back(this->expectIdentifier());
+	} while (this->acceptSymbol(','));
+	return lqn;
+}
+
+/// parse an operation of the calculation, with the messages of the operations of the XML parser
+void ParetoDSLParser::parseOperation(void) {
+	ParetoCalculatorOperationPtr op;
+	std::string message;
+
+	if (this->acceptKeyword("push")) {
+		message = "pushing object onto the stack\n";
+		op = std::make_shared<POperation_Push>(this->expectIdentifier());
+	}
+	else if (this->acceptKeyword("product")) {
+		message = "computing product of sets of configurations\n";
+		op = std::make_shared<POperation_Product>();
+	}
+	else if (this->acceptKeyword("prodcons")) {
+		message = "applying producer consumer constraint\n";
+		// 'prod = q' and 'cons = q' in either order
+		std::string pq, cq;
+		for (int i = 0; i < 2; i++) {
+			if (pq.empty() && this->acceptKeyword("prod")) {
+				this->expectSymbol('=');
+				pq = this->expectIdentifier();
+			}
+			else if (cq.empty() && this->acceptKeyword("cons")) {
+				this->expectSymbol('=');
+				cq = this->expectIdentifier();
+			}
+			else {
+				this->error(this->tok, pq.empty() ? "'prod' expected" : "'cons' expected");
+			}
+		}
+		op = std::make_shared<POperation_ProdCons>(pq, cq);
+	}
+	else if (this->acceptKeyword("abstract")) {
+		message = "abstraction of quantities\n";
+		this->expectKeyword("from");
+		op = std::make_shared<POperation_Abstract>(this->parseListOfQuantityNames());
+	}
+	else if (this->acceptKeyword("hide")) {
+		message = "hiding quantities\n";
+		op = std::make_shared<POperation_Hide>(this->parseListOfQuantityNames());
+	}
+	else if (this->acceptKeyword("minimize")) {
+		message = "minimizing set of configurations\n";
+		op = std::make_shared<POperation_Minimize>();
+	}
+	else if (this->acceptKeyword("store")) {
+		message = "storing object from the stack\n";
+		this->expectKeyword("as");
+		op = std::make_shared<POperation_Store>(this->expectIdentifier());
+	}
+	else if (this->acceptKeyword("join")) {
+		message = "join on multiple attributes\n";
+		JoinMap jm;
+		std::string qa = this->expectIdentifier();
+		this->expectKeyword("with");
+		jm[qa] = this->expectIdentifier();
+		op = std::make_shared<POperation_Join>(jm);
+	}
+	else if (this->acceptKeyword("aggregate")) {
+		message = "aggregating attributes\n";
+		ListOfQuantityNames lqn = this->parseListOfQuantityNames();
+		this->expectKeyword("as");
+		op = std::make_shared<POperation_Aggregate>(lqn, this->expectIdentifier());
+	}
+	else if (this->acceptKeyword("duplicate")) {
+		message = "duplicating element on top of the stack\n";
+		op = std::make_shared<POperation_Duplicate>();
+	}
+	else if (this->acceptKeyword("print")) {
+		message = "printing element from the stack:\n";
+		op = std::make_shared<POperation_Print>();
+	}
+	else {
+		this->error(this->tok, "operation expected");
+	}
+	op->message = message;
+	this->operations.push_back(op);
+}
@@ -0,0 +1,131 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// A native parser of the textual Pareto specification language (see the dsl folder),
+// which loads .pareto files without converting them to XML
+//
+
+#ifndef PARETO_PARSER_DSL_H
+#define PARETO_PARSER_DSL_H
+
+#include <string>
+#include "operations.h"
+#include "records.h"
+
+namespace Pareto {
+
+	class ParetoCalculator;
+
+	/// A hand-written, single-pass parser of the .pareto specification language.
+	///
+	/// Quantity types, configuration spaces and configuration sets are stored in the calculator
+	/// as soon as they have been read, without building a syntax tree. The values of configuration
+	/// sets are parsed directly into columns (see ConfigurationColumns). The operations of the
+	/// calculation are collected in 'operations' for the calculator to execute. As in the grammar
+	/// of the language, keywords cannot be used as names unless they are escaped with '^'.
+	/// Syntax errors are reported as an EParetoCalculatorError with the line of the error.
+	class ParetoDSLParser {
+	public:
+		ParetoDSLParser(ParetoCalculator& forPC);
+
+		/// parse the specification in file 'f'
+		void LoadFile(const std::string& f);
+
+		/// parse the specification 'text'. 'source' names the text in error messages.
+		void Load(const std::string& text, const std::string& source);
+
+		/// the name of the loaded specification
+		std::string name;
+
+		/// the operations of the calculation of the loaded specification
+		ListOfOperations operations;
+
+	private:
+
+		/// the kinds of tokens of the language
+		enum class TokenKind { Identifier, Keyword, Number, Symbol, Block, End };
+
+		/// a token of the text from 'b' to 'e', on line 'line'
+		struct Token {
+			TokenKind kind = TokenKind::End;
+			const char* b = nullptr;
+			const char* e = nullptr;
+			size_t line = 0;
+		};
+
+		ParetoCalculator& pc;
+
+		/// the name of the parsed text in error messages
+		std::string source;
+
+		/// the position and line of the scanner in the text
+		const char* pos = nullptr;
+		const char* end = nullptr;
+		size_t line = 1;
+
+		/// the current token and the token that follows it
+		Token tok;
+		Token next;
+
+		/// scan the next token of the text
+		Token scan(void);
+
+		/// move to the next token
+		void advance(void);
+
+		bool isKeyword(const Token& t, const char* kw) const;
+		bool isSymbol(const Token& t, char c) const;
+
+		/// skip the current token if it is keyword 'kw' or symbol 'c'
+		bool acceptKeyword(const char* kw);
+		bool acceptSymbol(char c);
+
+		/// skip the current token, throw an exception if it is not the expected one
+		void expectKeyword(const char* kw);
+		void expectSymbol(char c);
+		std::string expectIdentifier(void);
+
+		/// the object named by token 't' in the memory of the calculator
+		StorableObjectPtr lookup(const Token& t);
+
+		/// throw an exception with message 'msg' for token 't'
+		[[noreturn]] void error(const Token& t, const std::string& msg) const;
+
+		void parseQuantityType(void);
+		void parseConfigurationSpace(void);
+		void parseConfigurationSet(void);
+		void parseConfiguration(ConfigurationColumns& cc, const QuantityValueParser& values, const std::string& setName);
+		void parseOperation(void);
+		ListOfQuantityNames parseListOfQuantityNames(void);
+	};
+
+}
+
+#endif
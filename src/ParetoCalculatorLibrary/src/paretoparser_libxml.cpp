@@ -42,6 +42,9 @@
 #include "operations.h"
 #include "calculator.h"
 #include "utils_libxml.h"
+#include "autotuner.h"
+#include "records.h"
+#include <sstream>
 
 
 using namespace Pareto;
@@ -54,10 +57,60 @@ ParetoParser::ParetoParser(Pareto::ParetoCalculator& forPC): pc(forPC)
 }
 
 
-// load an xml file
+ParetoParser::~ParetoParser()
+{
+	if (reader != nullptr) {
+		xmlFreeTextReader(reader);
+	}
+}
+
+
+/// copy the sections of the document into the DOM tree as the reader passes them, starting from
+/// the node the last move of the reader (with result 'ret') arrived at. Stops on a configuration_sets
+/// element, which is left to the reader, or at the end of the document, where the reader is freed.
+/// Returns false if the document is not valid.
+bool ParetoParser::readSections(int ret) {
+	xmlNodePtr root = xmlDocGetRootElement(pXMLDoc);
+	while (ret == 1) {
+		if (xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT || xmlTextReaderDepth(reader) > 1) {
+			ret = xmlTextReaderRead(reader);
+		}
+		else if (xmlTextReaderDepth(reader) == 0) {
+			// a copy of the root element without its children
+			root = xmlDocCopyNode(xmlTextReaderCurrentNode(reader), pXMLDoc, 2);
+			xmlDocSetRootElement(pXMLDoc, root);
+			ret = xmlTextReaderRead(reader);
+		}
+		else if (xml_to_std_string(xmlTextReaderConstLocalName(reader)) == "configuration_sets") {
+			// the configuration sets are streamed by LoadConfigurationSets without building their nodes
+			return true;
+		}
+		else {
+			xmlNodePtr n = xmlTextReaderExpand(reader);
+			if (n != nullptr && root != nullptr) {
+				xmlAddChild(root, xmlDocCopyNode(n, pXMLDoc, 1));
+			}
+			ret = xmlTextReaderNext(reader);
+		}
+	}
+	xmlFreeTextReader(reader);
+	reader = nullptr;
+	return ret == 0 && root != nullptr;
+}
+
+// load an xml file. The file is read in a single pass: the sections up to the configuration sets
+// are read into a DOM tree now, the configuration sets are streamed by LoadConfigurationSets,
+// which then reads the remaining sections.
 void ParetoParser::LoadFile(std::string f) {
-	pXMLDoc = xmlParseFile(f.c_str());
-	if (pXMLDoc == nullptr) {
+	this->fileName = f;
+	if (reader != nullptr) {
+		xmlFreeTextReader(reader);
+	}
+	pXMLDoc = xmlNewDoc((const xmlChar*)"1.0");
+	reader = xmlReaderForFile(f.c_str(), nullptr, 0);
+	if (reader == nullptr || !this->readSections(xmlTextReaderRead(reader))) {
+		xmlFreeDoc(pXMLDoc);
+		pXMLDoc = nullptr;
 		pc.verbose("Document not parsed successfully. \n");
 	}
 	xpathCtx = xmlXPathNewContext(pXMLDoc);
@@ -177,48 +230,111 @@ void ParetoParser::LoadConfigurationSpaces() {
 
 
 // Load Configuration Sets from XML document
+//
+// The configuration sets are streamed by the reader of LoadFile, so that only the configuration
+// that is being read is held in XML nodes. The values are parsed directly from the text of the
+// nodes. The sections that follow the configuration sets are read into the DOM tree afterwards.
 void ParetoParser::LoadConfigurationSets() {
 
-	// Select the configuration set nodes
-	xmlXPathObjectPtr result = getNodeSetXPath(pXMLDoc, (xmlChar*)"//pa:pareto_specification/pa:configuration_sets/pa:configuration_set", xpathCtx);
-	if (result) {
-		xmlNodeSetPtr nodeset = result->nodesetval;
-		for (int i = 0; i < nodeset->nodeNr; i++) {
-			// for each configuration space node pSpaceNode ...
-			xmlNodePtr pConfSetNode = nodeset->nodeTab[i];
-
-			ConfigurationSpacePtr sp = std::dynamic_pointer_cast<ConfigurationSpace>(pc.retrieve(getNodeAttribute(pConfSetNode, (xmlChar*)"space_id")));
-
-			ConfigurationSetPtr cs = std::make_shared<ConfigurationSet>(sp, getNodeAttribute(pConfSetNode, (xmlChar*)"name"));
-			ListOfQuantityTypes& qts = sp->quantities;
-
-			// get all the configurations and add them to the set
-			xmlXPathObjectPtr result_confs = getNodeSetXPathNode(pXMLDoc, pConfSetNode, (xmlChar*)"pa:configurations/pa:configuration", xpathCtx);
-			if (result_confs) {
-				xmlNodeSetPtr nodeset_confs = result_confs->nodesetval;
-				for (int j = 0; j < nodeset_confs->nodeNr; j++) {
-					// for each configuration node pConfNode ...
-					xmlNodePtr pConfNode = nodeset_confs->nodeTab[j];
-					ConfigurationPtr cf = std::make_shared<Configuration>(sp);
-
-					// get all the values and add them to the configuration
-					xmlXPathObjectPtr result_value = getNodeSetXPathNode(pXMLDoc, pConfNode, (xmlChar*)"pa:value", xpathCtx);
-					if (result_value) {
-						xmlNodeSetPtr nodeset_value = result_value->nodesetval;
-						for (int k = 0; k < nodeset_value->nodeNr; k++) {
-							// for each value node pValueNode ...
-							xmlNodePtr pValueNode = nodeset_value->nodeTab[k];
-							QuantityValuePtr qv = (qts)[k]->valueFromString(getNodeText(pXMLDoc, pValueNode));
+	// the set, the parser of its values and the configuration that are being read
+	ConfigurationSetPtr cs;
+	std::unique_ptr<QuantityValueParser> values;
+	ConfigurationPtr cf;
+	std::string text;
+
+	// an attribute of the current element
+	auto attribute = [&](const char* attr) {
+		xmlChar* a = xmlTextReaderGetAttribute(reader, (const xmlChar*)attr);
+		std::string v = xml_to_std_string(a);
+		xmlFree(a);
+		return v;
+	};
+	auto isElement = [&](const char* name, int depth) {
+		return xmlTextReaderDepth(reader) == depth
+			&& xmlStrEqual(xmlTextReaderConstLocalName(reader), (const xmlChar*)name)
+			&& xmlStrEqual(xmlTextReaderConstNamespaceUri(reader), (const xmlChar*)"uri:pareto");
+	};
+	// add the configuration that has been read to its set
+	auto addConfiguration = [&]() {
+		if (cf->quantities.size() != values->size()) {
+			throw EParetoCalculatorError("Too few values in a configuration of configuration set " + cs->name);
+		}
+		cs->addConfiguration(cf);
+		cf = nullptr;
+	};
+
+	// the reader is on a configuration_sets element, if the document has one that is not read yet
+	while (reader != nullptr) {
+		int ret = 1;
+		try {
+			if (xmlTextReaderIsEmptyElement(reader) != 1) {
+				while ((ret = xmlTextReaderRead(reader)) == 1) {
+					int type = xmlTextReaderNodeType(reader);
+					if (type == XML_READER_TYPE_ELEMENT) {
+						bool empty = xmlTextReaderIsEmptyElement(reader) == 1;
+						if (isElement("configuration_set", 2)) {
+							ConfigurationSpacePtr sp = std::dynamic_pointer_cast<ConfigurationSpace>(pc.retrieve(attribute("space_id")));
+							cs = std::make_shared<ConfigurationSet>(sp, attribute("name"));
+							values.reset(new QuantityValueParser(sp));
+							if (empty) {
+								pc.store(cs);
+								cs = nullptr;
+							}
+						}
+						else if (cs && isElement("configuration", 4)) {
+							cf = cs->createConfiguration();
+							if (empty) {
+								addConfiguration();
+							}
+						}
+						else if (cf && isElement("value", 5)) {
+							// collect the text of the value
+							text.clear();
+							if (!empty) {
+								while ((ret = xmlTextReaderRead(reader)) == 1 && xmlTextReaderNodeType(reader) != XML_READER_TYPE_END_ELEMENT) {
+									const xmlChar* t = xmlTextReaderConstValue(reader);
+									if (t != nullptr) text.append((const char*)t);
+								}
+							}
+							unsigned int k = (unsigned int)cf->quantities.size();
+							if (k >= values->size()) {
+								throw EParetoCalculatorError("Too many values in a configuration of configuration set " + cs->name);
+							}
+							QuantityValuePtr qv = values->parse(k, text.data(), text.data() + text.size());
+							if (!qv) {
+								qv = cs->confspace->quantities[k]->valueFromString(text);
+							}
 							cf->addQuantity(qv);
 						}
 					}
-					cs->addConfiguration(cf);
+					else if (type == XML_READER_TYPE_END_ELEMENT) {
+						if (cf && isElement("configuration", 4)) {
+							addConfiguration();
+						}
+						else if (cs && isElement("configuration_set", 2)) {
+							pc.store(cs);
+							cs = nullptr;
+						}
+						else if (xmlTextReaderDepth(reader) == 1) {
+							// the end of the configuration_sets element
+							break;
+						}
+					}
 				}
-				xmlXPathFreeObject(result_confs);
 			}
-			pc.store(cs);
 		}
-		xmlXPathFreeObject(result);
+		catch (...) {
+			xmlFreeTextReader(reader);
+			reader = nullptr;
+			throw;
+		}
+		// read the sections after the configuration sets
+		if (ret == 1) {
+			ret = xmlTextReaderRead(reader);
+		}
+		if (!this->readSections(ret)) {
+			throw EParetoCalculatorError("Configuration sets of " + this->fileName + " not parsed successfully");
+		}
 	}
 }
 
@@ -263,6 +379,76 @@ std::shared_ptr<JoinMap> ParetoParser::getJoinMap(xmlNodePtr pOperationNode)
 	return jm;
 }
 
+
+// read an optional unsigned integer attribute 'attr' of an operation node
+static unsigned int getUnsignedAttribute(xmlNodePtr pOperationNode, const char* attr, unsigned int defaultValue)
+{
+	if (!hasNodeAttribute(pOperationNode, (xmlChar*)attr)) {
+		return defaultValue;
+	}
+	try {
+		return (unsigned int) std::stoul(getNodeAttribute(pOperationNode, (xmlChar*)attr));
+	}
+	catch (const std::exception&) {
+		throw EParetoCalculatorError(std::string("Invalid value of attribute ") + attr);
+	}
+}
+
+
+MinimizeOptions ParetoParser::getMinimizeOptions(xmlNodePtr pOperationNode)
+{
+	MinimizeOptions o;
+	o.minimizeThreshold = getUnsignedAttribute(pOperationNode, "minimize_threshold", o.minimizeThreshold);
+	if (o.minimizeThreshold < 2) {
+		// smaller ranges cannot be split by the divide and conquer recursion
+		throw EParetoCalculatorError("Invalid value of attribute minimize_threshold, it must be at least 2");
+	}
+	o.filterThreshold = getUnsignedAttribute(pOperationNode, "filter_threshold", o.filterThreshold);
+	o.grain = getUnsignedAttribute(pOperationNode, "grain", o.grain);
+	if (hasNodeAttribute(pOperationNode, (xmlChar*)"parallel")) {
+		std::string p = getNodeAttribute(pOperationNode, (xmlChar*)"parallel");
+		o.parallel = (p == "true") || (p == "1");
+	}
+	if (hasNodeAttribute(pOperationNode, (xmlChar*)"sweep")) {
+		std::string w = getNodeAttribute(pOperationNode, (xmlChar*)"sweep");
+		o.sweepKernels = (w == "true") || (w == "1");
+	}
+	if (hasNodeAttribute(pOperationNode, (xmlChar*)"autotune")) {
+		std::string a = getNodeAttribute(pOperationNode, (xmlChar*)"autotune");
+		if ((a == "true") || (a == "1")) {
+			o.tuner = &(this->pc.thresholdTuner());
+		}
+	}
+	if (hasNodeAttribute(pOperationNode, (xmlChar*)"base")) {
+		std::string b = getNodeAttribute(pOperationNode, (xmlChar*)"base");
+		if (b == "block") {
+			o.baseCase = MinimizeAlgorithm::Block;
+		}
+		else if (b == "simple_cull") {
+			o.baseCase = MinimizeAlgorithm::SimpleCull;
+		}
+		else if (b == "sort_filter") {
+			o.baseCase = MinimizeAlgorithm::SortFilter;
+		}
+		else {
+			throw EParetoCalculatorError("Unknown base-case minimization algorithm: " + b);
+		}
+	}
+	return o;
+}
+
+
+JoinOptions ParetoParser::getJoinOptions(xmlNodePtr pOperationNode)
+{
+	JoinOptions o;
+	o.grain = getUnsignedAttribute(pOperationNode, "grain", o.grain);
+	if (hasNodeAttribute(pOperationNode, (xmlChar*)"parallel")) {
+		std::string p = getNodeAttribute(pOperationNode, (xmlChar*)"parallel");
+		o.parallel = (p == "true") || (p == "1");
+	}
+	return o;
+}
+
 void ParetoParser::LoadOperations()
 {
 	// Load the operations from XML document
@@ -273,6 +459,13 @@ void ParetoParser::LoadOperations()
 		return;
 	}
 
+	// read the sections after configuration sets that have not been loaded
+	while (reader != nullptr) {
+		if (!this->readSections(xmlTextReaderNext(reader))) {
+			throw EParetoCalculatorError(this->fileName + " not parsed successfully");
+		}
+	}
+
 	// Select the configuration set nodes
 	xmlXPathObjectPtr result = getNodeSetXPath(pXMLDoc, (xmlChar*)"//pa:pareto_specification/pa:calculation/pa:*", xpathCtx);
 	if (!result) {
@@ -280,62 +473,62 @@ void ParetoParser::LoadOperations()
 		return;
 	}
 
+	// create the operations
+	ListOfOperations ops;
 	xmlNodeSetPtr nodeset = result->nodesetval;
 	for (int i = 0; i < nodeset->nodeNr; i++) {
 		// for each operation pOperationNode ...
 		xmlNodePtr pOperationNode = nodeset->nodeTab[i];
 		std::string nodeName = getNodeType(pOperationNode);
+		ParetoCalculatorOperationPtr op;
+		std::string message;
 
 		if (nodeName == "join") {
-			pc.verbose("join on multiple attributes\n");
+			message = "join on multiple attributes\n";
 
 			std::shared_ptr<JoinMap> qm = this->getJoinMap(pOperationNode);
 
-			// create an operation and execute it
-			POperation_Join op(*qm);
-			op.executeOn(pc);
+			// create the operation
+			op = std::make_shared<POperation_Join>(*qm);
 		}
 
-		if (nodeName == "join_eff") {
-			pc.verbose("efficient join on multiple attributes\n");
+		else if (nodeName == "join_eff") {
+			message = "efficient join on multiple attributes\n";
 
 			std::shared_ptr<JoinMap> qm = this->getJoinMap(pOperationNode);
 
-			// create an operation and execute it
-			POperation_EfficientJoin op(*qm);
-			op.executeOn(pc);
+			// create the operation
+			op = std::make_shared<POperation_EfficientJoin>(*qm, this->getJoinOptions(pOperationNode));
 		}
 
 		else if (nodeName == "abstract") {
-			pc.verbose("abstraction of quantities\n");
+			message = "abstraction of quantities\n";
 
 			// get the quantities
 			std::shared_ptr<ListOfQuantityNames> lqn = getListOfQuantityNames(pOperationNode);
 
-			// create an operation and execute it
-			POperation_Abstract op(*lqn);
-			op.executeOn(pc);
+			// create the operation
+			op = std::make_shared<POperation_Abstract>(*lqn);
 			
 			// cleanup
 			//delete &lqn;
 		}
 
 		else if (nodeName == "hide") {
-			pc.verbose("hiding quantities\n");
+			message = "hiding quantities\n";
 
 			// get the quantities
 			std::shared_ptr<ListOfQuantityNames> lqn = getListOfQuantityNames(pOperationNode);
 
-			// create an operation and execute it
-			POperation_Hide op(*lqn);
-			op.executeOn(pc);
+			// create the operation
+			op = std::make_shared<POperation_Hide>(*lqn);
 
 			// cleanup
 			//delete &lqn;
 		}
 
 		else if (nodeName == "aggregate") {
-			pc.verbose("aggregating attributes\n");
+			message = "aggregating attributes\n";
 
 			// get the quantities
 			std::shared_ptr<ListOfQuantityNames> lqn = getListOfQuantityNames(pOperationNode);
@@ -348,16 +541,15 @@ void ParetoParser::LoadOperations()
 			}
 			std::string newname = getNodeText(pXMLDoc, pNameNode);
 
-			// create an operation and execute it
-			POperation_Aggregate op(*lqn, newname);
-			op.executeOn(pc);
+			// create the operation
+			op = std::make_shared<POperation_Aggregate>(*lqn, newname);
 
 			// cleanup
 			//delete &lqn;
 		}
 
 		else if (nodeName == "prodcons") {
-			pc.verbose("applying producer consumer constraint\n");
+			message = "applying producer consumer constraint\n";
 
 			// Select the producer and consumer quantity nodes
 			xmlNodePtr pProdNode = getNodeXPathNode(pXMLDoc, pOperationNode, (xmlChar*)"pa:producer_quant", xpathCtx);
@@ -366,13 +558,12 @@ void ParetoParser::LoadOperations()
 			std::string pq = getNodeText(pXMLDoc, pProdNode);
 			std::string cq = getNodeText(pXMLDoc, pConsNode);
 
-			// create an operation and execute it
-			POperation_ProdCons op(pq, cq);
-			op.executeOn(pc);
+			// create the operation
+			op = std::make_shared<POperation_ProdCons>(pq, cq);
 		}
 
 		else if (nodeName == "prodcons_eff") {
-			pc.verbose("applying efficient producer consumer constraint\n");
+			message = "applying efficient producer consumer constraint\n";
 
 			// Select the producer and consumer quantity nodes
 			xmlNodePtr pProdNode = getNodeXPathNode(pXMLDoc, pOperationNode, (xmlChar*)"pa:producer_quant", xpathCtx);
@@ -380,69 +571,74 @@ void ParetoParser::LoadOperations()
 			std::string pq = getNodeText(pXMLDoc, pProdNode);
 			std::string cq = getNodeText(pXMLDoc, pConsNode);
 
-			// create an operation and execute it
-			POperation_EfficientProdCons op(pq, cq);
-			op.executeOn(pc);
+			// create the operation
+			op = std::make_shared<POperation_EfficientProdCons>(pq, cq);
 		}
 
 		else if (nodeName == "push") {
-			pc.verbose("pushing object onto the stack\n");
+			message = "pushing object onto the stack\n";
 				
-			// create an operation and execute it
-			POperation_Push op(getNodeAttribute(pOperationNode, (xmlChar*)"name"));
-			op.executeOn(pc);
+			// create the operation
+			op = std::make_shared<POperation_Push>(getNodeAttribute(pOperationNode, (xmlChar*)"name"));
 		}
 
 		else if (nodeName == "store") {
-			pc.verbose("storing object from the stack\n");
+			message = "storing object from the stack\n";
 			
-			// create an operation and execute it
-			POperation_Store op(getNodeAttribute(pOperationNode, (xmlChar*)"name"));
-			op.executeOn(pc);
+			// create the operation
+			op = std::make_shared<POperation_Store>(getNodeAttribute(pOperationNode, (xmlChar*)"name"));
 		}
 
 		else if (nodeName == "minimize") {
-			pc.verbose("minimizing set of configurations\n");
+			message = "minimizing set of configurations\n";
 
-			// create an operation and execute it
-			POperation_Minimize op;
-			op.executeOn(pc);
+			// create the operation
+			op = std::make_shared<POperation_Minimize>();
 		}
 		
 		else if (nodeName == "minimize_eff") {
-			pc.verbose("minimizing set of configurations\n");
+			message = "minimizing set of configurations\n";
+
+			// create the operation
+			op = std::make_shared<POperation_EfficientMinimize>(this->getMinimizeOptions(pOperationNode));
+		}
+
+		else if (nodeName == "minimize_sfs") {
+			message = "minimizing set of configurations\n";
 
-			// create an operation and execute it
-			POperation_EfficientMinimize op;
-			op.executeOn(pc);
+			// create the operation
+			op = std::make_shared<POperation_SortFilterMinimize>();
 		}
 
 		else if (nodeName == "pop") {
-			pc.verbose("popping element from the stack\n");
-			POperation_Pop op;
-			op.executeOn(pc);
+			message = "popping element from the stack\n";
+			op = std::make_shared<POperation_Pop>();
 		}
 
 		else if (nodeName == "duplicate") {
-			pc.verbose("duplicating element on top of the stack\n");
-			POperation_Duplicate op;
-			op.executeOn(pc);
+			message = "duplicating element on top of the stack\n";
+			op = std::make_shared<POperation_Duplicate>();
 		}
 
 		else if (nodeName == "print") {
-			pc.verbose("printing element from the stack:\n");
-			POperation_Print op;
-			op.executeOn(pc);
+			message = "printing element from the stack:\n";
+			op = std::make_shared<POperation_Print>();
 		}
 
 		else if (nodeName == "product") {
-			pc.verbose("computing product of sets of configurations\n");
-			POperation_Product op;
-			op.executeOn(pc);
+			message = "computing product of sets of configurations\n";
+			op = std::make_shared<POperation_Product>();
 		}
 
+		if (op) {
+			op->message = message;
+			ops.push_back(op);
+		}
 	}
 	xmlXPathFreeObject(result);
+
+	// execute the operations
+	pc.executeOperations(ops);
 }
 
 
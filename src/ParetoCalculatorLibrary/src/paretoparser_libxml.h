@@ -42,6 +42,7 @@
 #include "operations.h"
 
 #include <libxml/parser.h>
+#include <libxml/xmlreader.h>
 #include <libxml/xpath.h>
 #include <libxml/xpathInternals.h>
 
@@ -53,6 +54,7 @@ namespace Pareto {
 	class ParetoParser {
 	public:
 		ParetoParser(ParetoCalculator& forPC);
+		~ParetoParser();
 
 		void LoadFile(std::string f);
 		void SaveAll(std::string f);						// forget about saving for now
@@ -73,10 +75,20 @@ namespace Pareto {
 
 		ParetoCalculator& pc;
 
+		/// the name of the loaded file
+		std::string fileName;
+
+		/// the reader of the loaded file, while it has sections that are not read
+		xmlTextReaderPtr reader = nullptr;
+
 		xmlXPathContextPtr xpathCtx = nullptr;
 
+		bool readSections(int ret);
+
 		std::shared_ptr<ListOfQuantityNames> getListOfQuantityNames(xmlNodePtr pOperationNode);
 		std::shared_ptr<JoinMap> getJoinMap(xmlNodePtr pOperationNode);
+		MinimizeOptions getMinimizeOptions(xmlNodePtr pOperationNode);
+		JoinOptions getJoinOptions(xmlNodePtr pOperationNode);
 	};
 
 }
@@ -0,0 +1,424 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Implementation of the streaming evaluation of products of sets of configurations
+//
+
+#include "pipeline.h"
+#include "archive.h"
+#include "calculator.h"
+#include "dominance.h"
+#include "exceptions.h"
+#include <algorithm>
+
+using namespace Pareto;
+
+
+/// LazyProduct constructor
+LazyProduct::LazyProduct(ConfigurationSetPtr ca, ConfigurationSetPtr cb, ConfigurationSpacePtr productspace) :
+	space(productspace),
+	a(ca),
+	b(cb)
+{
+	this->a->materialize();
+	this->b->materialize();
+	this->conf = allocateInArena<Configuration>(nullptr, productspace);
+	this->conf->quantities.reserve(productspace->quantities.size());
+}
+
+/// the number of configurations of the product
+size_t LazyProduct::size(void) const {
+	return this->a->size() * this->b->size();
+}
+
+/// move to the next configuration of the product
+bool LazyProduct::next(void) {
+	if (!this->started) {
+		this->started = true;
+		this->i = this->b->confs().empty() ? this->a->confs().end() : this->a->confs().begin();
+		this->j = this->b->confs().begin();
+	}
+	else if (this->i != this->a->confs().end()) {
+		this->j++;
+		if (this->j == this->b->confs().end()) {
+			this->i++;
+			this->j = this->b->confs().begin();
+		}
+	}
+	if (this->i == this->a->confs().end()) {
+		return false;
+	}
+
+	// rebuild the current configuration, stages may have changed its space and values
+	this->conf->confspace = this->space;
+	this->conf->quantities.clear();
+	this->conf->addQuantitiesOf(*this->i);
+	this->conf->addQuantitiesOf(*this->j);
+	return true;
+}
+
+
+/// StreamStage_ProdCons constructor
+StreamStage_ProdCons::StreamStage_ProdCons(const std::string& pqname, const std::string& cqname) :
+	p_quant(pqname),
+	c_quant(cqname)
+{
+}
+
+/// find the producer and consumer quantities in space 'in'
+ConfigurationSpacePtr StreamStage_ProdCons::prepare(ConfigurationSpacePtr in) {
+	this->p_index = in->indexOfQuantity(this->p_quant);
+	this->c_index = in->indexOfQuantity(this->c_quant);
+	if (!std::dynamic_pointer_cast<const QuantityType_Real>(in->quantities[this->p_index]) ||
+		!std::dynamic_pointer_cast<const QuantityType_Real>(in->quantities[this->c_index])) {
+		throw EParetoCalculatorError("Producer-consumer constraint requires real valued quantities");
+	}
+	return in;
+}
+
+/// test the producer-consumer constraint on configuration 'c'
+bool StreamStage_ProdCons::apply(Configuration& c) const {
+	const QuantityValue_Real& pv = static_cast<const QuantityValue_Real&>(*c.quantities[this->p_index]);
+	const QuantityValue_Real& cv = static_cast<const QuantityValue_Real&>(*c.quantities[this->c_index]);
+	return cv.value <= (1.0 / pv.value);
+}
+
+
+/// StreamStage_Join constructor
+StreamStage_Join::StreamStage_Join(const std::vector<int>& qa, const std::vector<int>& qb) :
+	qan(qa),
+	qbn(qb)
+{
+}
+
+/// the join constraint does not change the space
+ConfigurationSpacePtr StreamStage_Join::prepare(ConfigurationSpacePtr in) {
+	return in;
+}
+
+/// test the join constraint on configuration 'c'
+bool StreamStage_Join::apply(Configuration& c) const {
+	for (size_t k = 0; k < this->qan.size(); k++) {
+		if (!(*c.quantities[this->qan[k]] == *c.quantities[this->qbn[k]])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+/// StreamStage_Abstract constructor
+StreamStage_Abstract::StreamStage_Abstract(const ListOfQuantityNames& qnames) :
+	lqn(qnames)
+{
+}
+
+/// compute the abstracted space in the same way as a sequence of abstractions
+ConfigurationSpacePtr StreamStage_Abstract::prepare(ConfigurationSpacePtr in) {
+	this->indices.clear();
+	this->space = in;
+	for (ListOfQuantityNames::const_iterator i = this->lqn.begin(); i != this->lqn.end(); i++) {
+		if (!this->space->includesQuantityNamed(*i)) {
+			throw EParetoCalculatorError("Quantity " + *i + "does not exist in ParetoCalculator::abstraction");
+		}
+		unsigned int n = this->space->quantityNames.at(*i);
+		this->indices.push_back(n);
+		this->space = ParetoCalculator::abstractionSpace(this->space, n);
+	}
+	return this->space;
+}
+
+/// remove the abstracted quantities from configuration 'c'
+bool StreamStage_Abstract::apply(Configuration& c) const {
+	for (std::vector<unsigned int>::const_iterator i = this->indices.begin(); i != this->indices.end(); i++) {
+		c.quantities.erase(c.quantities.begin() + *i);
+	}
+	c.confspace = this->space;
+	return true;
+}
+
+
+/// StreamStage_Aggregate constructor
+StreamStage_Aggregate::StreamStage_Aggregate(const ListOfQuantityNames& ag_quants, const std::string& agname) :
+	aggregate_quants(ag_quants),
+	newName(agname)
+{
+}
+
+/// find the quantities to aggregate and compute the space with the aggregate quantity,
+/// in the same way as POperation_Aggregate
+ConfigurationSpacePtr StreamStage_Aggregate::prepare(ConfigurationSpacePtr in) {
+	this->indices.clear();
+	for (ListOfQuantityNames::const_iterator i = this->aggregate_quants.begin(); i != this->aggregate_quants.end(); i++) {
+		unsigned int k = in->indexOfQuantity(*i);
+		if (!std::dynamic_pointer_cast<const QuantityType_Real>(in->quantities[k])) {
+			throw EParetoCalculatorError("Aggregation requires real valued quantities");
+		}
+		this->indices.push_back(k);
+	}
+	this->type = std::make_shared<QuantityType_Real>(this->newName);
+	this->space = std::make_shared<ConfigurationSpace>("Aggregation (" + in->name + ")");
+	this->space->addQuantitiesOf(*in);
+	this->space->addQuantity(this->type);
+	return this->space;
+}
+
+/// add the sum of the aggregated quantities to configuration 'c'
+bool StreamStage_Aggregate::apply(Configuration& c) const {
+	double sum = 0.0;
+	for (std::vector<unsigned int>::const_iterator i = this->indices.begin(); i != this->indices.end(); i++) {
+		sum = sum + static_cast<const QuantityValue_Real&>(*c.quantities[*i]).value;
+	}
+	c.addQuantity(allocateInArena<QuantityValue_Real>(nullptr, *this->type, sum));
+	c.confspace = this->space;
+	return true;
+}
+
+
+/// StreamStage_Hide constructor
+StreamStage_Hide::StreamStage_Hide(const ListOfQuantityNames& qnames) :
+	lqn(qnames)
+{
+}
+
+/// compute the space with the hidden quantities
+ConfigurationSpacePtr StreamStage_Hide::prepare(ConfigurationSpacePtr in) {
+	this->space = in->hide(this->lqn);
+	return this->space;
+}
+
+/// move configuration 'c' to the space with the hidden quantities
+bool StreamStage_Hide::apply(Configuration& c) const {
+	c.confspace = this->space;
+	return true;
+}
+
+
+/// ProductPipeline constructor
+ProductPipeline::ProductPipeline(ConfigurationSetPtr ca, ConfigurationSetPtr cb) :
+	a(ca),
+	b(cb)
+{
+}
+
+/// append stage 's' to the pipeline
+void ProductPipeline::addStage(StreamStagePtr s) {
+	this->stages.push_back(s);
+}
+
+/// minimize the result with 'm'
+void ProductPipeline::setMinimization(Minimization m) {
+	this->minimization = m;
+}
+
+/// run the pipeline
+ConfigurationSetPtr ProductPipeline::run(void) {
+	LazyProduct product(this->a, this->b, this->a->confspace->productWith(this->b->confspace));
+
+	// prepare the stages and determine the space of the result
+	ConfigurationSpacePtr space = product.space;
+	for (std::vector<StreamStagePtr>::iterator s = this->stages.begin(); s != this->stages.end(); s++) {
+		space = (*s)->prepare(space);
+	}
+
+	std::string name = "Stream(" + this->a->name + ", " + this->b->name + ")";
+	ConfigurationSetPtr block = std::make_shared<ConfigurationSet>(space, name);
+	ConfigurationSetPtr result;
+
+	// minimize the block together with the minimal configurations found so far
+	auto flush = [&]() {
+		if (result) {
+			result->materialize();
+			for (SetOfConfigurations::const_iterator k = result->confs().begin(); k != result->confs().end(); k++) {
+				block->addConfiguration(*k);
+			}
+		}
+		result = this->minimization(block);
+		block = std::make_shared<ConfigurationSet>(space, name);
+	};
+
+	while (product.next()) {
+		Configuration& c = product.current();
+		bool pass = true;
+		for (std::vector<StreamStagePtr>::const_iterator s = this->stages.begin(); pass && s != this->stages.end(); s++) {
+			pass = (*s)->apply(c);
+		}
+		if (!pass) {
+			continue;
+		}
+		// copy the configuration out of the product into the block
+		block->addConfiguration(block->createConfiguration(space, product.currentConfiguration()));
+		if (this->minimization && block->size() >= this->blockSize) {
+			flush();
+		}
+	}
+
+	if (!this->minimization) {
+		return block;
+	}
+	flush();
+	return result;
+}
+
+
+/// sum of the real values of a configuration, to order configurations from good to bad
+static double sumOfReals(const Configuration& c) {
+	double sum = 0.0;
+	for (ListOfQuantityValues::const_iterator i = c.quantities.begin(); i != c.quantities.end(); i++) {
+		const QuantityValue_Real* r = dynamic_cast<const QuantityValue_Real*>(i->get());
+		if (r) {
+			sum = sum + r->value;
+		}
+	}
+	return sum;
+}
+
+/// a configuration with its sort key
+struct KeyedConfiguration {
+	double key;
+	ConfigurationPtr conf;
+};
+
+/// ProductFront constructor
+ProductFront::ProductFront(ConfigurationSetPtr ca, ConfigurationSetPtr cb) :
+	a(ca),
+	b(cb)
+{
+}
+
+/// append stage 's'
+void ProductFront::addStage(StreamStagePtr s) {
+	this->stages.push_back(s);
+}
+
+/// compute the minimal configurations
+ConfigurationSetPtr ProductFront::run(void) {
+	this->a->materialize();
+	this->b->materialize();
+	this->pruned = 0;
+
+	// prepare the stages and determine the space of the result
+	ConfigurationSpacePtr productspace = this->a->confspace->productWith(this->b->confspace);
+	ConfigurationSpacePtr space = productspace;
+	for (std::vector<StreamStagePtr>::iterator s = this->stages.begin(); s != this->stages.end(); s++) {
+		space = (*s)->prepare(space);
+	}
+	ConfigurationSetPtr front = std::make_shared<ConfigurationSet>(space, "ParetoProduct(" + this->a->name + ", " + this->b->name + ")");
+	ParetoArchive archive(front);
+
+	// sort the first set from good to bad
+	std::vector<KeyedConfiguration> as;
+	as.reserve(this->a->confs().size());
+	for (SetOfConfigurations::const_iterator i = this->a->confs().begin(); i != this->a->confs().end(); i++) {
+		as.push_back({ sumOfReals(**i), *i });
+	}
+	std::stable_sort(as.begin(), as.end(), [](const KeyedConfiguration& x, const KeyedConfiguration& y) { return x.key < y.key; });
+
+	// sort the second set on its unordered quantities, then from good to bad
+	const ConfigurationSpace& bspace = *this->b->confspace;
+	std::vector<unsigned int> unordered;
+	for (unsigned int k = 0; k < bspace.quantities.size(); k++) {
+		if (!bspace.quantities[k]->isTotallyOrdered()) {
+			unordered.push_back(k);
+		}
+	}
+	auto sameGroup = [&unordered](const Configuration& x, const Configuration& y) {
+		for (unsigned int k : unordered) {
+			if (!(*x.quantities[k] == *y.quantities[k])) return false;
+		}
+		return true;
+	};
+	std::vector<KeyedConfiguration> bs;
+	bs.reserve(this->b->confs().size());
+	for (SetOfConfigurations::const_iterator i = this->b->confs().begin(); i != this->b->confs().end(); i++) {
+		bs.push_back({ sumOfReals(**i), *i });
+	}
+	std::stable_sort(bs.begin(), bs.end(), [&unordered](const KeyedConfiguration& x, const KeyedConfiguration& y) {
+		for (unsigned int k : unordered) {
+			const QuantityValue& vx = *x.conf->quantities[k];
+			const QuantityValue& vy = *y.conf->quantities[k];
+			if (vx.qtype.totalOrderSmaller(vx, vy)) return true;
+			if (vy.qtype.totalOrderSmaller(vy, vx)) return false;
+		}
+		return x.key < y.key;
+	});
+
+	// split the second set into groups with their ideal points
+	std::vector<size_t> groupStart;
+	std::vector<ConfigurationPtr> ideals;
+	for (size_t j = 0; j < bs.size(); j++) {
+		const Configuration& cb = *bs[j].conf;
+		if (j == 0 || !sameGroup(*ideals.back(), cb)) {
+			groupStart.push_back(j);
+			ideals.push_back(allocateInArena<Configuration>(nullptr, bs[j].conf));
+			continue;
+		}
+		ListOfQuantityValues& ideal = ideals.back()->quantities;
+		for (unsigned int k = 0; k < bspace.quantities.size(); k++) {
+			if (bspace.quantities[k]->isTotallyOrdered() && !(*ideal[k] <= *cb.quantities[k])) {
+				ideal[k] = cb.quantities[k];
+			}
+		}
+	}
+	groupStart.push_back(bs.size());
+
+	// the current configuration of the product, rebuilt in place for every pair
+	ConfigurationPtr conf = allocateInArena<Configuration>(nullptr, productspace);
+	conf->quantities.reserve(space->quantities.size() + productspace->quantities.size());
+	auto evaluate = [&](const ConfigurationPtr& ca, const ConfigurationPtr& cb) {
+		conf->confspace = productspace;
+		conf->quantities.clear();
+		conf->addQuantitiesOf(ca);
+		conf->addQuantitiesOf(cb);
+		for (std::vector<StreamStagePtr>::const_iterator s = this->stages.begin(); s != this->stages.end(); s++) {
+			if (!(*s)->apply(*conf)) return false;
+		}
+		return true;
+	};
+	auto dominated = [&]() {
+		return archive.isDominated(*conf);
+	};
+
+	for (std::vector<KeyedConfiguration>::const_iterator i = as.begin(); i != as.end(); i++) {
+		for (size_t g = 0; g < ideals.size(); g++) {
+			// skip the group if its bound is dominated
+			if (evaluate(i->conf, ideals[g]) && dominated()) {
+				this->pruned += groupStart[g + 1] - groupStart[g];
+				continue;
+			}
+			for (size_t j = groupStart[g]; j < groupStart[g + 1]; j++) {
+				if (evaluate(i->conf, bs[j].conf) && !dominated()) {
+					archive.insert(front->createConfiguration(space, conf));
+				}
+			}
+		}
+	}
+	return front;
+}
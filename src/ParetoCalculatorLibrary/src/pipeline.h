@@ -0,0 +1,223 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Streaming evaluation of a product of two sets of configurations followed by
+// constraints, aggregations, abstractions, hiding and a minimization
+//
+
+#ifndef PARETO_PIPELINE_H
+#define PARETO_PIPELINE_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "configuration.h"
+#include "support.h"
+
+/// the number of configurations that pass a streaming pipeline before they are minimized
+#define DEFAULT_STREAM_BLOCK 65536
+
+
+namespace Pareto {
+
+	/// Enumerates the configurations of the product of two sets of configurations one at a
+	/// time, without constructing the product. The current configuration is rebuilt in place
+	/// for every step and is only valid until the next call to next().
+	class LazyProduct {
+	public:
+		/// Constructor of the product of 'a' and 'b' in the product space 'productspace'.
+		/// The values of 'a' come first in the configurations of the product.
+		LazyProduct(ConfigurationSetPtr a, ConfigurationSetPtr b, ConfigurationSpacePtr productspace);
+
+		/// the number of configurations of the product
+		size_t size(void) const;
+
+		/// move to the next configuration of the product, returns false when exhausted
+		bool next(void);
+
+		/// the current configuration of the product
+		Configuration& current(void) { return *this->conf; }
+
+		/// the pointer to the current configuration of the product
+		const ConfigurationPtr& currentConfiguration(void) const { return this->conf; }
+
+		/// the configuration space of the product
+		ConfigurationSpacePtr space;
+
+	private:
+		ConfigurationSetPtr a, b;
+		SetOfConfigurations::const_iterator i, j;
+		bool started = false;
+		ConfigurationPtr conf;
+	};
+
+	/// A step of a streaming pipeline that filters or maps configurations one at a time.
+	class StreamStage {
+	public:
+		virtual ~StreamStage() {};
+
+		/// prepare the stage for configurations in space 'in'. Returns the space of the
+		/// configurations the stage produces.
+		virtual ConfigurationSpacePtr prepare(ConfigurationSpacePtr in) = 0;
+
+		/// apply the stage to configuration 'c', in place. Returns false if the configuration
+		/// is to be dropped.
+		virtual bool apply(Configuration& c) const = 0;
+	};
+
+	using StreamStagePtr = std::shared_ptr<StreamStage>;
+
+	/// The producer-consumer constraint as a streaming stage
+	class StreamStage_ProdCons : public StreamStage {
+	public:
+		StreamStage_ProdCons(const std::string& pqname, const std::string& cqname);
+		virtual ConfigurationSpacePtr prepare(ConfigurationSpacePtr in);
+		virtual bool apply(Configuration& c) const;
+	private:
+		std::string p_quant, c_quant;
+		unsigned int p_index = 0, c_index = 0;
+	};
+
+	/// The join constraint on pairs of quantity indices as a streaming stage
+	class StreamStage_Join : public StreamStage {
+	public:
+		StreamStage_Join(const std::vector<int>& qan, const std::vector<int>& qbn);
+		virtual ConfigurationSpacePtr prepare(ConfigurationSpacePtr in);
+		virtual bool apply(Configuration& c) const;
+	private:
+		std::vector<int> qan, qbn;
+	};
+
+	/// The abstraction of a list of quantities as a streaming stage
+	class StreamStage_Abstract : public StreamStage {
+	public:
+		StreamStage_Abstract(const ListOfQuantityNames& qnames);
+		virtual ConfigurationSpacePtr prepare(ConfigurationSpacePtr in);
+		virtual bool apply(Configuration& c) const;
+	private:
+		ListOfQuantityNames lqn;
+		/// the indices of the quantities to remove, each relative to the previous removals
+		std::vector<unsigned int> indices;
+		ConfigurationSpacePtr space;
+	};
+
+	/// The aggregation (sum) of a list of real valued quantities into a new quantity as a streaming stage
+	class StreamStage_Aggregate : public StreamStage {
+	public:
+		StreamStage_Aggregate(const ListOfQuantityNames& ag_quants, const std::string& agname);
+		virtual ConfigurationSpacePtr prepare(ConfigurationSpacePtr in);
+		virtual bool apply(Configuration& c) const;
+	private:
+		ListOfQuantityNames aggregate_quants;
+		std::string newName;
+		std::vector<unsigned int> indices;
+		QuantityTypePtr type;
+		ConfigurationSpacePtr space;
+	};
+
+	/// The hiding of a list of quantities as a streaming stage
+	class StreamStage_Hide : public StreamStage {
+	public:
+		StreamStage_Hide(const ListOfQuantityNames& qnames);
+		virtual ConfigurationSpacePtr prepare(ConfigurationSpacePtr in);
+		virtual bool apply(Configuration& c) const;
+	private:
+		ListOfQuantityNames lqn;
+		ConfigurationSpacePtr space;
+	};
+
+	/// Evaluates a product of two sets of configurations followed by a sequence of streaming
+	/// stages and an optional minimization without constructing the product. The configurations
+	/// that pass all stages are collected in blocks. When a block is full it is minimized
+	/// together with the minimal configurations found so far, so that at most one block and
+	/// the current minimal set are in memory at any time.
+	class ProductPipeline {
+	public:
+		/// a minimization of a set of configurations
+		using Minimization = std::function<ConfigurationSetPtr(ConfigurationSetPtr)>;
+
+		/// Constructor of the pipeline on the product of 'a' and 'b'. The values of 'a' come
+		/// first in the configurations of the product.
+		ProductPipeline(ConfigurationSetPtr a, ConfigurationSetPtr b);
+
+		/// append stage 's' to the pipeline
+		void addStage(StreamStagePtr s);
+
+		/// minimize the result with 'm'
+		void setMinimization(Minimization m);
+
+		/// the number of configurations collected per block before they are minimized
+		size_t blockSize = DEFAULT_STREAM_BLOCK;
+
+		/// run the pipeline and return the resulting set of configurations
+		ConfigurationSetPtr run(void);
+
+	private:
+		ConfigurationSetPtr a, b;
+		std::vector<StreamStagePtr> stages;
+		Minimization minimization;
+	};
+
+	/// Computes the minimal configurations of a product of two sets of configurations followed
+	/// by a sequence of streaming stages. Every configuration that passes the stages goes straight
+	/// into an incremental Pareto front indexed by a ParetoArchive, so memory is bounded by the size of the front.
+	///
+	/// The stages must be monotone: a configuration of the product that is better in every
+	/// quantity must stay better after the stages, which holds for aggregation, abstraction and
+	/// hiding. The configurations of the second set are grouped on their unordered quantities
+	/// and every group is summarized by its ideal point, its best value in every totally ordered
+	/// quantity. Combined with a configuration of the first set, the ideal point bounds all
+	/// configurations of the group, so the whole group is skipped when the front dominates the
+	/// bound. Both sets are sorted on the sum of their real values, so that good configurations
+	/// enter the front early.
+	class ProductFront {
+	public:
+		/// Constructor of the front on the product of 'a' and 'b'. The values of 'a' come
+		/// first in the configurations of the product.
+		ProductFront(ConfigurationSetPtr a, ConfigurationSetPtr b);
+
+		/// append stage 's'
+		void addStage(StreamStagePtr s);
+
+		/// compute the minimal configurations
+		ConfigurationSetPtr run(void);
+
+		/// the number of configurations of the product that were skipped on their bound
+		size_t pruned = 0;
+
+	private:
+		ConfigurationSetPtr a, b;
+		std::vector<StreamStagePtr> stages;
+	};
+
+}
+
+#endif
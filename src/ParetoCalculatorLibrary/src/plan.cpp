@@ -0,0 +1,640 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Implementation of the compilation, optimization and execution of operation plans
+//
+
+#include "plan.h"
+#include "calculator.h"
+#include "columns.h"
+#include "exceptions.h"
+#include <atomic>
+#include <functional>
+#include <set>
+#include <sstream>
+
+using namespace Pareto;
+
+
+/// pop a node from the symbolic stack
+static PlanNodePtr popNode(std::vector<PlanNodePtr>& st) {
+	if (st.empty()) {
+		throw EParetoCalculatorError("Stack is empty in OperationPlan");
+	}
+	PlanNodePtr n = st.back();
+	st.pop_back();
+	return n;
+}
+
+/// compile the operations into a DAG by executing them on a stack of nodes
+OperationPlan::OperationPlan(const ListOfOperations& ops, ParetoCalculator& c) :
+	calculator(c)
+{
+	std::vector<PlanNodePtr> st;
+	// the nodes stored in memory by the operations
+	std::map<std::string, PlanNodePtr> memory;
+
+	for (ListOfOperations::const_iterator i = ops.begin(); i != ops.end(); i++) {
+		const ParetoCalculatorOperationPtr& op = *i;
+		PlanOperation po;
+		po.op = op;
+		if (std::shared_ptr<POperation_Push> push = std::dynamic_pointer_cast<POperation_Push>(op)) {
+			std::map<std::string, PlanNodePtr>::iterator m = memory.find(push->o);
+			po.node = m != memory.end() ? m->second : this->node(op, std::vector<PlanNodePtr>());
+			st.push_back(po.node);
+		}
+		else if (std::shared_ptr<POperation_Store> store = std::dynamic_pointer_cast<POperation_Store>(op)) {
+			PlanNodePtr n = popNode(st);
+			po.effect = (int) this->effects.size();
+			this->effects.push_back({ op, n });
+			memory[store->o] = n;
+		}
+		else if (std::dynamic_pointer_cast<POperation_Print>(op)) {
+			po.effect = (int) this->effects.size();
+			this->effects.push_back({ op, popNode(st) });
+		}
+		else if (std::dynamic_pointer_cast<POperation_Pop>(op)) {
+			popNode(st);
+		}
+		else if (std::dynamic_pointer_cast<POperation_Duplicate>(op)) {
+			PlanNodePtr n = popNode(st);
+			st.push_back(n);
+			st.push_back(n);
+		}
+		else {
+			std::vector<PlanNodePtr> inputs;
+			for (unsigned int k = 0; k < op->arity(); k++) {
+				inputs.push_back(popNode(st));
+			}
+			po.node = this->node(op, inputs);
+			st.push_back(po.node);
+		}
+		this->operations.push_back(po);
+	}
+	this->stack = st;
+}
+
+/// create a node or return an existing node with the same operation and inputs
+PlanNodePtr OperationPlan::node(ParetoCalculatorOperationPtr op, const std::vector<PlanNodePtr>& inputs) {
+	std::string d = op->describe();
+	std::string key;
+	if (!d.empty()) {
+		std::ostringstream k;
+		k << d;
+		for (std::vector<PlanNodePtr>::const_iterator i = inputs.begin(); i != inputs.end(); i++) {
+			k << " " << i->get();
+		}
+		key = k.str();
+		std::map<std::string, PlanNodePtr>::iterator n = this->nodes.find(key);
+		if (n != this->nodes.end()) {
+			return n->second;
+		}
+	}
+	PlanNodePtr n = std::make_shared<PlanNode>();
+	n->op = op;
+	n->inputs = inputs;
+	this->infer(*n);
+	if (!key.empty()) {
+		this->nodes[key] = n;
+	}
+	return n;
+}
+
+/// infer the quantities of the result of node n and whether it is minimal
+void OperationPlan::infer(PlanNode& n) {
+	const ParetoCalculatorOperation* op = n.op.get();
+	auto sameAs = [&n](const PlanNode& in) {
+		n.quantities = in.quantities;
+		n.typed = in.typed;
+	};
+
+	if (const POperation_Push* push = dynamic_cast<const POperation_Push*>(op)) {
+		try {
+			ConfigurationSetPtr cs = this->calculator.retrieveConfigurationSet(push->o);
+			for (QuantityIntMap::const_iterator i = cs->confspace->quantityNames.begin(); i != cs->confspace->quantityNames.end(); i++) {
+				n.quantities[i->first] = cs->confspace->quantities[i->second];
+			}
+			n.typed = true;
+		}
+		catch (EParetoCalculatorError&) {
+			// not a configuration set in memory (yet), the quantities are unknown
+		}
+	}
+	else if (n.inputs.size() == 2 && (dynamic_cast<const POperation_Product*>(op) || dynamic_cast<const POperation_Join*>(op) ||
+		dynamic_cast<const POperation_EfficientJoin*>(op) || dynamic_cast<const POperation_EfficientProdCons*>(op))) {
+		sameAs(*n.inputs[0]);
+		n.quantities.insert(n.inputs[1]->quantities.begin(), n.inputs[1]->quantities.end());
+		n.typed = n.inputs[0]->typed && n.inputs[1]->typed;
+		// the product of minimal sets is minimal
+		n.minimal = dynamic_cast<const POperation_Product*>(op) && n.inputs[0]->minimal && n.inputs[1]->minimal;
+	}
+	else if (n.inputs.size() == 1) {
+		if (const POperation_Abstract* ab = dynamic_cast<const POperation_Abstract*>(op)) {
+			sameAs(*n.inputs[0]);
+			for (ListOfQuantityNames::const_iterator i = ab->lqn.begin(); i != ab->lqn.end(); i++) {
+				n.quantities.erase(*i);
+			}
+		}
+		else if (dynamic_cast<const POperation_Hide*>(op) || dynamic_cast<const POperation_ProdCons*>(op)) {
+			sameAs(*n.inputs[0]);
+		}
+		else if (const POperation_Aggregate* ag = dynamic_cast<const POperation_Aggregate*>(op)) {
+			sameAs(*n.inputs[0]);
+			n.quantities[ag->newName] = std::make_shared<QuantityType_Real>(ag->newName);
+		}
+		else if (const POperation_Derived* dv = dynamic_cast<const POperation_Derived*>(op)) {
+			sameAs(*n.inputs[0]);
+			n.quantities[dv->derivedName()] = std::make_shared<QuantityType_Real>(dv->derivedName());
+		}
+		else if (op->isMinimization()) {
+			sameAs(*n.inputs[0]);
+			n.minimal = true;
+		}
+	}
+}
+
+/// move abstraction or hiding op of the quantities lqn below the product p
+PlanNodePtr OperationPlan::pushBelowProduct(const ParetoCalculatorOperationPtr& op, const ListOfQuantityNames& lqn, const PlanNodePtr& p) {
+	const PlanNodePtr& a = p->inputs[0];
+	const PlanNodePtr& b = p->inputs[1];
+	if (!a->typed || !b->typed) {
+		return nullptr;
+	}
+
+	// every quantity must belong to exactly one of the operands of the product
+	ListOfQuantityNames la, lb;
+	for (ListOfQuantityNames::const_iterator i = lqn.begin(); i != lqn.end(); i++) {
+		bool ina = a->quantities.count(*i) > 0;
+		bool inb = b->quantities.count(*i) > 0;
+		if (ina == inb) {
+			return nullptr;
+		}
+		(ina ? la : lb).push_back(*i);
+	}
+
+	bool abstraction = std::dynamic_pointer_cast<POperation_Abstract>(op) != nullptr;
+	auto below = [&](const PlanNodePtr& in, const ListOfQuantityNames& l) {
+		if (l.empty()) {
+			return in;
+		}
+		ParetoCalculatorOperationPtr o;
+		if (abstraction) {
+			o = std::make_shared<POperation_Abstract>(l);
+		}
+		else {
+			o = std::make_shared<POperation_Hide>(l);
+		}
+		o->message = op->message;
+		return this->node(o, { in });
+	};
+	PlanNodePtr na = below(a, la);
+	PlanNodePtr nb = below(b, lb);
+	return this->node(p->op, { na, nb });
+}
+
+/// the rewriting of node n
+PlanNodePtr OperationPlan::rewrite(const PlanNodePtr& n, std::map<const PlanNode*, PlanNodePtr>& done, std::map<const PlanNode*, size_t>& uses) {
+	std::map<const PlanNode*, PlanNodePtr>::iterator d = done.find(n.get());
+	if (d != done.end()) {
+		return d->second;
+	}
+
+	std::vector<PlanNodePtr> inputs;
+	for (std::vector<PlanNodePtr>::const_iterator i = n->inputs.begin(); i != n->inputs.end(); i++) {
+		inputs.push_back(this->rewrite(*i, done, uses));
+	}
+	const ParetoCalculatorOperationPtr& op = n->op;
+	PlanNodePtr r;
+
+	// a minimization of a set that is already minimal
+	if (op->isMinimization() && inputs.size() == 1 && inputs[0]->minimal) {
+		r = inputs[0];
+	}
+
+	// abstraction or hiding of a product that is not used otherwise
+	if (!r && inputs.size() == 1 && std::dynamic_pointer_cast<POperation_Product>(inputs[0]->op) && uses[n->inputs[0].get()] == 1) {
+		if (std::shared_ptr<POperation_Abstract> ab = std::dynamic_pointer_cast<POperation_Abstract>(op)) {
+			r = this->pushBelowProduct(op, ab->lqn, inputs[0]);
+		}
+		else if (std::shared_ptr<POperation_Hide> hd = std::dynamic_pointer_cast<POperation_Hide>(op)) {
+			r = this->pushBelowProduct(op, hd->lqn, inputs[0]);
+		}
+	}
+
+	// a join on quantities of the same type that can be hashed
+	std::shared_ptr<POperation_Join> join = std::dynamic_pointer_cast<POperation_Join>(op);
+	if (!r && join && inputs[0]->typed && inputs[1]->typed) {
+		bool sortable = true;
+		for (JoinMap::const_iterator i = join->j_quants.begin(); sortable && i != join->j_quants.end(); i++) {
+			std::map<QuantityName, QuantityTypePtr>::const_iterator ta = inputs[0]->quantities.find(i->first);
+			std::map<QuantityName, QuantityTypePtr>::const_iterator tb = inputs[1]->quantities.find(i->second);
+			sortable = ta != inputs[0]->quantities.end() && tb != inputs[1]->quantities.end() && ta->second == tb->second;
+			if (sortable) {
+				try {
+					columnKindOf(*ta->second);
+				}
+				catch (EParetoCalculatorError&) {
+					sortable = false;
+				}
+			}
+		}
+		if (sortable) {
+			ParetoCalculatorOperationPtr ej = std::make_shared<POperation_EfficientJoin>(join->j_quants);
+			ej->message = "efficient join on multiple attributes\n";
+			r = this->node(ej, inputs);
+		}
+	}
+
+	if (!r) {
+		r = this->node(op, inputs);
+	}
+	done[n.get()] = r;
+	return r;
+}
+
+/// optimize the plan by rewriting all roots
+void OperationPlan::optimize(void) {
+	std::map<const PlanNode*, PlanNodePtr> done;
+	std::map<const PlanNode*, size_t> uses = this->countUses();
+	for (std::vector<PlanEffect>::iterator e = this->effects.begin(); e != this->effects.end(); e++) {
+		e->node = this->rewrite(e->node, done, uses);
+	}
+	for (std::vector<PlanNodePtr>::iterator n = this->stack.begin(); n != this->stack.end(); n++) {
+		*n = this->rewrite(*n, done, uses);
+	}
+	this->optimized = true;
+}
+
+/// the live nodes in an order in which inputs precede their uses
+std::vector<PlanNodePtr> OperationPlan::liveNodes(void) const {
+	std::vector<PlanNodePtr> order;
+	std::set<const PlanNode*> visited;
+	std::function<void(const PlanNodePtr&)> visit = [&](const PlanNodePtr& n) {
+		if (!visited.insert(n.get()).second) return;
+		for (std::vector<PlanNodePtr>::const_iterator i = n->inputs.begin(); i != n->inputs.end(); i++) {
+			visit(*i);
+		}
+		order.push_back(n);
+	};
+	for (std::vector<PlanEffect>::const_iterator e = this->effects.begin(); e != this->effects.end(); e++) {
+		visit(e->node);
+	}
+	for (std::vector<PlanNodePtr>::const_iterator n = this->stack.begin(); n != this->stack.end(); n++) {
+		visit(*n);
+	}
+	return order;
+}
+
+/// the number of uses of every live node by other nodes, effects and the stack
+std::map<const PlanNode*, size_t> OperationPlan::countUses(void) const {
+	std::map<const PlanNode*, size_t> uses;
+	std::vector<PlanNodePtr> live = this->liveNodes();
+	for (std::vector<PlanNodePtr>::const_iterator n = live.begin(); n != live.end(); n++) {
+		for (std::vector<PlanNodePtr>::const_iterator i = (*n)->inputs.begin(); i != (*n)->inputs.end(); i++) {
+			uses[i->get()]++;
+		}
+	}
+	for (std::vector<PlanEffect>::const_iterator e = this->effects.begin(); e != this->effects.end(); e++) {
+		uses[e->node.get()]++;
+	}
+	for (std::vector<PlanNodePtr>::const_iterator n = this->stack.begin(); n != this->stack.end(); n++) {
+		uses[n->get()]++;
+	}
+	return uses;
+}
+
+/// the number of live nodes
+size_t OperationPlan::size(void) const {
+	return this->liveNodes().size();
+}
+
+/// execute the plan on calculator c
+void OperationPlan::executeOn(ParetoCalculator& c, TaskPool* pool) {
+	if (pool != nullptr) {
+		this->executeConcurrentlyOn(c, *pool);
+		return;
+	}
+
+	std::vector<PlanNodePtr> live = this->liveNodes();
+	std::map<const PlanNode*, size_t> uses = this->countUses();
+	std::map<const PlanNode*, StorableObjectPtr> results;
+
+	// release the result of node n after its last use
+	auto release = [&](const PlanNodePtr& n) {
+		if (--uses[n.get()] == 0) {
+			results.erase(n.get());
+		}
+	};
+	std::function<StorableObjectPtr(const PlanNodePtr&)> evaluate = [&](const PlanNodePtr& n) {
+		std::map<const PlanNode*, StorableObjectPtr>::iterator r = results.find(n.get());
+		if (r != results.end()) {
+			return r->second;
+		}
+		std::vector<StorableObjectPtr> args;
+		for (std::vector<PlanNodePtr>::const_iterator i = n->inputs.begin(); i != n->inputs.end(); i++) {
+			args.push_back(evaluate(*i));
+		}
+		// push the arguments so that the first input ends on top of the stack
+		for (std::vector<StorableObjectPtr>::reverse_iterator a = args.rbegin(); a != args.rend(); a++) {
+			c.push(*a);
+		}
+		n->op->announce(c);
+		c.execute(*n->op);
+		StorableObjectPtr result = c.pop();
+		results[n.get()] = result;
+		for (std::vector<PlanNodePtr>::const_iterator i = n->inputs.begin(); i != n->inputs.end(); i++) {
+			release(*i);
+		}
+		return result;
+	};
+
+	// retrieve the objects from memory before any of them is overwritten by a store
+	for (std::vector<PlanNodePtr>::const_iterator n = live.begin(); n != live.end(); n++) {
+		if ((*n)->inputs.empty()) {
+			evaluate(*n);
+		}
+	}
+
+	// perform the side effects in order
+	for (std::vector<PlanEffect>::const_iterator e = this->effects.begin(); e != this->effects.end(); e++) {
+		c.push(evaluate(e->node));
+		e->op->announce(c);
+		c.execute(*e->op);
+		release(e->node);
+	}
+
+	// leave the remaining results on the stack
+	for (std::vector<PlanNodePtr>::const_iterator n = this->stack.begin(); n != this->stack.end(); n++) {
+		c.push(evaluate(*n));
+	}
+}
+
+/// stream a listing of the plan to os
+void OperationPlan::streamOn(std::ostream& os) const {
+	std::vector<PlanNodePtr> live = this->liveNodes();
+	std::map<const PlanNode*, size_t> ids;
+	for (std::vector<PlanNodePtr>::const_iterator n = live.begin(); n != live.end(); n++) {
+		size_t id = ids.size() + 1;
+		ids[n->get()] = id;
+		std::string d = (*n)->op->describe();
+		if (d.empty()) {
+			d = (*n)->op->message.substr(0, (*n)->op->message.find('\n'));
+		}
+		os << "%" << id << " = " << d;
+		for (std::vector<PlanNodePtr>::const_iterator i = (*n)->inputs.begin(); i != (*n)->inputs.end(); i++) {
+			os << (i == (*n)->inputs.begin() ? " (" : ", ") << "%" << ids[i->get()];
+		}
+		os << ((*n)->inputs.empty() ? "" : ")") << std::endl;
+	}
+	for (std::vector<PlanEffect>::const_iterator e = this->effects.begin(); e != this->effects.end(); e++) {
+		os << e->op->describe() << " %" << ids[e->node.get()] << std::endl;
+	}
+	for (std::vector<PlanNodePtr>::const_iterator n = this->stack.begin(); n != this->stack.end(); n++) {
+		os << "stack %" << ids[n->get()] << std::endl;
+	}
+}
+
+/// make a shared columnar configuration set safe to read concurrently
+static void prepareForSharing(const StorableObjectPtr& o) {
+	if (o->isConfigurationSet()) {
+		ConfigurationSetPtr cs = std::dynamic_pointer_cast<ConfigurationSet>(o);
+		if (cs->isColumnar()) {
+			cs->materialize();
+		}
+	}
+}
+
+/// execute the plan on calculator c, computing the nodes as tasks on the pool
+void OperationPlan::executeConcurrentlyOn(ParetoCalculator& c, TaskPool& pool) {
+	std::vector<PlanNodePtr> live = this->liveNodes();
+	std::map<const PlanNode*, size_t> uses = this->countUses();
+
+	// the state of every live node, allocated before any task is submitted
+	class NodeState {
+	public:
+		StorableObjectPtr result;
+		TaskPtr task;
+		std::atomic<size_t> uses{ 0 };
+		/// the number of inputs computed by tasks that have not finished
+		std::atomic<size_t> pending{ 0 };
+		/// the nodes that use the result, once for every use as an input
+		std::vector<size_t> consumers;
+		/// the exception raised by the node or one of its inputs, if any
+		std::exception_ptr error;
+	};
+	std::vector<NodeState> states(live.size());
+	std::map<const PlanNode*, size_t> index;
+	for (size_t k = 0; k < live.size(); k++) {
+		index[live[k].get()] = k;
+		states[k].uses = uses[live[k].get()];
+		for (std::vector<PlanNodePtr>::const_iterator i = live[k]->inputs.begin(); i != live[k]->inputs.end(); i++) {
+			size_t a = index.at(i->get());
+			if (!(*i)->inputs.empty()) {
+				states[k].pending++;
+				states[a].consumers.push_back(k);
+			}
+		}
+	}
+
+	// release the result of node k after its last use
+	auto release = [&](size_t k) {
+		if (--states[k].uses == 0) {
+			states[k].result.reset();
+		}
+	};
+	auto await = [&](size_t k) {
+		if (states[k].task) {
+			pool.join(states[k].task);
+		}
+	};
+
+	// the order in which the sequential execution announces the nodes and performs the
+	// effects. An optimized plan announces the loads first, then the effects, each after the
+	// nodes it depends on. Otherwise the operations are announced in their original order.
+	enum class Step { Node, Operation, Effect, Stack };
+	std::vector<std::pair<Step, size_t>> schedule;
+	std::vector<bool> scheduled(live.size(), false);
+	std::function<void(const PlanNodePtr&)> visit = [&](const PlanNodePtr& n) {
+		size_t k = index[n.get()];
+		if (scheduled[k]) return;
+		for (std::vector<PlanNodePtr>::const_iterator i = n->inputs.begin(); i != n->inputs.end(); i++) {
+			visit(*i);
+		}
+		scheduled[k] = true;
+		schedule.push_back(std::make_pair(Step::Node, k));
+	};
+	if (this->optimized) {
+		for (std::vector<PlanNodePtr>::const_iterator n = live.begin(); n != live.end(); n++) {
+			if ((*n)->inputs.empty()) {
+				visit(*n);
+			}
+		}
+		for (size_t e = 0; e < this->effects.size(); e++) {
+			visit(this->effects[e].node);
+			schedule.push_back(std::make_pair(Step::Effect, e));
+		}
+	}
+	else {
+		for (size_t o = 0; o < this->operations.size(); o++) {
+			const PlanOperation& po = this->operations[o];
+			if (po.effect >= 0) {
+				schedule.push_back(std::make_pair(Step::Effect, (size_t) po.effect));
+			}
+			else {
+				schedule.push_back(std::make_pair(Step::Operation, o));
+			}
+		}
+	}
+	for (size_t s = 0; s < this->stack.size(); s++) {
+		if (this->optimized) {
+			visit(this->stack[s]);
+		}
+		schedule.push_back(std::make_pair(Step::Stack, s));
+	}
+
+	// retrieve the objects from memory before any of them is overwritten by a store
+	for (size_t k = 0; k < live.size(); k++) {
+		if (live[k]->inputs.empty()) {
+			c.execute(*live[k]->op);
+			states[k].result = c.pop();
+			if (states[k].uses > 1) {
+				prepareForSharing(states[k].result);
+			}
+		}
+	}
+
+	// create a task per computed node. A task is submitted when the last of the tasks of its
+	// inputs finishes, so that no task waits for another one. Waiting in a task could deadlock,
+	// because a thread that joins a task runs other tasks, possibly one that uses the result of a
+	// task lower on its own stack. Every task computes its node on a private calculator.
+	for (size_t k = 0; k < live.size(); k++) {
+		if (live[k]->inputs.empty()) continue;
+		states[k].task = std::make_shared<Task>([&, k]() {
+			// the node is profiled as an operation of its own, also when it runs in a join
+			ProfileContinuation node(0, nullptr);
+			const PlanNodePtr& n = live[k];
+			std::vector<size_t> args;
+			for (std::vector<PlanNodePtr>::const_iterator i = n->inputs.begin(); i != n->inputs.end(); i++) {
+				args.push_back(index.at(i->get()));
+			}
+			try {
+				for (std::vector<size_t>::const_iterator a = args.begin(); a != args.end(); a++) {
+					if (states[*a].error) {
+						std::rethrow_exception(states[*a].error);
+					}
+				}
+				ParetoCalculator w;
+				w.storageMode = c.storageMode;
+				w.tuner = c.tuner;
+				w.profilingObject = c.profilingObject;
+				w.trace = c.trace;
+				for (std::vector<size_t>::reverse_iterator a = args.rbegin(); a != args.rend(); a++) {
+					w.push(states[*a].result);
+				}
+				w.execute(*n->op);
+				StorableObjectPtr result = w.pop();
+				if (states[k].uses > 1) {
+					prepareForSharing(result);
+				}
+				states[k].result = result;
+			}
+			catch (...) {
+				states[k].error = std::current_exception();
+			}
+			for (std::vector<size_t>::const_iterator a = args.begin(); a != args.end(); a++) {
+				release(*a);
+			}
+			// the uses of a failed node are submitted as well, they fail with its exception
+			for (std::vector<size_t>::const_iterator u = states[k].consumers.begin(); u != states[k].consumers.end(); u++) {
+				if (--states[*u].pending == 0) {
+					pool.submit(states[*u].task);
+				}
+			}
+			if (states[k].error) {
+				std::rethrow_exception(states[k].error);
+			}
+		});
+	}
+	std::vector<size_t> ready;
+	for (size_t k = 0; k < live.size(); k++) {
+		if (states[k].task && states[k].pending == 0) {
+			ready.push_back(k);
+		}
+	}
+	for (std::vector<size_t>::const_iterator k = ready.begin(); k != ready.end(); k++) {
+		pool.submit(states[*k].task);
+	}
+
+	// follow the sequential order for the messages and the effects on the calculator
+	try {
+		for (std::vector<std::pair<Step, size_t>>::const_iterator s = schedule.begin(); s != schedule.end(); s++) {
+			if (s->first == Step::Node) {
+				await(s->second);
+				live[s->second]->op->announce(c);
+			}
+			else if (s->first == Step::Operation) {
+				// a failure is reported after the message of the operation that computes it
+				const PlanOperation& po = this->operations[s->second];
+				po.op->announce(c);
+				if (po.node) {
+					std::map<const PlanNode*, size_t>::const_iterator k = index.find(po.node.get());
+					if (k != index.end()) {
+						await(k->second);
+					}
+				}
+			}
+			else if (s->first == Step::Effect) {
+				const PlanEffect& e = this->effects[s->second];
+				size_t k = index[e.node.get()];
+				await(k);
+				c.push(states[k].result);
+				e.op->announce(c);
+				c.execute(*e.op);
+				release(k);
+			}
+			else {
+				size_t k = index[this->stack[s->second].get()];
+				await(k);
+				c.push(states[k].result);
+			}
+		}
+	}
+	catch (...) {
+		// no task may outlive the states it refers to
+		for (std::vector<NodeState>::iterator st = states.begin(); st != states.end(); st++) {
+			try {
+				if (st->task) pool.join(st->task);
+			}
+			catch (...) {
+			}
+		}
+		throw;
+	}
+}
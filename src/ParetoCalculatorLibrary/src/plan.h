@@ -0,0 +1,162 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Compilation of a sequence of stack operations into an expression DAG that can be
+// optimized, printed and executed
+//
+
+#ifndef PARETO_PLAN_H
+#define PARETO_PLAN_H
+
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "operations.h"
+#include "taskpool.h"
+
+
+namespace Pareto {
+
+	class PlanNode;
+	using PlanNodePtr = std::shared_ptr<PlanNode>;
+
+	/// A node of an operation plan: the result of an operation applied to the results of its
+	/// input nodes
+	class PlanNode {
+	public:
+		/// the operation that computes the result from the inputs on the stack
+		ParetoCalculatorOperationPtr op;
+
+		/// the inputs in the order they are popped by the operation, inputs[0] is on top of the stack
+		std::vector<PlanNodePtr> inputs;
+
+		/// the quantities of the result and their types, valid if 'typed' is true
+		std::map<QuantityName, QuantityTypePtr> quantities;
+		bool typed = false;
+
+		/// true if the result is known to be a minimal set of configurations
+		bool minimal = false;
+	};
+
+	/// A side effect of a plan: a store or print operation on the result of a node
+	class PlanEffect {
+	public:
+		ParetoCalculatorOperationPtr op;
+		PlanNodePtr node;
+	};
+
+	/// An operation of the sequence a plan is compiled from
+	class PlanOperation {
+	public:
+		ParetoCalculatorOperationPtr op;
+		/// the node of the result the operation leaves on the stack, nullptr if there is none
+		PlanNodePtr node;
+		/// the index of the side effect of the operation, -1 if it has none
+		int effect = -1;
+	};
+
+	/// An expression DAG compiled from a sequence of operations on the stack of a calculator.
+	///
+	/// The operations are interpreted symbolically: the stack holds nodes instead of objects.
+	/// Duplicates and stores followed by pushes of the same name share a node, and nodes with the
+	/// same operation (see ParetoCalculatorOperation::describe) on the same inputs are merged.
+	/// Stores and prints are the side effects of the plan, together with the objects left on
+	/// the stack they are the roots of the DAG; results that do not reach a root are dead and
+	/// never computed.
+	class OperationPlan {
+	public:
+		/// compile the operations 'ops' for calculator 'c'. The quantities of the objects that
+		/// are pushed from memory are taken from the current memory of the calculator.
+		OperationPlan(const ListOfOperations& ops, ParetoCalculator& c);
+
+		/// rewrite the plan: remove minimizations of sets that are already minimal, move
+		/// abstractions and hiding below products and replace joins on sortable quantities
+		/// by efficient (hash) joins
+		void optimize(void);
+
+		/// execute the plan on calculator 'c'. Every live node is computed once and its result
+		/// is released after its last use. If 'pool' is not nullptr, independent nodes are
+		/// computed concurrently on the pool, while the progress messages, stores, prints and
+		/// the results left on the stack follow the order of the sequential execution of the
+		/// plan, or of the original operations if the plan is not optimized.
+		void executeOn(ParetoCalculator& c, TaskPool* pool = nullptr);
+
+		/// the number of live nodes of the plan
+		size_t size(void) const;
+
+		/// stream a listing of the live nodes and side effects of the plan to 'os'
+		void streamOn(std::ostream& os) const;
+
+	private:
+		/// the operations the plan is compiled from
+		std::vector<PlanOperation> operations;
+
+		/// true if the plan is rewritten by optimize
+		bool optimized = false;
+
+		/// the side effects in the order of the operations
+		std::vector<PlanEffect> effects;
+
+		/// the nodes left on the stack, the bottom first
+		std::vector<PlanNodePtr> stack;
+
+		/// the nodes by the description of their operation and inputs
+		std::map<std::string, PlanNodePtr> nodes;
+
+		/// the memory of the calculator, for the types of the objects that are pushed
+		ParetoCalculator& calculator;
+
+		/// create a node or return an existing node with the same operation and inputs
+		PlanNodePtr node(ParetoCalculatorOperationPtr op, const std::vector<PlanNodePtr>& inputs);
+
+		/// infer the quantities of the result of node 'n' and whether it is minimal
+		void infer(PlanNode& n);
+
+		/// the rewriting of node 'n'
+		PlanNodePtr rewrite(const PlanNodePtr& n, std::map<const PlanNode*, PlanNodePtr>& done, std::map<const PlanNode*, size_t>& uses);
+
+		/// move abstraction or hiding 'op' below the product 'p', returns nullptr if not possible
+		PlanNodePtr pushBelowProduct(const ParetoCalculatorOperationPtr& op, const ListOfQuantityNames& lqn, const PlanNodePtr& p);
+
+		/// the live nodes in an order in which inputs precede their uses
+		std::vector<PlanNodePtr> liveNodes(void) const;
+
+		/// the number of uses of every live node
+		std::map<const PlanNode*, size_t> countUses(void) const;
+
+		/// execute the plan on calculator 'c' with the nodes computed as tasks on 'pool'
+		void executeConcurrentlyOn(ParetoCalculator& c, TaskPool& pool);
+	};
+
+}
+
+#endif
@@ -0,0 +1,137 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Implements the measurement of the profiles of operations and algebra functions
+//
+
+#include "profiling.h"
+#include <algorithm>
+#include <exception>
+
+
+namespace Pareto {
+
+	ProfileScope::ProfileScope(ProfilingCallback* cb, const std::string& name) {
+		if (cb == nullptr) return;
+		this->callback = cb;
+		this->profile.name = name;
+		this->profile.level = 0;
+		this->outerLevel = ProfileScope::level;
+		ProfileScope::level = 1;
+		this->start();
+	}
+
+	ProfileScope::ProfileScope(const char* name, size_t inputSize) {
+		// only the outermost algebra function of an operation is measured
+		if (ProfileScope::current == nullptr || ProfileScope::level != 1) return;
+		this->callback = ProfileScope::current;
+		this->profile.name = name;
+		this->profile.level = 1;
+		this->profile.inputSize = inputSize;
+		this->outerLevel = ProfileScope::level;
+		ProfileScope::level = 2;
+		this->start();
+	}
+
+	void ProfileScope::start(void) {
+		this->outerCallback = ProfileScope::current;
+		ProfileScope::current = this->callback;
+		this->startDepth = ProfileCounters::depth;
+		this->outerMaxDepth = ProfileCounters::maxDepth;
+		ProfileCounters::maxDepth = ProfileCounters::depth;
+		this->dominanceTests = ProfileCounters::dominanceTests;
+		this->allocations = ProfileCounters::allocations;
+		this->uncaughtExceptions = std::uncaught_exceptions();
+		this->startTime = std::chrono::steady_clock::now();
+	}
+
+	ProfileScope::~ProfileScope() {
+		if (this->callback == nullptr) return;
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - this->startTime;
+		this->profile.seconds = elapsed.count();
+		this->profile.dominanceTests = ProfileCounters::dominanceTests - this->dominanceTests;
+		this->profile.allocations = ProfileCounters::allocations - this->allocations;
+		this->profile.recursionDepth = ProfileCounters::maxDepth - this->startDepth;
+		ProfileCounters::maxDepth = std::max(this->outerMaxDepth, ProfileCounters::maxDepth);
+		ProfileScope::current = this->outerCallback;
+		ProfileScope::level = this->outerLevel;
+		if (std::uncaught_exceptions() > this->uncaughtExceptions) return;
+		try {
+			this->callback->profile(this->profile);
+		}
+		catch (...) {
+			// a destructor must not throw
+		}
+	}
+
+	void ProfileTransfer::addToCounters(void) const {
+		ProfileCounters::dominanceTests += this->dominanceTests;
+		ProfileCounters::joinedTests += this->dominanceTests;
+		ProfileCounters::allocations += this->allocations;
+		ProfileCounters::maxDepth = std::max(ProfileCounters::maxDepth, this->maxDepth);
+	}
+
+	ProfileContinuation::ProfileContinuation(unsigned int d, ProfileTransfer* t) :
+		transfer(t),
+		outerTests(ProfileCounters::dominanceTests),
+		outerJoinedTests(ProfileCounters::joinedTests),
+		outerAllocations(ProfileCounters::allocations),
+		outerDepth(ProfileCounters::depth),
+		outerMaxDepth(ProfileCounters::maxDepth),
+		outerTask(ProfileCounters::task),
+		outerCallback(ProfileScope::current),
+		outerLevel(ProfileScope::level)
+	{
+		ProfileCounters::depth = d;
+		ProfileCounters::maxDepth = d;
+		ProfileCounters::task = this;
+		// the task is not part of an operation that the thread may be executing
+		ProfileScope::current = nullptr;
+		ProfileScope::level = 0;
+	}
+
+	ProfileContinuation::~ProfileContinuation() {
+		if (this->transfer != nullptr) {
+			this->transfer->dominanceTests = ProfileCounters::dominanceTests - this->outerTests;
+			this->transfer->allocations = ProfileCounters::allocations - this->outerAllocations;
+			this->transfer->maxDepth = ProfileCounters::maxDepth;
+		}
+		// leave the counters of the thread as they were before the task
+		ProfileCounters::dominanceTests = this->outerTests;
+		ProfileCounters::joinedTests = this->outerJoinedTests;
+		ProfileCounters::allocations = this->outerAllocations;
+		ProfileCounters::depth = this->outerDepth;
+		ProfileCounters::maxDepth = this->outerMaxDepth;
+		ProfileCounters::task = this->outerTask;
+		ProfileScope::current = this->outerCallback;
+		ProfileScope::level = this->outerLevel;
+	}
+
+}
@@ -0,0 +1,211 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Profiling of the operations of the calculator and of the static algebra functions
+//
+
+#ifndef PARETO_PROFILING_H
+#define PARETO_PROFILING_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+
+namespace Pareto {
+
+	/// The measurements of an operation executed by the calculator or of a static algebra
+	/// function called by it
+	class OperationProfile {
+	public:
+		/// the description of the operation or the name of the function
+		std::string name;
+		/// 0 for an operation, 1 for an algebra function called by an operation. Algebra
+		/// functions called by other algebra functions are included in the profile of their caller.
+		unsigned int level = 0;
+		/// the wall-clock time in seconds
+		double seconds = 0.0;
+		/// the number of configurations of the operands
+		size_t inputSize = 0;
+		/// the number of configurations of the results
+		size_t outputSize = 0;
+		/// the number of dominance tests between configurations. A test against the staircase of
+		/// a sweep counts as one test, a block of the DominanceFilter as a test per configuration.
+		unsigned long long dominanceTests = 0;
+		/// the number of allocations of configurations, lists of quantity values and quantity values,
+		/// in an arena or on the heap. The columns of sets in columnar storage mode are not counted.
+		unsigned long long allocations = 0;
+		/// the maximum depth of the divide-and-conquer recursion of a minimization
+		unsigned int recursionDepth = 0;
+	};
+
+	/// An abstract superclass from which to derive objects that collect the profiles of the
+	/// operations executed by the calculator. Register the object with
+	/// ParetoCalculator::setProfilingCallbackObject.
+	class ProfilingCallback {
+	public:
+		virtual ~ProfilingCallback() {};
+		/// called when an operation or algebra function completes. The operations of a
+		/// concurrent plan report from the threads of the task pool, at the same time.
+		virtual void profile(const OperationProfile& p) = 0;
+	};
+
+	/// The counters of the work of the current thread from which the profiles are computed.
+	/// The work of the tasks of a parallel algorithm is added to the thread that forks them
+	/// when it joins them (see ProfileTransfer).
+	class ProfileCounters {
+	public:
+		/// dominance tests between configurations
+		static inline thread_local unsigned long long dominanceTests = 0;
+		/// allocations of the objects of configurations, counted by ArenaAllocator
+		static inline thread_local unsigned long long allocations = 0;
+		/// the current depth of the divide-and-conquer recursion
+		static inline thread_local unsigned int depth = 0;
+		/// the maximum depth reached in the innermost profile
+		static inline thread_local unsigned int maxDepth = 0;
+		/// the dominance tests of the joined tasks, included in dominanceTests
+		static inline thread_local unsigned long long joinedTests = 0;
+		/// the task continued on this thread (see ProfileContinuation), nullptr outside tasks
+		static inline thread_local const void* task = nullptr;
+	};
+
+	/// Measures an operation or an algebra function from construction to destruction and
+	/// reports the profile to the callback. A scope that is left by an exception does not report.
+	class ProfileScope {
+	public:
+		/// profile the operation described by 'name' for 'callback'. Nothing is measured if
+		/// 'callback' is nullptr.
+		ProfileScope(ProfilingCallback* callback, const std::string& name);
+
+		/// profile the algebra function 'name' with operands of 'inputSize' configurations for
+		/// the operation profiled on this thread, unless it is called by another algebra function
+		ProfileScope(const char* name, size_t inputSize);
+
+		~ProfileScope();
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+		/// test if the scope is measured
+		bool active(void) const { return this->callback != nullptr; }
+
+		/// set the number of configurations of the operands
+		void setInputSize(size_t n) { this->profile.inputSize = n; }
+
+		/// set the number of configurations of the results
+		void setOutputSize(size_t n) { this->profile.outputSize = n; }
+
+		/// record the size of the resulting configuration set 'cs', if any, and return it
+		template <class SetPtr>
+		SetPtr result(SetPtr cs) {
+			if (this->active() && cs) this->setOutputSize(cs->size());
+			return cs;
+		}
+
+	private:
+		friend class ProfileContinuation;
+
+		/// start the measurements
+		void start(void);
+
+		/// the callback of the scope, nullptr if the scope is not measured
+		ProfilingCallback* callback = nullptr;
+		/// the callback and level of the enclosing scope of the thread
+		ProfilingCallback* outerCallback = nullptr;
+		unsigned int outerLevel = 0;
+		/// the recursion depth at the start and the maximum depth of the enclosing scope
+		unsigned int startDepth = 0;
+		unsigned int outerMaxDepth = 0;
+		/// the counters at the start
+		unsigned long long dominanceTests = 0;
+		unsigned long long allocations = 0;
+		int uncaughtExceptions = 0;
+		std::chrono::steady_clock::time_point startTime;
+		OperationProfile profile;
+
+		/// the callback of the operation profiled on this thread and the number of measured scopes
+		static inline thread_local ProfilingCallback* current = nullptr;
+		static inline thread_local unsigned int level = 0;
+	};
+
+	/// Counts a level of the divide-and-conquer recursion of a minimization for the profile
+	/// of the enclosing scope
+	class ProfileRecursion {
+	public:
+		ProfileRecursion() {
+			if (++ProfileCounters::depth > ProfileCounters::maxDepth) {
+				ProfileCounters::maxDepth = ProfileCounters::depth;
+			}
+		}
+		~ProfileRecursion() { ProfileCounters::depth--; }
+	};
+
+	/// The work of a task of a parallel algorithm, which may run on any thread of the task pool.
+	/// The thread that forks the task adds the work to its own counters after joining it.
+	class ProfileTransfer {
+	public:
+		/// add the work of the joined task to the counters of the current thread
+		void addToCounters(void) const;
+
+	private:
+		friend class ProfileContinuation;
+		unsigned long long dominanceTests = 0;
+		unsigned long long allocations = 0;
+		unsigned int maxDepth = 0;
+	};
+
+	/// Continues the divide-and-conquer recursion at depth 'd' in a task of a parallel
+	/// algorithm. The work of the task is not counted by the thread that happens to run it,
+	/// but collected in 'transfer' for the thread that forked the task, if it is not nullptr.
+	class ProfileContinuation {
+	public:
+		ProfileContinuation(unsigned int d, ProfileTransfer* transfer);
+		~ProfileContinuation();
+
+		ProfileContinuation(const ProfileContinuation&) = delete;
+		ProfileContinuation& operator=(const ProfileContinuation&) = delete;
+
+	private:
+		ProfileTransfer* transfer;
+		/// the counters of the thread before the task
+		unsigned long long outerTests;
+		unsigned long long outerJoinedTests;
+		unsigned long long outerAllocations;
+		unsigned int outerDepth;
+		unsigned int outerMaxDepth;
+		const void* outerTask;
+		/// the profiled operation of the thread before the task
+		ProfilingCallback* outerCallback;
+		unsigned int outerLevel;
+	};
+
+}
+
+#endif
@@ -33,6 +33,7 @@
 
 
 #include <sstream>
+#include <algorithm>
 #include "quantity.h"
 #include "calculator.h"
 
@@ -89,11 +90,39 @@ namespace Pareto {
 	QuantityType_Enum::QuantityType_Enum(std::string n) : QuantityType(n) {
 	}
 
+	QuantityType_Enum::QuantityType_Enum(const QuantityType_Enum& t) :
+		QuantityType(t),
+		names(t.names),
+		ranks(t.ranks),
+		order(t.order)
+	{
+		// the values of 't' refer to 't', create our own
+		for (unsigned int i = 0; i < names.size(); i++) {
+			quantities.push_back(QuantityValue_EnumPtr(new QuantityValue_Enum(*this, i)));
+		}
+	}
+
 	void QuantityType_Enum::addQuantity(std::string s) {
 		names.push_back(s);
-		quantities.push_back(std::make_shared<QuantityValue_Enum>(*this, s));
+		quantities.push_back(QuantityValue_EnumPtr(new QuantityValue_Enum(*this, (unsigned int)(names.size() - 1))));
+
+		// insert the value in the alphabetical order, after equal names, and renumber the
+		// ranks of the values that follow it
+		unsigned int n = (unsigned int)(names.size() - 1);
+		std::vector<unsigned int>::iterator p = std::upper_bound(order.begin(), order.end(), n,
+			[this](unsigned int a, unsigned int b) { return names[a] < names[b]; });
+		p = order.insert(p, n);
+		ranks.resize(names.size());
+		for (unsigned int r = (unsigned int)(p - order.begin()); r < order.size(); r++) ranks[order[r]] = r;
 	};
 
+	QuantityValue_EnumPtr QuantityType_Enum::valueWithIndex(unsigned int n) const {
+		if (n >= quantities.size()) {
+			throw EParetoCalculatorError("Value index out of range in quantity type " + name);
+		}
+		return quantities[n];
+	}
+
 
 	void QuantityType_Enum::streamOn(std::ostream& os) const {
 		QuantityType::streamOn(os);
@@ -124,33 +153,28 @@ namespace Pareto {
 
 
 	bool QuantityType_Enum::compare(const QuantityValue& q1, const QuantityValue& q2) const {
-		unsigned int s = (unsigned int) quantities.size();
-		for (unsigned int i = 0; i < s; i++) {
-			if (*quantities[i] == q1) return true;
-			if (*quantities[i] == q2) return false;
-		}
-		throw EParetoCalculatorError("Error in QuantityType_Enum::compare");
-		return false;
+		// values are ordered by their position in the type
+#ifdef _DEBUG
+		return dynamic_cast<const QuantityValue_Enum&>(q1).code <= dynamic_cast<const QuantityValue_Enum&>(q2).code;
+#else
+		return ((const QuantityValue_Enum&)(q1)).code <= ((const QuantityValue_Enum&)(q2)).code;
+#endif
 	}
 
 	bool QuantityType_Enum::equal(const QuantityValue& q1, const QuantityValue& q2) const {
 #ifdef _DEBUG
-		const QuantityValue_Enum qe1 = dynamic_cast<const QuantityValue_Enum&>(q1);
-		const QuantityValue_Enum qe2 = dynamic_cast<const QuantityValue_Enum&>(q2);
+		return dynamic_cast<const QuantityValue_Enum&>(q1).code == dynamic_cast<const QuantityValue_Enum&>(q2).code;
 #else
-		const QuantityValue_Enum qe1 = (const QuantityValue_Enum&)(q1);
-		const QuantityValue_Enum qe2 = (const QuantityValue_Enum&)(q2);
+		return ((const QuantityValue_Enum&)(q1)).code == ((const QuantityValue_Enum&)(q2)).code;
 #endif
-		return (qe1.value == qe2.value);
 	}
 
 	bool QuantityType_Enum::totalOrderSmaller(const QuantityValue& v1, const QuantityValue& v2) const {
+		// values are ordered by their names, which are ranked in advance
 #ifdef _DEBUG
-		const QuantityValue_Enum qe1 = dynamic_cast<const QuantityValue_Enum&>(v1);
-		const QuantityValue_Enum qe2 = dynamic_cast<const QuantityValue_Enum&>(v2);
-		return (qe1.value < qe2.value);
+		return ranks[dynamic_cast<const QuantityValue_Enum&>(v1).code] < ranks[dynamic_cast<const QuantityValue_Enum&>(v2).code];
 #else
-		return (((const QuantityValue_Enum&)(v1)).value < ((const QuantityValue_Enum&)(v2)).value);
+		return ranks[((const QuantityValue_Enum&)(v1)).code] < ranks[((const QuantityValue_Enum&)(v2)).code];
 #endif
 	}
 
@@ -217,20 +241,18 @@ namespace Pareto {
 
 	///////////////// QuantityValue_Enum //////////////////
 
-	QuantityValue_Enum::QuantityValue_Enum(QuantityType& t, std::string v) : QuantityValue(t) {
-		value = v;
-	}
-
-	QuantityValue_Enum::QuantityValue_Enum(QuantityType& t, const unsigned int n) :
-		QuantityValue(t)
+	QuantityValue_Enum::QuantityValue_Enum(const QuantityType_Enum& t, const unsigned int n) :
+		QuantityValue(t),
+		code(n)
 	{
-		QuantityType_Enum& et = dynamic_cast<QuantityType_Enum&>(t);
-		value = et.quantities[n]->value;
 	}
 
+	const std::string& QuantityValue_Enum::value(void) const {
+		return ((const QuantityType_Enum&)qtype).names[code];
+	}
 
 	void QuantityValue_Enum::streamOn(std::ostream& os) const {
-		os << value;
+		os << this->value();
 	}
 
 
@@ -252,7 +274,7 @@ namespace Pareto {
 
 	QuantityValuePtr QuantityType_Integer::valueFromString(const std::string s) const {
 		int number = std::strtol(s.c_str(), 0, 10);
-		return std::make_shared<QuantityValue_Integer>(*this, number);
+		return allocateInArena<QuantityValue_Integer>(nullptr, *this, number);
 	}
 
 
@@ -319,7 +341,7 @@ namespace Pareto {
 	}
 
 	QuantityValuePtr QuantityType_Real::valueFromString(const std::string s) const {
-		return std::make_shared<QuantityValue_Real>(*this, strtod(s.c_str(), nullptr));
+		return allocateInArena<QuantityValue_Real>(nullptr, *this, strtod(s.c_str(), nullptr));
 	}
 
 	bool QuantityType_Real::compare(const QuantityValue& q1, const QuantityValue& q2) const {
@@ -389,14 +411,4 @@ namespace Pareto {
 	}
 
 
-	unsigned int QuantityValue_Enum::index(void) const {
-		const QuantityType_Enum& qt = dynamic_cast<const QuantityType_Enum&>(qtype);
-		unsigned int s = (unsigned int) qt.quantities.size();
-		for (unsigned int i = 0; i < s; i++) {
-			if (*qt.quantities[i] == *this) { return i; }
-		}
-		throw EParetoCalculatorError("Error: value not found in QuantitityType in QuantityValue_Enum::index");
-		return 0;
-	}
-
 }
@@ -135,6 +135,9 @@ namespace Pareto {
 	class ListOfQuantityValueEnum : public std::vector<QuantityValue_EnumPtr> {};
 
 	/// Enumerated quantity type. The values in this type are assumed to be totally ordered.
+	///
+	/// The type holds the only instance of each of its values, so that the values of millions
+	/// of configurations share a few objects and are compared by their index.
 	class QuantityType_Enum: public QuantityType {
 	public:
 		/// an STL vector of names of the values
@@ -145,9 +148,15 @@ namespace Pareto {
 		/// Constructor 
 		QuantityType_Enum(std::string n);
 
+		/// Copy constructor, the copy has its own instances of the values
+		QuantityType_Enum(const QuantityType_Enum& t);
+
 		/// add a value to the type, with name 's'
 		virtual void addQuantity(std::string s);
 
+		/// return the instance of the value with index 'n'
+		QuantityValue_EnumPtr valueWithIndex(unsigned int n) const;
+
 		/// stream a string representation of the quantity type to 'os'
 		virtual void streamOn(std::ostream& os) const;
 
@@ -176,25 +185,39 @@ namespace Pareto {
 
 		// XML support
 		virtual std::string* xmlTypeString(void) {return new std::string("enum");}
+
+	private:
+		/// the position of the name of every value in alphabetical order. It implements the
+		/// total order on the values with integer comparisons.
+		std::vector<unsigned int> ranks;
+		/// the indices of the values in alphabetical order of their names, the inverse of 'ranks'
+		std::vector<unsigned int> order;
 	};
 
 	using QuantityType_EnumPtr = std::shared_ptr< QuantityType_Enum>;
 
-	/// An enumerated quantity value from any (ordered or unordered) enumerated type
+	/// An enumerated quantity value from any (ordered or unordered) enumerated type.
+	/// The values are created by their type only, use QuantityType_Enum::valueWithIndex
+	/// or QuantityType::valueFromString to obtain them.
 	class QuantityValue_Enum: public QuantityValue{
 	public:
-		/// Constructor, provide enumerated type and string representation of the desired value
-		QuantityValue_Enum(QuantityType& t, std::string v);
-		QuantityValue_Enum(QuantityType& t, const unsigned int n);
-
 		/// stream a string representation of the value to 'os'
 		virtual void streamOn(std::ostream& os) const;
 
 		/// obtain an index of this values within the list of values of its type
-		virtual unsigned int index(void) const;
+		virtual unsigned int index(void) const { return code; }
 
 		/// a string representing the enumerated value
-		std::string value;
+		const std::string& value(void) const;
+
+		/// the index of the value within the list of values of its type
+		const unsigned int code;
+
+	private:
+		friend class QuantityType_Enum;
+
+		/// Constructor of value number 'n' of enumerated type 't'
+		QuantityValue_Enum(const QuantityType_Enum& t, const unsigned int n);
 	};
 
 
@@ -0,0 +1,251 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Implementation of the readers and writers of streams of configurations
+//
+
+#include "records.h"
+#include "quantity.h"
+#include "exceptions.h"
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+
+using namespace Pareto;
+
+
+QuantityValueParser::QuantityValueParser(ConfigurationSpacePtr cs) :
+	confspace(cs) {
+	for (const QuantityTypePtr& qt : cs->quantities) {
+		this->kinds.push_back(columnKindOf(*qt));
+		std::unordered_map<std::string, unsigned int> indices;
+		if (qt->isQuantityTypeEnum()) {
+			const QuantityType_Enum& et = static_cast<const QuantityType_Enum&>(*qt);
+			for (unsigned int k = 0; k < et.names.size(); k++) {
+				indices[et.names[k]] = k;
+			}
+		}
+		this->enumIndices.push_back(std::move(indices));
+	}
+}
+
+QuantityValuePtr QuantityValueParser::parse(unsigned int k, const char* b, const char* e) const {
+	while (b != e && std::isspace((unsigned char)*b)) b++;
+	while (e != b && std::isspace((unsigned char)*(e - 1))) e--;
+	const QuantityTypePtr& qt = this->confspace->quantities[k];
+	switch (this->kinds[k]) {
+	case ColumnKind::Real: {
+		double v;
+		std::from_chars_result r = std::from_chars(b, e, v);
+		if (r.ec != std::errc() || r.ptr != e) return nullptr;
+		return allocateInArena<QuantityValue_Real>(nullptr, *qt, v);
+	}
+	case ColumnKind::Integer: {
+		int v;
+		std::from_chars_result r = std::from_chars(b, e, v);
+		if (r.ec != std::errc() || r.ptr != e) return nullptr;
+		return allocateInArena<QuantityValue_Integer>(nullptr, *qt, v);
+	}
+	default: {
+		std::unordered_map<std::string, unsigned int>::const_iterator i = this->enumIndices[k].find(std::string(b, e));
+		if (i == this->enumIndices[k].end()) return nullptr;
+		return static_cast<const QuantityType_Enum&>(*qt).valueWithIndex(i->second);
+	}
+	}
+}
+
+bool QuantityValueParser::appendTo(unsigned int k, const char* b, const char* e, QuantityColumn& c) const {
+	while (b != e && std::isspace((unsigned char)*b)) b++;
+	while (e != b && std::isspace((unsigned char)*(e - 1))) e--;
+	switch (this->kinds[k]) {
+	case ColumnKind::Real: {
+		double v;
+		std::from_chars_result r = std::from_chars(b, e, v);
+		if (r.ec != std::errc() || r.ptr != e) return false;
+		c.reals.push_back(v);
+		return true;
+	}
+	case ColumnKind::Integer: {
+		int32_t v;
+		std::from_chars_result r = std::from_chars(b, e, v);
+		if (r.ec != std::errc() || r.ptr != e) return false;
+		c.codes.push_back(v);
+		return true;
+	}
+	default: {
+		std::unordered_map<std::string, unsigned int>::const_iterator i = this->enumIndices[k].find(std::string(b, e));
+		if (i == this->enumIndices[k].end()) return false;
+		c.codes.push_back((int32_t)i->second);
+		return true;
+	}
+	}
+}
+
+
+ConfigurationReader::ConfigurationReader(std::istream& s, ConfigurationSpacePtr cs, RecordFormat f) :
+	is(s), confspace(cs), format(f), parser(cs) {
+	for (const QuantityTypePtr& qt : cs->quantities) {
+		this->kinds.push_back(columnKindOf(*qt));
+	}
+}
+
+ConfigurationPtr ConfigurationReader::next(void) {
+	ConfigurationPtr c = (this->format == RecordFormat::Text) ? this->nextText() : this->nextBinary();
+	if (c) this->count++;
+	return c;
+}
+
+ConfigurationPtr ConfigurationReader::nextText(void) {
+	while (std::getline(this->is, this->line)) {
+		this->lineNumber++;
+		const char* p = this->line.data();
+		const char* end = p + this->line.size();
+		auto skipSeparators = [&]() {
+			while (p != end && (*p == ' ' || *p == '\t' || *p == ',' || *p == '\r')) p++;
+		};
+		skipSeparators();
+		if (p == end || *p == '#') continue;
+
+		auto where = [this]() { return " in line " + std::to_string(this->lineNumber); };
+		ConfigurationPtr c = allocateInArena<Configuration>(nullptr, this->confspace);
+		c->quantities.reserve(this->kinds.size());
+		for (unsigned int k = 0; k < this->kinds.size(); k++) {
+			if (p == end) {
+				throw EParetoCalculatorError("Too few values" + where());
+			}
+			const char* token = p;
+			while (p != end && *p != ' ' && *p != '\t' && *p != ',' && *p != '\r') p++;
+			QuantityValuePtr v = this->parser.parse(k, token, p);
+			if (!v) {
+				throw EParetoCalculatorError("Invalid value " + std::string(token, p) + " of quantity type " + this->confspace->quantities[k]->name + where());
+			}
+			c->addQuantity(v);
+			skipSeparators();
+		}
+		if (p != end) {
+			throw EParetoCalculatorError("Too many values" + where());
+		}
+		return c;
+	}
+	return nullptr;
+}
+
+ConfigurationPtr ConfigurationReader::nextBinary(void) {
+	std::vector<char> record(8 * this->kinds.size());
+	if (record.empty() || !this->is.read(record.data(), record.size())) {
+		if (this->is.gcount() != 0) {
+			throw EParetoCalculatorError("Incomplete record after " + std::to_string(this->count) + " configurations");
+		}
+		return nullptr;
+	}
+	ConfigurationPtr c = allocateInArena<Configuration>(nullptr, this->confspace);
+	c->quantities.reserve(this->kinds.size());
+	for (unsigned int k = 0; k < this->kinds.size(); k++) {
+		const QuantityTypePtr& qt = this->confspace->quantities[k];
+		const char* field = record.data() + 8 * k;
+		switch (this->kinds[k]) {
+		case ColumnKind::Real: {
+			double v;
+			std::memcpy(&v, field, sizeof(v));
+			c->addQuantity(allocateInArena<QuantityValue_Real>(nullptr, *qt, v));
+			break;
+		}
+		case ColumnKind::Integer: {
+			int64_t v;
+			std::memcpy(&v, field, sizeof(v));
+			// like the text records, reject integers that an int cannot represent
+			if (v < std::numeric_limits<int>::min() || v > std::numeric_limits<int>::max()) {
+				throw EParetoCalculatorError("Invalid value " + std::to_string(v) + " of quantity type " + qt->name + " in record " + std::to_string(this->count + 1));
+			}
+			c->addQuantity(allocateInArena<QuantityValue_Integer>(nullptr, *qt, (int)v));
+			break;
+		}
+		default: {
+			uint64_t v;
+			std::memcpy(&v, field, sizeof(v));
+			const QuantityType_Enum& et = static_cast<const QuantityType_Enum&>(*qt);
+			if (v >= et.quantities.size()) {
+				throw EParetoCalculatorError("Value index out of range in quantity type " + qt->name + " in record " + std::to_string(this->count + 1));
+			}
+			c->addQuantity(et.valueWithIndex((unsigned int)v));
+		}
+		}
+	}
+	return c;
+}
+
+
+ConfigurationWriter::ConfigurationWriter(std::ostream& s, RecordFormat f) :
+	os(s), format(f) {
+}
+
+void ConfigurationWriter::write(const Configuration& c) {
+	const ListOfQuantityValues& q = c.quantities;
+	if (this->format == RecordFormat::Text) {
+		char buffer[32];
+		for (unsigned int k = 0; k < q.size(); k++) {
+			if (k > 0) this->os << ' ';
+			ColumnKind kind = columnKindOf(q[k]->qtype);
+			if (kind == ColumnKind::Real) {
+				// the shortest representation that reads back to the same value
+				std::to_chars_result r = std::to_chars(buffer, buffer + sizeof(buffer), static_cast<const QuantityValue_Real&>(*q[k]).value);
+				this->os.write(buffer, r.ptr - buffer);
+			}
+			else if (kind == ColumnKind::Integer) {
+				this->os << static_cast<const QuantityValue_Integer&>(*q[k]).value;
+			}
+			else {
+				const QuantityValue_Enum& v = static_cast<const QuantityValue_Enum&>(*q[k]);
+				this->os << static_cast<const QuantityType_Enum&>(v.qtype).names[v.index()];
+			}
+		}
+		this->os << '\n';
+		return;
+	}
+	for (unsigned int k = 0; k < q.size(); k++) {
+		char field[8];
+		ColumnKind kind = columnKindOf(q[k]->qtype);
+		if (kind == ColumnKind::Real) {
+			double v = static_cast<const QuantityValue_Real&>(*q[k]).value;
+			std::memcpy(field, &v, sizeof(v));
+		}
+		else if (kind == ColumnKind::Integer) {
+			int64_t v = static_cast<const QuantityValue_Integer&>(*q[k]).value;
+			std::memcpy(field, &v, sizeof(v));
+		}
+		else {
+			uint64_t v = static_cast<const QuantityValue_Enum&>(*q[k]).index();
+			std::memcpy(field, &v, sizeof(v));
+		}
+		this->os.write(field, sizeof(field));
+	}
+}
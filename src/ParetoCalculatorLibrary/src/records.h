@@ -0,0 +1,136 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Reading and writing streams of configurations as delimited text or as fixed-width
+// binary records
+//
+
+#ifndef PARETO_RECORDS_H
+#define PARETO_RECORDS_H
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "configuration.h"
+#include "columns.h"
+
+
+namespace Pareto {
+
+	/// The formats of a stream of configurations of a configuration space
+	///
+	/// Text has one configuration per line with the values of the quantities of the space in
+	/// order, separated by white space or commas. Enumerated values are given by name. Empty
+	/// lines and lines starting with '#' are skipped.
+	/// Binary has one record of 8 bytes per quantity for every configuration, in the byte order
+	/// of the machine: a double for real quantities, a 64-bit integer for integer quantities and
+	/// the 64-bit index of the value for enumerated quantities.
+	enum class RecordFormat { Text, Binary };
+
+	/// Parses the values of the quantities of a configuration space from text with std::from_chars,
+	/// without copying the text into strings
+	class QuantityValueParser {
+	public:
+		/// Constructor of a parser for the quantities of space 'cs'
+		QuantityValueParser(ConfigurationSpacePtr cs);
+
+		/// the value of quantity 'k' of the space written in the text from 'b' to 'e', surrounding
+		/// white space is ignored. Returns nullptr if the text is not a valid value.
+		QuantityValuePtr parse(unsigned int k, const char* b, const char* e) const;
+
+		/// append the value of quantity 'k' written in the text from 'b' to 'e' to column 'c' of the
+		/// quantity, without creating a value object. Returns false if the text is not a valid value.
+		bool appendTo(unsigned int k, const char* b, const char* e, QuantityColumn& c) const;
+
+		/// the number of quantities of the space
+		size_t size(void) const { return kinds.size(); }
+
+	private:
+		ConfigurationSpacePtr confspace;
+
+		/// the storage kinds of the quantities of the space
+		std::vector<ColumnKind> kinds;
+
+		/// the indices of the values of the enumerated quantities by their names
+		std::vector<std::unordered_map<std::string, unsigned int>> enumIndices;
+	};
+
+	/// Reads the configurations of a configuration space one at a time from a stream
+	class ConfigurationReader {
+	public:
+		/// Constructor of a reader of configurations of space 'cs' from stream 'is' in format 'f'
+		ConfigurationReader(std::istream& is, ConfigurationSpacePtr cs, RecordFormat f);
+
+		/// read the next configuration, returns nullptr at the end of the stream.
+		/// Throws an exception if a record is malformed.
+		ConfigurationPtr next(void);
+
+		/// the number of configurations read
+		size_t count = 0;
+
+	private:
+		std::istream& is;
+		ConfigurationSpacePtr confspace;
+		RecordFormat format;
+
+		/// the parser of the values of text records
+		QuantityValueParser parser;
+
+		/// the storage kinds of the quantities of the space
+		std::vector<ColumnKind> kinds;
+
+		/// the current line of a text stream and its number
+		std::string line;
+		size_t lineNumber = 0;
+
+		/// read the next record of a text or binary stream
+		ConfigurationPtr nextText(void);
+		ConfigurationPtr nextBinary(void);
+	};
+
+	/// Writes configurations to a stream in one of the formats of ConfigurationReader
+	class ConfigurationWriter {
+	public:
+		/// Constructor of a writer to stream 'os' in format 'f'
+		ConfigurationWriter(std::ostream& os, RecordFormat f);
+
+		/// write configuration 'c'
+		void write(const Configuration& c);
+
+	private:
+		std::ostream& os;
+		RecordFormat format;
+	};
+
+}
+
+#endif
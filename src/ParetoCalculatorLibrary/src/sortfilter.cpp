@@ -0,0 +1,127 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Implements the sort-filter-skyline minimization
+//
+
+#include "sortfilter.h"
+#include "dominance.h"
+#include <algorithm>
+#include <numeric>
+
+
+namespace Pareto {
+
+	SortFilterSkyline::SortFilterSkyline(const ConfigurationSpace& cs, const std::vector<const Configuration*>& confs) :
+		confspace(cs), confs(confs)
+	{
+		const DominanceKernel& dk = cs.dominanceKernel();
+		size_t n = confs.size();
+
+		// collect the raw values of the ordered visible quantities
+		std::vector<unsigned int> ordered;
+		ordered.insert(ordered.end(), dk.reals.begin(), dk.reals.end());
+		ordered.insert(ordered.end(), dk.integers.begin(), dk.integers.end());
+		ordered.insert(ordered.end(), dk.enums.begin(), dk.enums.end());
+		this->values.assign(n, std::vector<double>(ordered.size()));
+		for (size_t k = 0; k < n; k++) {
+			const ListOfQuantityValues& q = confs[k]->quantities;
+			size_t m = 0;
+			for (unsigned int i : dk.reals) this->values[k][m++] = static_cast<const QuantityValue_Real&>(*q[i]).value;
+			for (unsigned int i : dk.integers) this->values[k][m++] = static_cast<const QuantityValue_Integer&>(*q[i]).value;
+			for (unsigned int i : dk.enums) this->values[k][m++] = static_cast<const QuantityValue_Enum&>(*q[i]).code;
+		}
+
+		// normalize every quantity to [0,1] and derive the sort keys
+		std::vector<double> low(ordered.size()), range(ordered.size());
+		for (size_t m = 0; m < ordered.size(); m++) {
+			double lo = 0.0, hi = 0.0;
+			for (size_t k = 0; k < n; k++) {
+				double v = this->values[k][m];
+				if (k == 0 || v < lo) lo = v;
+				if (k == 0 || v > hi) hi = v;
+			}
+			low[m] = lo;
+			range[m] = hi - lo;
+		}
+		this->minValue.assign(n, 0.0);
+		this->maxValue.assign(n, 0.0);
+		this->sum.assign(n, 0.0);
+		for (size_t k = 0; k < n; k++) {
+			for (size_t m = 0; m < ordered.size(); m++) {
+				double v = range[m] > 0.0 ? (this->values[k][m] - low[m]) / range[m] : 0.0;
+				if (m == 0 || v < this->minValue[k]) this->minValue[k] = v;
+				if (m == 0 || v > this->maxValue[k]) this->maxValue[k] = v;
+				this->sum[k] += v;
+			}
+		}
+	}
+
+	std::vector<size_t> SortFilterSkyline::minimal(void) const {
+		const DominanceKernel& dk = this->confspace.dominanceKernel();
+		size_t n = this->confs.size();
+
+		// sort on the monotone key, keeping the original order of equal keys
+		std::vector<size_t> order(n);
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+			if (this->minValue[a] != this->minValue[b]) return this->minValue[a] < this->minValue[b];
+			if (this->sum[a] != this->sum[b]) return this->sum[a] < this->sum[b];
+			return this->values[a] < this->values[b];
+		});
+
+		// early termination is only valid if minimal configurations dominate on all quantities
+		bool canStop = dk.unordered.empty() && !this->values.empty() && !this->values[0].empty();
+		double stop = 0.0;
+
+		std::vector<size_t> window;
+		this->visited = 0;
+		for (size_t k : order) {
+			if (canStop && !window.empty() && this->minValue[k] > stop) {
+				break;
+			}
+			this->visited++;
+			const Configuration& c = *this->confs[k];
+			bool dominated = false;
+			for (size_t p : window) {
+				if (dk.dominates(*this->confs[p], c)) {
+					dominated = true;
+					break;
+				}
+			}
+			if (!dominated) {
+				if (window.empty() || this->maxValue[k] < stop) stop = this->maxValue[k];
+				window.push_back(k);
+			}
+		}
+		return window;
+	}
+
+}
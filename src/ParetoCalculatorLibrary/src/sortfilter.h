@@ -0,0 +1,77 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Sort-filter-skyline minimization of sets of configurations
+//
+
+#ifndef PARETO_SORTFILTER_H
+#define PARETO_SORTFILTER_H
+
+#include <vector>
+#include "configuration.h"
+
+
+namespace Pareto {
+
+	/// Computes the Pareto minimal configurations with the sort-filter-skyline method.
+	///
+	/// The configurations are first sorted on a monotone key: the smallest normalized value
+	/// of the ordered visible quantities, then the sum of the normalized values and finally
+	/// the raw values lexicographically. If a configuration dominates another, it comes
+	/// first in this order, so a single pass comparing each configuration to the minimal
+	/// ones found so far suffices. The pass stops early as soon as the smallest normalized
+	/// value of the next configuration exceeds the largest normalized value of a minimal
+	/// configuration, since all remaining configurations are then strictly dominated.
+	class SortFilterSkyline {
+	public:
+		/// Constructor for the configurations 'confs' of configuration space 'cs', which must outlive the object
+		SortFilterSkyline(const ConfigurationSpace& cs, const std::vector<const Configuration*>& confs);
+
+		/// the positions in 'confs' of the minimal configurations, in the sorted order.
+		/// Of configurations with equal visible values only the first one in 'confs' is kept.
+		std::vector<size_t> minimal(void) const;
+
+		/// the number of configurations that were visited by the last call of minimal
+		mutable size_t visited = 0;
+
+	private:
+		const ConfigurationSpace& confspace;
+		const std::vector<const Configuration*>& confs;
+
+		/// the raw values of the ordered visible quantities, one row per configuration
+		std::vector<std::vector<double>> values;
+
+		/// the smallest and largest normalized value and the sum of normalized values per configuration
+		std::vector<double> minValue, maxValue, sum;
+	};
+
+}
+
+#endif
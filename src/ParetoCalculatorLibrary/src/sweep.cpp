@@ -0,0 +1,139 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Implements the sweep algorithms for two and three visible quantities
+//
+
+#include "sweep.h"
+#include "dominance.h"
+#include "profiling.h"
+#include <algorithm>
+#include <map>
+#include <numeric>
+
+
+namespace Pareto {
+
+	/// The staircase of the minimal (second, third) values of the points swept so far
+	class Staircase {
+	public:
+		/// test if the point (y,z) is dominated by a step of the staircase, which counts as
+		/// a single dominance test
+		bool dominates(double y, double z) const {
+			ProfileCounters::dominanceTests++;
+			std::map<double, double>::const_iterator i = this->steps.upper_bound(y);
+			if (i == this->steps.begin()) return false;
+			i--;
+			return i->second <= z;
+		}
+
+		/// add the point (y,z), which must not be dominated, and remove the steps it dominates
+		void insert(double y, double z) {
+			std::map<double, double>::iterator i = this->steps.lower_bound(y);
+			while (i != this->steps.end() && i->second >= z) {
+				i = this->steps.erase(i);
+			}
+			this->steps[y] = z;
+		}
+
+	private:
+		/// the steps, the third value decreases with increasing second value
+		std::map<double, double> steps;
+	};
+
+	bool SweepKernel::appliesTo(const ConfigurationSpace& cs) {
+		const DominanceKernel& dk = cs.dominanceKernel();
+		size_t d = dk.reals.size() + dk.integers.size() + dk.enums.size();
+		return dk.unordered.empty() && (d == 2 || d == 3);
+	}
+
+	std::vector<SweepKernel::Point> SweepKernel::pointsOf(const ConfigurationSpace& cs, const std::vector<const Configuration*>& confs) {
+		const DominanceKernel& dk = cs.dominanceKernel();
+		std::vector<Point> points(confs.size(), Point{ { 0.0, 0.0, 0.0 } });
+		for (size_t k = 0; k < confs.size(); k++) {
+			const ListOfQuantityValues& q = confs[k]->quantities;
+			size_t m = 0;
+			for (unsigned int i : dk.reals) points[k][m++] = static_cast<const QuantityValue_Real&>(*q[i]).value;
+			for (unsigned int i : dk.integers) points[k][m++] = static_cast<const QuantityValue_Integer&>(*q[i]).value;
+			for (unsigned int i : dk.enums) points[k][m++] = static_cast<const QuantityValue_Enum&>(*q[i]).code;
+		}
+		return points;
+	}
+
+	std::vector<size_t> SweepKernel::sortedPositions(const std::vector<Point>& points) {
+		std::vector<size_t> order(points.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&points](size_t a, size_t b) { return points[a] < points[b]; });
+		return order;
+	}
+
+	std::vector<size_t> SweepKernel::minimal(const ConfigurationSpace& cs, const std::vector<const Configuration*>& confs) {
+		std::vector<Point> points = SweepKernel::pointsOf(cs, confs);
+		Staircase stairs;
+		std::vector<size_t> res;
+		// a point can only be dominated by points before it in lexicographic order
+		for (size_t k : SweepKernel::sortedPositions(points)) {
+			const Point& p = points[k];
+			if (!stairs.dominates(p[1], p[2])) {
+				stairs.insert(p[1], p[2]);
+				res.push_back(k);
+			}
+		}
+		std::sort(res.begin(), res.end());
+		return res;
+	}
+
+	std::vector<size_t> SweepKernel::undominated(const ConfigurationSpace& cs, const std::vector<const Configuration*>& a,
+		const std::vector<const Configuration*>& b) {
+		std::vector<Point> pa = SweepKernel::pointsOf(cs, a);
+		std::vector<Point> pb = SweepKernel::pointsOf(cs, b);
+		std::vector<size_t> oa = SweepKernel::sortedPositions(pa);
+		Staircase stairs;
+		std::vector<size_t> res;
+		size_t i = 0;
+		// sweep 'b' and add the points of 'a' with a smaller or equal first value before testing
+		for (size_t k : SweepKernel::sortedPositions(pb)) {
+			const Point& p = pb[k];
+			while (i < oa.size() && pa[oa[i]][0] <= p[0]) {
+				const Point& q = pa[oa[i]];
+				if (!stairs.dominates(q[1], q[2])) {
+					stairs.insert(q[1], q[2]);
+				}
+				i++;
+			}
+			if (!stairs.dominates(p[1], p[2])) {
+				res.push_back(k);
+			}
+		}
+		std::sort(res.begin(), res.end());
+		return res;
+	}
+
+}
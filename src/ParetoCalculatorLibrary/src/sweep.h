@@ -0,0 +1,79 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Sweep algorithms to minimize configurations with two or three visible quantities
+//
+
+#ifndef PARETO_SWEEP_H
+#define PARETO_SWEEP_H
+
+#include <array>
+#include <vector>
+#include "configuration.h"
+
+
+namespace Pareto {
+
+	/// Minimization and filtering in O(n log n) for spaces with two or three visible
+	/// quantities, which are all totally ordered.
+	///
+	/// The configurations are sorted on the first quantity and swept in that order. The
+	/// minimal values of the other two quantities of the configurations swept so far are kept
+	/// as a staircase: a balanced tree of points in which the third value decreases when the
+	/// second increases. A configuration is dominated if the step of the staircase at or below
+	/// its second value has a third value at or below its own. With two quantities the third
+	/// value is zero for all configurations and the staircase reduces to a running minimum.
+	class SweepKernel {
+	public:
+		/// test if the sweep kernels apply to configuration space 'cs'
+		static bool appliesTo(const ConfigurationSpace& cs);
+
+		/// the positions in 'confs' of the minimal configurations, in increasing order.
+		/// Of configurations with equal visible values only the first one in 'confs' is kept.
+		static std::vector<size_t> minimal(const ConfigurationSpace& cs, const std::vector<const Configuration*>& confs);
+
+		/// the positions in 'b' of the configurations that are not dominated by any
+		/// configuration of 'a', in increasing order
+		static std::vector<size_t> undominated(const ConfigurationSpace& cs, const std::vector<const Configuration*>& a,
+			const std::vector<const Configuration*>& b);
+
+	private:
+		using Point = std::array<double, 3>;
+
+		/// the values of the visible quantities of 'confs', padded with zeros
+		static std::vector<Point> pointsOf(const ConfigurationSpace& cs, const std::vector<const Configuration*>& confs);
+
+		/// the positions of 'points' sorted on their values, keeping the order of equal points
+		static std::vector<size_t> sortedPositions(const std::vector<Point>& points);
+	};
+
+}
+
+#endif
@@ -0,0 +1,170 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Implements the work-stealing pool of threads
+//
+
+#include "taskpool.h"
+#include <algorithm>
+#include <chrono>
+
+
+namespace Pareto {
+
+	/// the pool and the queue of the worker thread, if the current thread is a worker
+	static thread_local const TaskPool* currentPool = nullptr;
+	static thread_local size_t currentQueue = 0;
+
+	void Task::run(void) {
+		try {
+			function();
+		}
+		catch (...) {
+			error = std::current_exception();
+		}
+		{
+			std::lock_guard<std::mutex> l(doneLock);
+			done.store(true);
+		}
+		finished.notify_all();
+	}
+
+	TaskPool::TaskPool(unsigned int nrOfThreads) {
+		if (nrOfThreads == 0) {
+			nrOfThreads = std::max(1u, std::thread::hardware_concurrency());
+		}
+		for (unsigned int n = 0; n <= nrOfThreads; n++) {
+			queues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue()));
+		}
+		for (unsigned int n = 0; n < nrOfThreads; n++) {
+			threads.push_back(std::thread(&TaskPool::work, this, n));
+		}
+	}
+
+	TaskPool::~TaskPool() {
+		{
+			std::lock_guard<std::mutex> l(idleLock);
+			stopping.store(true);
+		}
+		idle.notify_all();
+		for (std::thread& t : threads) t.join();
+	}
+
+	TaskPool& TaskPool::shared(void) {
+		static TaskPool pool;
+		return pool;
+	}
+
+	size_t TaskPool::ownQueue(void) const {
+		return currentPool == this ? currentQueue : threads.size();
+	}
+
+	TaskPtr TaskPool::fork(std::function<void(void)> f) {
+		TaskPtr t = std::make_shared<Task>(f);
+		this->submit(t);
+		return t;
+	}
+
+	void TaskPool::submit(TaskPtr t) {
+		TaskQueue& q = *queues[this->ownQueue()];
+		{
+			std::lock_guard<std::mutex> l(q.lock);
+			q.tasks.push_back(t);
+		}
+		{
+			std::lock_guard<std::mutex> l(idleLock);
+		}
+		idle.notify_one();
+	}
+
+	/// the number of times a joining thread looks for other tasks before it sleeps
+	static const unsigned int joinAttempts = 64;
+
+	void TaskPool::join(TaskPtr t) {
+		unsigned int attempts = 0;
+		while (!t->isDone()) {
+			if (this->runOne()) {
+				attempts = 0;
+			}
+			else if (++attempts < joinAttempts) {
+				std::this_thread::yield();
+			}
+			else {
+				// sleep until the task finishes, but look for new tasks regularly as forks do not wake joining threads
+				std::unique_lock<std::mutex> l(t->doneLock);
+				t->finished.wait_for(l, std::chrono::milliseconds(1), [&t]() { return t->isDone(); });
+			}
+		}
+		if (t->error) {
+			std::rethrow_exception(t->error);
+		}
+	}
+
+	bool TaskPool::runOne(void) {
+		size_t own = this->ownQueue();
+		TaskPtr t;
+		// the most recent task of the own queue
+		{
+			TaskQueue& q = *queues[own];
+			std::lock_guard<std::mutex> l(q.lock);
+			if (!q.tasks.empty()) {
+				t = q.tasks.back();
+				q.tasks.pop_back();
+			}
+		}
+		// or steal the oldest task of another queue
+		for (size_t k = 1; !t && k < queues.size(); k++) {
+			TaskQueue& q = *queues[(own + k) % queues.size()];
+			std::lock_guard<std::mutex> l(q.lock);
+			if (!q.tasks.empty()) {
+				t = q.tasks.front();
+				q.tasks.pop_front();
+			}
+		}
+		if (!t) return false;
+		t->run();
+		return true;
+	}
+
+	void TaskPool::work(size_t n) {
+		currentPool = this;
+		currentQueue = n;
+		while (!stopping.load()) {
+			if (!this->runOne()) {
+				// wait for new tasks, but check regularly as a notification may be missed between runOne and wait
+				std::unique_lock<std::mutex> l(idleLock);
+				if (!stopping.load()) {
+					idle.wait_for(l, std::chrono::milliseconds(1));
+				}
+			}
+		}
+	}
+
+}
@@ -0,0 +1,149 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// A work-stealing pool of threads to execute tasks in parallel
+//
+
+#ifndef PARETO_TASKPOOL_H
+#define PARETO_TASKPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace Pareto {
+
+	class TaskPool;
+
+	/// A task submitted to a TaskPool. Use TaskPool::join to wait for it and
+	/// to obtain any exception it raised.
+	class Task {
+	public:
+		/// Constructor of a task executing 'f'
+		Task(std::function<void(void)> f) : function(f) {}
+
+		/// test whether the task has finished
+		bool isDone(void) const { return done.load(); }
+
+	private:
+		friend class TaskPool;
+
+		/// execute the task and record its completion
+		void run(void);
+
+		/// the work to be done
+		std::function<void(void)> function;
+
+		/// the exception raised by the task, if any
+		std::exception_ptr error;
+
+		/// set when the task has finished
+		std::atomic<bool> done{ false };
+
+		/// signalled when the task has finished, for threads that join it without other work to do
+		std::mutex doneLock;
+		std::condition_variable finished;
+	};
+
+	using TaskPtr = std::shared_ptr<Task>;
+
+	/// A pool of worker threads executing tasks.
+	///
+	/// Every worker has its own double-ended queue of tasks. A worker takes the most recently
+	/// submitted task from its own queue and, when that is empty, steals the oldest task from
+	/// another queue. Tasks submitted by a thread outside the pool go to a shared queue.
+	/// A thread that joins a task executes other tasks while it waits, so tasks can fork and
+	/// join subtasks recursively without blocking the workers.
+	class TaskPool {
+	public:
+		/// Constructor of a pool with 'nrOfThreads' workers. Zero selects the number of hardware threads.
+		TaskPool(unsigned int nrOfThreads = 0);
+
+		/// Destructor, waits for the workers to finish
+		~TaskPool();
+
+		TaskPool(const TaskPool&) = delete;
+		TaskPool& operator=(const TaskPool&) = delete;
+
+		/// submit a task to execute 'f'
+		TaskPtr fork(std::function<void(void)> f);
+
+		/// submit task 't', which is created by the caller. A task can be joined before it is
+		/// submitted, the join then returns after it has been submitted and finished.
+		void submit(TaskPtr t);
+
+		/// wait for task 't' to finish, executing other tasks meanwhile. When there are no
+		/// other tasks, the thread sleeps until 't' finishes. Rethrows the exception raised by the task, if any.
+		void join(TaskPtr t);
+
+		/// the number of worker threads
+		unsigned int size(void) const { return (unsigned int) threads.size(); }
+
+		/// a pool shared by the whole application, created on first use
+		static TaskPool& shared(void);
+
+	private:
+		/// a queue of tasks with its lock
+		struct TaskQueue {
+			std::mutex lock;
+			std::deque<TaskPtr> tasks;
+		};
+
+		/// one queue per worker, followed by the shared queue for outside threads
+		std::vector<std::unique_ptr<TaskQueue>> queues;
+
+		std::vector<std::thread> threads;
+
+		/// wakes up idle workers when tasks are submitted
+		std::mutex idleLock;
+		std::condition_variable idle;
+
+		std::atomic<bool> stopping{ false };
+
+		/// the index of the queue of the calling thread
+		size_t ownQueue(void) const;
+
+		/// take a task from the queues and execute it. Returns false if there was none.
+		bool runOne(void);
+
+		/// the main loop of worker 'n'
+		void work(size_t n);
+	};
+
+}
+
+#endif
@@ -124,7 +124,7 @@ void ParetoCalculatorW::storePop(String^ name)
 void ParetoCalculatorW::executeProdCons(String^ pq, String^ cq)
 {
 	POperation_ProdCons& pco = *new POperation_ProdCons(system_to_std_string(pq), system_to_std_string(cq));
-	pco.executeOn(*this->pc);
+	this->pc->execute(pco);
 }
 
 void ParetoCalculatorW::executeAbstract(String^ qn)
@@ -132,7 +132,7 @@ void ParetoCalculatorW::executeAbstract(String^ qn)
 	ListOfQuantityNames lqn;
 	lqn.push_back(system_to_std_string(qn));
 	POperation_Abstract ao(lqn);
-	ao.executeOn(*this->pc);
+	this->pc->execute(ao);
 }
 
 void ParetoCalculatorW::executeJoin(String^ qn)
@@ -141,34 +141,34 @@ void ParetoCalculatorW::executeJoin(String^ qn)
 	std::string q = system_to_std_string(qn);
 	jm[q] = q;
 	POperation_EfficientJoin jo(jm);
-	jo.executeOn(*this->pc);
+	this->pc->execute(jo);
 }
 
 void ParetoCalculatorW::executeSum(String^ qa, String^ qb)
 {
 	POperation_Sum& so = *new POperation_Sum(system_to_std_string(qa), system_to_std_string(qb));
-	so.executeOn(*this->pc);
+	this->pc->execute(so);
 	delete& so;
 }
 
 void ParetoCalculatorW::executeMin(String^ qa, String^ qb)
 {
 	POperation_Min& so = *new POperation_Min(system_to_std_string(qa), system_to_std_string(qb));
-	so.executeOn(*this->pc);
+	this->pc->execute(so);
 	delete& so;
 }
 
 void ParetoCalculatorW::executeMax(String^ qa, String^ qb)
 {
 	POperation_Max& so = *new POperation_Max(system_to_std_string(qa), system_to_std_string(qb));
-	so.executeOn(*this->pc);
+	this->pc->execute(so);
 	delete& so;
 }
 
 void ParetoCalculatorW::executeMultiply(String^ qa, String^ qb)
 {
 	POperation_Max& so = *new POperation_Max(system_to_std_string(qa), system_to_std_string(qb));
-	so.executeOn(*this->pc);
+	this->pc->execute(so);
 	delete& so;
 }
 
@@ -190,9 +190,10 @@ ArrayList^ ParetoCalculatorW::getScattterPoints(String^ qxs, String^ qys)
 	else { qiy = -1; }
 
 	ArrayList^ result = gcnew ArrayList();
+	cs->materialize();
 	SetOfConfigurations::iterator k;
 	unsigned int i = 0;
-	for (k = cs->confs.begin(); k != cs->confs.end(); k++, i++) {
+	for (k = cs->confs().begin(); k != cs->confs().end(); k++, i++) {
 		const Pareto::Configuration& c = *k;
 		QuantityValuePtr vx = c.getQuantity(qix);
 		QuantityValuePtr vy = c.getQuantity(qiy);
@@ -0,0 +1,361 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Benchmark application of the Pareto Calculator. It times the minimization engines
+// or the operations of the calculator on synthetic workloads and reports the results as JSON.
+//
+
+#include "benchmark.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace Pareto;
+
+
+// Count the allocations of the benchmark by replacing the global operator new. All forms of
+// the operator are replaced, including the aligned forms that the chunks of a ConfigurationArena
+// are allocated with, so that all allocations are counted. The aligned forms allocate with
+// _aligned_malloc on Windows, where its memory must be released with _aligned_free.
+static std::atomic<size_t> nrOfAllocations{ 0 };
+static std::atomic<size_t> nrOfAllocatedBytes{ 0 };
+
+void* operator new(std::size_t n) {
+	nrOfAllocations.fetch_add(1, std::memory_order_relaxed);
+	nrOfAllocatedBytes.fetch_add(n, std::memory_order_relaxed);
+	void* p = std::malloc(n == 0 ? 1 : n);
+	if (p == nullptr) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept {
+	try {
+		return ::operator new(n);
+	}
+	catch (const std::bad_alloc&) {
+		return nullptr;
+	}
+}
+
+void* operator new[](std::size_t n) {
+	return ::operator new(n);
+}
+
+void* operator new[](std::size_t n, const std::nothrow_t& t) noexcept {
+	return ::operator new(n, t);
+}
+
+void operator delete(void* p) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+	std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+	std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+	std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+	std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+	std::free(p);
+}
+
+void* operator new(std::size_t n, std::align_val_t a) {
+	nrOfAllocations.fetch_add(1, std::memory_order_relaxed);
+	nrOfAllocatedBytes.fetch_add(n, std::memory_order_relaxed);
+	size_t alignment = std::max((size_t)a, sizeof(void*));
+#if defined(_WIN32)
+	void* p = _aligned_malloc(n == 0 ? 1 : n, alignment);
+#else
+	// the size of aligned_alloc must be a multiple of the alignment
+	void* p = std::aligned_alloc(alignment, (std::max(n, (size_t)1) + alignment - 1) / alignment * alignment);
+#endif
+	if (p == nullptr) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void* operator new(std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept {
+	try {
+		return ::operator new(n, a);
+	}
+	catch (const std::bad_alloc&) {
+		return nullptr;
+	}
+}
+
+void* operator new[](std::size_t n, std::align_val_t a) {
+	return ::operator new(n, a);
+}
+
+void* operator new[](std::size_t n, std::align_val_t a, const std::nothrow_t& t) noexcept {
+	return ::operator new(n, a, t);
+}
+
+/// release memory of the aligned forms of operator new
+static void alignedFree(void* p) {
+#if defined(_WIN32)
+	_aligned_free(p);
+#else
+	std::free(p);
+#endif
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+	alignedFree(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+	alignedFree(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+	alignedFree(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept {
+	alignedFree(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+	alignedFree(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+	alignedFree(p);
+}
+
+size_t Pareto::allocations(void) {
+	return nrOfAllocations.load(std::memory_order_relaxed);
+}
+
+size_t Pareto::allocatedBytes(void) {
+	return nrOfAllocatedBytes.load(std::memory_order_relaxed);
+}
+
+long Pareto::peakRSS(void) {
+#if defined(_WIN32)
+	PROCESS_MEMORY_COUNTERS pmc;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+		return (long)(pmc.PeakWorkingSetSize / 1024);
+	}
+	return 0;
+#else
+	// the high water mark of Linux can be reset, see resetPeakRSS
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line)) {
+		if (line.compare(0, 6, "VmHWM:") == 0) {
+			return std::stol(line.substr(6));
+		}
+	}
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+	return usage.ru_maxrss / 1024;
+#else
+	return usage.ru_maxrss;
+#endif
+#endif
+}
+
+void Pareto::resetPeakRSS(void) {
+#if defined(__linux__)
+	std::ofstream clearRefs("/proc/self/clear_refs");
+	if (clearRefs) {
+		clearRefs << "5";
+	}
+#endif
+}
+
+double Pareto::median(std::vector<double> v) {
+	std::sort(v.begin(), v.end());
+	size_t m = v.size() / 2;
+	return (v.size() % 2 == 1) ? v[m] : (v[m - 1] + v[m]) / 2.0;
+}
+
+double Pareto::percentile(std::vector<double> v, double p) {
+	std::sort(v.begin(), v.end());
+	size_t rank = (size_t)std::ceil(p / 100.0 * (double)v.size());
+	rank = std::min(std::max(rank, (size_t)1), v.size());
+	return v[rank - 1];
+}
+
+bool Pareto::isSelected(const BenchmarkSettings& settings, const std::string& name) {
+	return settings.engines.empty() || std::find(settings.engines.begin(), settings.engines.end(), name) != settings.engines.end();
+}
+
+
+/// split the comma separated list 'arg'
+static std::vector<std::string> splitList(const std::string& arg) {
+	std::vector<std::string> items;
+	std::istringstream is(arg);
+	std::string item;
+	while (std::getline(is, item, ',')) {
+		if (!item.empty()) items.push_back(item);
+	}
+	return items;
+}
+
+static Distribution distributionFromName(const std::string& name) {
+	for (Distribution d : { Distribution::Correlated, Distribution::Independent, Distribution::AntiCorrelated }) {
+		if (distributionName(d) == name) return d;
+	}
+	throw EParetoCalculatorError("Unknown distribution " + name);
+}
+
+static void usage(void) {
+	std::cout << "Usage: ParetoCalculatorBenchmark [-suite minimization|operations] [-size <n>[,<n>...]]" << std::endl;
+	std::cout << "                                 [-distribution <name>[,<name>...]] [-selectivity <s>[,<s>...]]" << std::endl;
+	std::cout << "                                 [-mix <quantities> | -dimension <d>] [-engines <name>[,<name>...]]" << std::endl;
+	std::cout << "                                 [-repeat <r>] [-seed <s>] [-output <json_file>]" << std::endl;
+	std::cout << "  distributions: correlated, independent, anticorrelated" << std::endl;
+	std::cout << "  quantities: one character per quantity, r real, i integer, o ordered, u unordered" << std::endl;
+	std::cout << "  minimization engines: minimize, minimize_SC, minimize_SFS, efficient_minimize," << std::endl;
+	std::cout << "    efficient_minimize_nosweep, efficient_minimize_parallel, minimize_columnar" << std::endl;
+	std::cout << "  operations: product, product_columnar, join, join_eff, prodcons, prodcons_eff" << std::endl;
+}
+
+/// run the benchmark suite of 'settings', writing the results to 'os'
+static void runBenchmark(const BenchmarkSettings& settings, std::ostream& os) {
+	if (settings.suite == "minimization") {
+		runMinimizationBenchmark(settings, os);
+	}
+	else if (settings.suite == "operations") {
+		runOperationBenchmark(settings, os);
+	}
+	else {
+		throw EParetoCalculatorError("Unknown benchmark suite " + settings.suite);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	BenchmarkSettings settings;
+	std::string output;
+	try {
+		for (int i = 1; i < argc; i++) {
+			std::string arg = argv[i];
+			if (i == argc - 1) {
+				usage();
+				return -1;
+			}
+			std::string value = argv[++i];
+			if (arg == "-suite") {
+				settings.suite = value;
+			}
+			else if (arg == "-size") {
+				settings.sizes.clear();
+				for (const std::string& s : splitList(value)) settings.sizes.push_back((size_t)std::stoul(s));
+			}
+			else if (arg == "-distribution") {
+				settings.distributions.clear();
+				for (const std::string& s : splitList(value)) settings.distributions.push_back(distributionFromName(s));
+			}
+			else if (arg == "-selectivity") {
+				settings.selectivities.clear();
+				for (const std::string& s : splitList(value)) {
+					double sel = std::stod(s);
+					if (!(sel > 0.0 && sel <= 1.0)) {
+						throw EParetoCalculatorError("Selectivity must be in (0,1]: " + s);
+					}
+					settings.selectivities.push_back(sel);
+				}
+			}
+			else if (arg == "-mix") {
+				settings.mix = value;
+			}
+			else if (arg == "-dimension") {
+				settings.mix = std::string(std::stoul(value), 'r');
+			}
+			else if (arg == "-engines") {
+				settings.engines = splitList(value);
+			}
+			else if (arg == "-repeat") {
+				settings.repeat = std::max(1u, (unsigned int)std::stoul(value));
+			}
+			else if (arg == "-seed") {
+				settings.seed = (unsigned int)std::stoul(value);
+			}
+			else if (arg == "-output") {
+				output = value;
+			}
+			else {
+				usage();
+				return -1;
+			}
+		}
+
+		if (output.empty()) {
+			runBenchmark(settings, std::cout);
+		}
+		else {
+			std::ofstream os(output);
+			if (!os) {
+				throw EParetoCalculatorError("Cannot open output file " + output);
+			}
+			runBenchmark(settings, os);
+		}
+	}
+	catch (const EParetoCalculatorError& e) {
+		std::cerr << "An exception occurred: " << e.errorMsg << std::endl;
+		return -1;
+	}
+	catch (const std::logic_error&) {
+		// std::stoul or std::stod of an invalid number
+		usage();
+		return -1;
+	}
+	return 0;
+}
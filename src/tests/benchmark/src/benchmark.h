@@ -0,0 +1,100 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Benchmark application of the Pareto Calculator, support shared by the benchmarks
+//
+
+#pragma once
+
+#ifndef TESTS_BENCHMARK_H
+#define TESTS_BENCHMARK_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include "workloads.h"
+
+
+namespace Pareto {
+
+	/// The settings of a benchmark run, given on the command line
+	struct BenchmarkSettings {
+		/// the benchmark to run, "minimization" or "operations"
+		std::string suite = "minimization";
+		/// the numbers of configurations of the generated sets, the default of the suite if empty
+		std::vector<size_t> sizes;
+		/// the distributions of the generated sets
+		std::vector<Distribution> distributions = { Distribution::Correlated, Distribution::Independent, Distribution::AntiCorrelated };
+		/// the quantity types of the generated configuration spaces, see WorkloadGenerator::space
+		std::string mix = "rrr";
+		/// the names of the engines to run, all engines if empty
+		std::vector<std::string> engines;
+		/// the fractions of the pairs of configurations that satisfy a join or producer-consumer constraint
+		std::vector<double> selectivities = { 0.01, 0.1, 0.5 };
+		/// the number of times every engine is timed, the default of the suite if 0
+		unsigned int repeat = 0;
+		/// the seed of the pseudo random generator
+		unsigned int seed = 4321;
+	};
+
+	/// the peak resident set size of the process in kilobytes, 0 if it is not available
+	long peakRSS(void);
+
+	/// reset the peak resident set size to the current size, where the platform supports it,
+	/// so that peakRSS measures the peak of the next run
+	void resetPeakRSS(void);
+
+	/// the number of allocations with operator new since the start of the process
+	size_t allocations(void);
+
+	/// the number of bytes allocated with operator new since the start of the process
+	size_t allocatedBytes(void);
+
+	/// the median of 'v', which must not be empty
+	double median(std::vector<double> v);
+
+	/// the 'p'-th percentile of 'v' by the nearest-rank method, 'v' must not be empty
+	double percentile(std::vector<double> v, double p);
+
+	/// test whether engine 'name' is selected by 'settings'
+	bool isSelected(const BenchmarkSettings& settings, const std::string& name);
+
+	/// time the minimization engines on the workloads of 'settings' and write the results
+	/// to 'os' as JSON
+	void runMinimizationBenchmark(const BenchmarkSettings& settings, std::ostream& os);
+
+	/// time the product, join and producer-consumer operations and their efficient variants
+	/// on the workloads of 'settings' and write the results to 'os' as JSON
+	void runOperationBenchmark(const BenchmarkSettings& settings, std::ostream& os);
+
+}
+
+
+#endif
@@ -0,0 +1,133 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Benchmark of the minimization engines of the calculator on synthetic point clouds
+//
+
+#include "benchmark.h"
+#include "calculator.h"
+#include <chrono>
+#include <functional>
+
+using namespace Pareto;
+
+namespace {
+
+	/// A minimization engine of the calculator
+	struct MinimizationEngine {
+		std::string name;
+		/// true if the engine minimizes sets in columnar storage mode
+		bool columnar;
+		std::function<ConfigurationSetPtr(ConfigurationSetPtr)> minimize;
+	};
+
+	std::vector<MinimizationEngine> minimizationEngines(void) {
+		MinimizeOptions noSweep;
+		noSweep.sweepKernels = false;
+		MinimizeOptions parallel;
+		parallel.parallel = true;
+		return {
+			{ "minimize", false, [](ConfigurationSetPtr cs) { return ParetoCalculator::minimize(cs); } },
+			{ "minimize_SC", false, [](ConfigurationSetPtr cs) { return ParetoCalculator::minimize_SC(cs); } },
+			{ "minimize_SFS", false, [](ConfigurationSetPtr cs) { return ParetoCalculator::minimize_SFS(cs); } },
+			{ "efficient_minimize", false, [](ConfigurationSetPtr cs) { return ParetoCalculator::efficient_minimize(cs); } },
+			{ "efficient_minimize_nosweep", false, [noSweep](ConfigurationSetPtr cs) { return ParetoCalculator::efficient_minimize(cs, noSweep); } },
+			{ "efficient_minimize_parallel", false, [parallel](ConfigurationSetPtr cs) { return ParetoCalculator::efficient_minimize(cs, parallel); } },
+			{ "minimize_columnar", true, [](ConfigurationSetPtr cs) { return ParetoCalculator::minimize(cs); } }
+		};
+	}
+
+}
+
+void Pareto::runMinimizationBenchmark(const BenchmarkSettings& settings, std::ostream& os) {
+	WorkloadGenerator generator(settings.seed);
+	ConfigurationSpacePtr cs = WorkloadGenerator::space("Benchmark", settings.mix);
+	std::vector<MinimizationEngine> engines = minimizationEngines();
+	std::vector<size_t> sizes = settings.sizes.empty() ? std::vector<size_t>{ 10000 } : settings.sizes;
+	unsigned int repeat = (settings.repeat == 0) ? 3 : settings.repeat;
+
+	os << "{" << std::endl;
+	os << "  \"benchmark\": \"minimization\"," << std::endl;
+	os << "  \"mix\": \"" << settings.mix << "\"," << std::endl;
+	os << "  \"seed\": " << settings.seed << "," << std::endl;
+	os << "  \"repeat\": " << repeat << "," << std::endl;
+	os << "  \"workloads\": [";
+	bool firstWorkload = true;
+	for (Distribution d : settings.distributions) {
+		for (size_t n : sizes) {
+			ConfigurationSetPtr nodes = generator.pointCloud(cs, n, d, distributionName(d));
+			ConfigurationSetPtr columns = nodes->toColumnar();
+
+			os << (firstWorkload ? "" : ",") << std::endl;
+			firstWorkload = false;
+			os << "    {" << std::endl;
+			os << "      \"distribution\": \"" << distributionName(d) << "\"," << std::endl;
+			os << "      \"size\": " << n << "," << std::endl;
+			os << "      \"configurations\": " << nodes->size() << "," << std::endl;
+			os << "      \"results\": [";
+
+			// all engines must find fronts of the same size
+			bool consistent = true;
+			size_t frontSize = 0;
+			bool firstResult = true;
+			for (const MinimizationEngine& e : engines) {
+				if (!isSelected(settings, e.name)) continue;
+				std::vector<double> times;
+				size_t size = 0;
+				long rss = 0;
+				for (unsigned int r = 0; r < repeat; r++) {
+					resetPeakRSS();
+					std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+					ConfigurationSetPtr front = e.minimize(e.columnar ? columns : nodes);
+					std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+					times.push_back(std::chrono::duration<double>(stop - start).count());
+					rss = std::max(rss, peakRSS());
+					size = front->size();
+				}
+				if (firstResult) {
+					frontSize = size;
+				}
+				consistent = consistent && size == frontSize;
+				double seconds = median(times);
+
+				os << (firstResult ? "" : ",") << std::endl;
+				firstResult = false;
+				os << "        { \"engine\": \"" << e.name << "\", \"seconds\": " << seconds
+					<< ", \"best_seconds\": " << *std::min_element(times.begin(), times.end())
+					<< ", \"throughput\": " << (seconds > 0.0 ? (double)nodes->size() / seconds : 0.0)
+					<< ", \"peak_rss_kb\": " << rss << ", \"front_size\": " << size << " }";
+			}
+			os << std::endl << "      ]," << std::endl;
+			os << "      \"consistent\": " << (consistent ? "true" : "false") << std::endl;
+			os << "    }";
+		}
+	}
+	os << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
@@ -0,0 +1,220 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Benchmark of the product, join and producer-consumer operations of the calculator
+// against their efficient variants
+//
+
+#include "benchmark.h"
+#include "calculator.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <numeric>
+
+using namespace Pareto;
+
+namespace {
+
+	/// A variant of an operation of the calculator. The variants of an operation compute the
+	/// same result from the producer set and the consumer set on top of the stack.
+	struct OperationVariant {
+		/// the operation, 'product', 'join' or 'prodcons'
+		std::string operation;
+		/// the name of the variant
+		std::string name;
+		/// true if the operands are in columnar storage mode
+		bool columnar;
+		/// the operations to execute
+		ListOfOperations operations;
+	};
+
+	std::vector<OperationVariant> operationVariants(void) {
+		JoinMap keys;
+		keys["Consumer_Key"] = "Producer_Key";
+		std::vector<OperationVariant> variants(6);
+		variants[0] = { "product", "product", false, {} };
+		variants[0].operations.push_back(std::make_shared<POperation_Product>());
+		variants[1] = { "product", "product_columnar", true, {} };
+		variants[1].operations.push_back(std::make_shared<POperation_Product>());
+		variants[2] = { "join", "join", false, {} };
+		variants[2].operations.push_back(std::make_shared<POperation_Join>(keys));
+		variants[3] = { "join", "join_eff", false, {} };
+		variants[3].operations.push_back(std::make_shared<POperation_EfficientJoin>(keys));
+		variants[4] = { "prodcons", "prodcons", false, {} };
+		variants[4].operations.push_back(std::make_shared<POperation_Product>());
+		variants[4].operations.push_back(std::make_shared<POperation_ProdCons>("Producer_Rate", "Consumer_Rate"));
+		variants[5] = { "prodcons", "prodcons_eff", false, {} };
+		variants[5].operations.push_back(std::make_shared<POperation_EfficientProdCons>("Producer_Rate", "Consumer_Rate"));
+		return variants;
+	}
+
+	/// generate an operand 'name' of 'n' configurations with a join key of type 'key', a rate
+	/// drawn from 'rate' for the producer-consumer constraint and payload quantities of 'mix'
+	/// with distribution 'd'
+	ConfigurationSetPtr operand(WorkloadGenerator& g, const std::string& name, QuantityType_EnumPtr key, const std::string& mix,
+		size_t n, Distribution d, std::function<double(void)> rate) {
+		ConfigurationSpacePtr cs = std::make_shared<ConfigurationSpace>(name);
+		cs->addQuantityAs(key, name + "_Key");
+		cs->addQuantityAs(std::make_shared<QuantityType_Real>("Rate"), name + "_Rate");
+		ConfigurationSpacePtr payload = WorkloadGenerator::space(name, mix);
+		for (const QuantityTypePtr& qt : payload->quantities) {
+			cs->addQuantity(qt);
+		}
+
+		ConfigurationSetPtr res = std::make_shared<ConfigurationSet>(cs, name);
+		std::uniform_int_distribution<unsigned int> keyValue(0, (unsigned int)key->quantities.size() - 1);
+		std::vector<double> x(payload->quantities.size());
+		for (size_t k = 0; k < n; k++) {
+			ConfigurationPtr c = res->createConfiguration();
+			c->addQuantity(key->valueWithIndex(keyValue(g.engine)));
+			c->addQuantity(std::make_shared<QuantityValue_Real>(*cs->quantities[1], rate()));
+			g.point(d, x);
+			for (size_t q = 0; q < x.size(); q++) {
+				c->addQuantity(g.valueAt(*payload->quantities[q], x[q]));
+			}
+			res->addConfiguration(c);
+		}
+		return res;
+	}
+
+	/// the measurements of the trials of a variant
+	struct Trials {
+		std::vector<double> seconds;
+		std::vector<double> allocations;
+		std::vector<double> bytes;
+		size_t outputSize = 0;
+	};
+
+	/// execute 'v' 'repeat' times on operands 'producer' and 'consumer'
+	Trials runTrials(const OperationVariant& v, ConfigurationSetPtr producer, ConfigurationSetPtr consumer, unsigned int repeat) {
+		Trials t;
+		ParetoCalculator c;
+		c.setStorageMode(v.columnar ? StorageMode::Columnar : StorageMode::Nodes);
+		for (unsigned int r = 0; r < repeat; r++) {
+			c.push(producer);
+			c.push(consumer);
+			size_t allocs = allocations();
+			size_t bytes = allocatedBytes();
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			for (const ParetoCalculatorOperationPtr& op : v.operations) {
+				op->executeOn(c);
+			}
+			std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+			t.seconds.push_back(std::chrono::duration<double>(stop - start).count());
+			t.allocations.push_back((double)(allocations() - allocs));
+			t.bytes.push_back((double)(allocatedBytes() - bytes));
+			t.outputSize = c.popConfigurationSet()->size();
+		}
+		return t;
+	}
+
+}
+
+void Pareto::runOperationBenchmark(const BenchmarkSettings& settings, std::ostream& os) {
+	WorkloadGenerator generator(settings.seed);
+	std::vector<OperationVariant> variants = operationVariants();
+	std::vector<size_t> sizes = settings.sizes.empty() ? std::vector<size_t>{ 300 } : settings.sizes;
+	unsigned int repeat = (settings.repeat == 0) ? 10 : settings.repeat;
+
+	os << "{" << std::endl;
+	os << "  \"benchmark\": \"operations\"," << std::endl;
+	os << "  \"mix\": \"" << settings.mix << "\"," << std::endl;
+	os << "  \"seed\": " << settings.seed << "," << std::endl;
+	os << "  \"repeat\": " << repeat << "," << std::endl;
+	os << "  \"workloads\": [";
+	bool firstWorkload = true;
+	for (Distribution d : settings.distributions) {
+		for (size_t n : sizes) {
+			for (size_t s = 0; s < settings.selectivities.size(); s++) {
+				double selectivity = settings.selectivities[s];
+
+				// a join key with 1/selectivity values, so that the fraction of the pairs with
+				// equal keys is the selectivity
+				unsigned int nrOfKeys = (unsigned int)std::max(1L, std::lround(1.0 / selectivity));
+				QuantityType_EnumPtr key = std::make_shared<QuantityType_Enum_Unordered>("Key");
+				for (unsigned int k = 0; k < nrOfKeys; k++) {
+					key->addQuantity("K" + std::to_string(k));
+				}
+
+				// consumer rates u are uniform on [0,1], producer rates are 1/v with v uniform on an
+				// interval with mean 'selectivity', so that u <= 1/(1/v) for that fraction of the pairs
+				std::uniform_real_distribution<double> unit(0.0, 1.0);
+				std::uniform_real_distribution<double> inverse(std::max(0.0, 2.0 * selectivity - 1.0), std::min(1.0, 2.0 * selectivity));
+				ConfigurationSetPtr producer = operand(generator, "Producer", key, settings.mix, n, d,
+					[&]() { return 1.0 / std::max(inverse(generator.engine), 1e-9); });
+				ConfigurationSetPtr consumer = operand(generator, "Consumer", key, settings.mix, n, d,
+					[&]() { return unit(generator.engine); });
+
+				os << (firstWorkload ? "" : ",") << std::endl;
+				firstWorkload = false;
+				os << "    {" << std::endl;
+				os << "      \"distribution\": \"" << distributionName(d) << "\"," << std::endl;
+				os << "      \"size\": " << n << "," << std::endl;
+				os << "      \"selectivity\": " << selectivity << "," << std::endl;
+				os << "      \"keys\": " << nrOfKeys << "," << std::endl;
+				os << "      \"results\": [";
+
+				// the variants of an operation must give results of the same size
+				bool consistent = true;
+				std::map<std::string, size_t> outputSizes;
+				bool firstResult = true;
+				for (const OperationVariant& v : variants) {
+					// the product does not depend on the selectivity
+					if (!isSelected(settings, v.name) || (v.operation == "product" && s > 0)) continue;
+					Trials t = runTrials(v, producer, consumer, repeat);
+					if (outputSizes.find(v.operation) == outputSizes.end()) {
+						outputSizes[v.operation] = t.outputSize;
+					}
+					consistent = consistent && outputSizes[v.operation] == t.outputSize;
+
+					os << (firstResult ? "" : ",") << std::endl;
+					firstResult = false;
+					os << "        { \"operation\": \"" << v.operation << "\", \"variant\": \"" << v.name << "\"," << std::endl;
+					os << "          \"latency_seconds\": { \"min\": " << percentile(t.seconds, 0.0)
+						<< ", \"p50\": " << percentile(t.seconds, 50.0)
+						<< ", \"p90\": " << percentile(t.seconds, 90.0)
+						<< ", \"p99\": " << percentile(t.seconds, 99.0)
+						<< ", \"max\": " << percentile(t.seconds, 100.0)
+						<< ", \"mean\": " << std::accumulate(t.seconds.begin(), t.seconds.end(), 0.0) / (double)t.seconds.size() << " }," << std::endl;
+					os << "          \"allocations\": " << (size_t)median(t.allocations)
+						<< ", \"allocated_bytes\": " << (size_t)median(t.bytes)
+						<< ", \"output_size\": " << t.outputSize << " }";
+				}
+				os << std::endl << "      ]," << std::endl;
+				os << "      \"consistent\": " << (consistent ? "true" : "false") << std::endl;
+				os << "    }";
+			}
+		}
+	}
+	os << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
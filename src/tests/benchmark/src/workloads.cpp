@@ -0,0 +1,147 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Generators of synthetic sets of configurations for the benchmarks
+//
+
+#include "workloads.h"
+#include "columns.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+using namespace Pareto;
+
+/// the number of values of the generated enumeration types
+#define ORDERED_LEVELS 8
+#define UNORDERED_VALUES 4
+
+std::string Pareto::distributionName(Distribution d) {
+	switch (d) {
+	case Distribution::Correlated: return "correlated";
+	case Distribution::Independent: return "independent";
+	default: return "anticorrelated";
+	}
+}
+
+WorkloadGenerator::WorkloadGenerator(unsigned int seed) : engine(seed) {
+}
+
+ConfigurationSpacePtr WorkloadGenerator::space(const std::string& name, const std::string& mix) {
+	ConfigurationSpacePtr cs = std::make_shared<ConfigurationSpace>(name);
+	for (size_t k = 0; k < mix.size(); k++) {
+		std::string qname = name + "_Q" + std::to_string(k);
+		QuantityTypePtr qt;
+		if (mix[k] == 'r') {
+			qt = std::make_shared<QuantityType_Real>(qname);
+		}
+		else if (mix[k] == 'i') {
+			qt = std::make_shared<QuantityType_Integer>(qname);
+		}
+		else if (mix[k] == 'o' || mix[k] == 'u') {
+			QuantityType_EnumPtr qe;
+			if (mix[k] == 'o')
+				qe = std::make_shared<QuantityType_Enum>(qname);
+			else
+				qe = std::make_shared<QuantityType_Enum_Unordered>(qname);
+			int n = (mix[k] == 'o') ? ORDERED_LEVELS : UNORDERED_VALUES;
+			for (int v = 0; v < n; v++) {
+				qe->addQuantity(std::string(1, (char)std::toupper(mix[k])) + std::to_string(v));
+			}
+			qt = qe;
+		}
+		else {
+			throw EParetoCalculatorError(std::string("Unknown quantity kind '") + mix[k] + "' in " + mix);
+		}
+		cs->addQuantity(qt);
+	}
+	return cs;
+}
+
+void WorkloadGenerator::point(Distribution d, std::vector<double>& x) {
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+	switch (d) {
+	case Distribution::Independent:
+		for (double& xi : x) xi = uniform(engine);
+		break;
+	case Distribution::Correlated: {
+		// a point on the diagonal with a little noise in every dimension
+		std::normal_distribution<double> diagonal(0.5, 0.25);
+		std::normal_distribution<double> noise(0.0, 0.05);
+		double v = diagonal(engine);
+		for (double& xi : x) xi = v + noise(engine);
+		break;
+	}
+	default: {
+		// a point on the plane through the diagonal point v with a constant sum of coordinates
+		std::normal_distribution<double> plane(0.5, 0.05);
+		double v = plane(engine);
+		double mean = 0.0;
+		for (double& xi : x) {
+			xi = uniform(engine) - 0.5;
+			mean += xi;
+		}
+		mean /= (double)x.size();
+		for (double& xi : x) xi = v + xi - mean;
+	}
+	}
+}
+
+QuantityValuePtr WorkloadGenerator::valueAt(const QuantityType& qt, double x) {
+	switch (columnKindOf(qt)) {
+	case ColumnKind::Real:
+		return std::make_shared<QuantityValue_Real>(qt, x);
+	case ColumnKind::Integer:
+		return std::make_shared<QuantityValue_Integer>(qt, (int)std::lround(x * 1000.0));
+	case ColumnKind::Enum: {
+		int level = std::min(std::max((int)std::floor(x * ORDERED_LEVELS), 0), ORDERED_LEVELS - 1);
+		return static_cast<const QuantityType_Enum&>(qt).valueWithIndex(level);
+	}
+	default: {
+		const QuantityType_Enum& qe = static_cast<const QuantityType_Enum&>(qt);
+		std::uniform_int_distribution<unsigned int> value(0, (unsigned int)qe.quantities.size() - 1);
+		return qe.valueWithIndex(value(engine));
+	}
+	}
+}
+
+ConfigurationSetPtr WorkloadGenerator::pointCloud(ConfigurationSpacePtr cs, size_t n, Distribution d, const std::string& name) {
+	ConfigurationSetPtr res = std::make_shared<ConfigurationSet>(cs, name);
+	std::vector<double> x(cs->quantities.size());
+	for (size_t k = 0; k < n; k++) {
+		this->point(d, x);
+		ConfigurationPtr c = res->createConfiguration();
+		for (size_t q = 0; q < x.size(); q++) {
+			c->addQuantity(this->valueAt(*cs->quantities[q], x[q]));
+		}
+		res->addConfiguration(c);
+	}
+	return res;
+}
@@ -0,0 +1,85 @@
+//
+// The MIT License
+//
+// Copyright (c) 2008-2019 Eindhoven University of Technology
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+
+//
+// Author: Marc Geilen, e-mail: m.c.w.geilen@tue.nl
+// Electronic Systems Group (ES), Department of Electrical Engineering,
+// Eindhoven University of Technology
+//
+// Description:
+// Generators of synthetic sets of configurations for the benchmarks
+//
+
+#pragma once
+
+#ifndef TESTS_WORKLOADS_H
+#define TESTS_WORKLOADS_H
+
+#include <string>
+#include <random>
+#include <vector>
+#include "configuration.h"
+
+
+namespace Pareto {
+
+	/// The shapes of the generated point clouds, after Borzsonyi, Kossmann and Stocker,
+	/// "The Skyline Operator". Correlated points lie close to the diagonal and have small
+	/// fronts, anti-correlated points lie close to a hyperplane orthogonal to the diagonal
+	/// and have large fronts.
+	enum class Distribution { Correlated, Independent, AntiCorrelated };
+
+	/// the name of distribution 'd'
+	std::string distributionName(Distribution d);
+
+	/// Generates configuration spaces and sets of configurations with a reproducible
+	/// sequence of pseudo random values
+	class WorkloadGenerator {
+	public:
+		WorkloadGenerator(unsigned int seed);
+
+		/// create a configuration space 'name' with a quantity for every character of 'mix':
+		/// 'r' real, 'i' integer, 'o' ordered enumeration and 'u' unordered enumeration.
+		/// Throws an exception for other characters.
+		static ConfigurationSpacePtr space(const std::string& name, const std::string& mix);
+
+		/// generate a set 'name' of 'n' configurations of space 'cs', of which the totally
+		/// ordered quantities follow distribution 'd' and the unordered quantities are uniform.
+		/// Equal configurations are generated only once, so the set may be smaller than 'n'.
+		ConfigurationSetPtr pointCloud(ConfigurationSpacePtr cs, size_t n, Distribution d, const std::string& name);
+
+		/// a value of quantity type 'qt' for the coordinate 'x', which lies roughly in [0,1]
+		QuantityValuePtr valueAt(const QuantityType& qt, double x);
+
+		/// fill the coordinates of 'x' with a point of distribution 'd'
+		void point(Distribution d, std::vector<double>& x);
+
+		/// the random number engine, which is specified exactly by the standard
+		std::mt19937 engine;
+	};
+
+}
+
+
+#endif
@@ -15,13 +15,18 @@ if( NOT output_test )
     message( FATAL_ERROR "Variable output_test not defined" )
 endif()
 
+# compare_cmd is the script that compares the output to the blessed output
+if( NOT compare_cmd )
+    message( FATAL_ERROR "Variable compare_cmd not defined" )
+endif()
+
 execute_process(
-    COMMAND ${test_cmd} ${test_cmd_arg1} ${test_cmd_arg2}
+    COMMAND ${test_cmd} ${test_cmd_arg1} ${test_cmd_arg2} ${test_cmd_arg3} ${test_cmd_arg4} ${test_cmd_arg5}
     OUTPUT_FILE ${output_test}
 )
 
 execute_process(
-    COMMAND ${CMAKE_SOURCE_DIR}/scripts/compareoutput ${output_blessed} ${output_test}
+    COMMAND bash ${compare_cmd} ${output_blessed} ${output_test}
     RESULT_VARIABLE test_not_successful
     OUTPUT_VARIABLE OUTVAR
 )
@@ -30,4 +35,5 @@ if( test_not_successful )
     EXECUTE_PROCESS (
 	COMMAND diff ${output_blessed} ${output_test}
     )
+    message( FATAL_ERROR "Output differs from ${output_blessed}" )
 endif( test_not_successful )
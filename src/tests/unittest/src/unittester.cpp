@@ -38,6 +38,27 @@
 
 #include "quantity.h"
 #include "configuration.h"
+#include "dominance.h"
+#include "dominancefilter.h"
+#include "join.h"
+#include "pipeline.h"
+#include "plan.h"
+#include "records.h"
+#include "taskpool.h"
+#include "archive.h"
+#include "arena.h"
+#include "autotuner.h"
+#include "binaryformat.h"
+#include "minimizetrace.h"
+#include "paretoparser_dsl.h"
+#include "sortfilter.h"
+#include "sweep.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
 
 #define ASSERT_THROW( condition, msg )                              \
 {                                                                   \
@@ -98,7 +119,30 @@ bool UnitTester::test_all(void) {
 
 bool UnitTester::test_calculator(void) {
 	ASSERT_THROW(this->test_PCStore(), "Store test failed.");
+	ASSERT_THROW(this->test_ColumnarStorage(), "Columnar storage test failed.");
+	ASSERT_THROW(this->test_DominanceKernel(), "Dominance kernel test failed.");
+	ASSERT_THROW(this->test_DominanceFilter(), "Dominance filter test failed.");
 	ASSERT_THROW(this->test_DCMinimization(), "Divide and Conquer minimization failed.");
+	ASSERT_THROW(this->test_ParallelMinimization(), "Parallel Divide and Conquer minimization failed.");
+	ASSERT_THROW(this->test_MinimizeOptions(), "Minimization options test failed.");
+	ASSERT_THROW(this->test_Autotuning(), "Autotuning test failed.");
+	ASSERT_THROW(this->test_SortFilterMinimization(), "Sort-filter-skyline minimization failed.");
+	ASSERT_THROW(this->test_SweepKernels(), "Sweep minimization failed.");
+	ASSERT_THROW(this->test_ConfigurationArena(), "Configuration arena test failed.");
+	ASSERT_THROW(this->test_InternedEnumValues(), "Interned enumerated values test failed.");
+	ASSERT_THROW(this->test_HashJoin(), "Hash join test failed.");
+	ASSERT_THROW(this->test_ProductPipeline(), "Streaming product pipeline test failed.");
+	ASSERT_THROW(this->test_ProductFront(), "Pareto product front test failed.");
+	ASSERT_THROW(this->test_OperationPlan(), "Operation plan test failed.");
+	ASSERT_THROW(this->test_ConcurrentPlan(), "Concurrent plan test failed.");
+	ASSERT_THROW(this->test_ParetoArchive(), "Pareto archive test failed.");
+	ASSERT_THROW(this->test_OnlineMinimization(), "Online minimization test failed.");
+	ASSERT_THROW(this->test_BinaryFormat(), "Binary file format test failed.");
+	ASSERT_THROW(this->test_DSLParser(), ".pareto parser test failed.");
+	ASSERT_THROW(this->test_XMLParser(), "XML parser test failed.");
+	ASSERT_THROW(this->test_Profiling(), "Profiling test failed.");
+	ASSERT_THROW(this->test_MinimizeTrace(), "Minimization trace test failed.");
+	ASSERT_THROW(this->test_SortedConfigurationRange(), "Sorted configuration range test failed.");
 	return true;
 }
 
@@ -187,9 +231,9 @@ bool UnitTester::test_DCMinimization(void) {
 		c->addQuantity(qC);
 		QuantityValuePtr qD = std::make_shared<QuantityValue_Real>(*TD, dis_real(this->generator));
 		c->addQuantity(qD);
-		QuantityValuePtr qE = std::make_shared<QuantityValue_Enum>(*TE, dis_enum(this->generator));
+		QuantityValuePtr qE = TE->valueWithIndex(dis_enum(this->generator));
 		c->addQuantity(qE);
-		QuantityValuePtr qF = std::make_shared<QuantityValue_Enum>(*TF, dis_enum(this->generator));
+		QuantityValuePtr qF = TF->valueWithIndex(dis_enum(this->generator));
 		c->addQuantity(qF);
 		C->addConfiguration(c);
 	}
@@ -203,7 +247,1785 @@ bool UnitTester::test_DCMinimization(void) {
 	ConfigurationSetPtr CM3 = PC.constraint(CM1, CM2);
 
 	// check that the number of Pareto points are equal
-	ASSERT_EQUAL(CM1->confs.size(), CM3->confs.size(), "DC and SC minimization give different results.")
+	ASSERT_EQUAL(CM1->confs().size(), CM3->confs().size(), "DC and SC minimization give different results.")
 
 	return true;
-}
\ No newline at end of file
+}
+
+bool UnitTester::test_ColumnarStorage(void) {
+
+	// create a configuration space with all kinds of quantities
+	ConfigurationSpacePtr CS = std::make_shared< ConfigurationSpace>("TestColumnar");
+	QuantityTypePtr TA = std::make_shared<QuantityType_Integer>("QuantityA");
+	QuantityTypePtr TB = std::make_shared<QuantityType_Real>("QuantityB");
+	QuantityType_EnumPtr TE = std::make_shared<QuantityType_Enum_Unordered>("QuantityE_Unordered");
+	TE->addQuantity("U1");
+	TE->addQuantity("U2");
+	TE->addQuantity("U3");
+	QuantityType_EnumPtr TF = std::make_shared<QuantityType_Enum>("QuantityF_Ordered");
+	// names not in the order of the values
+	TF->addQuantity("O3");
+	TF->addQuantity("O1");
+	TF->addQuantity("O2");
+
+	CS->addQuantity(TA);
+	CS->addQuantity(TB);
+	CS->addQuantity(TE);
+	CS->addQuantity(TF);
+
+	// create random configuration set
+	ConfigurationSetPtr C = std::make_shared<ConfigurationSet>(CS, "TestConfigurationSet");
+	std::uniform_int_distribution<> dis_int(1, 100);
+	std::uniform_int_distribution<> dis_enum(0, 2);
+	std::uniform_real_distribution<> dis_real(1.0, 2.0);
+	for (unsigned int i = 0; i < 500; i++) {
+		ConfigurationPtr c = std::make_shared<Configuration>(CS);
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TA, dis_int(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TB, dis_real(this->generator)));
+		c->addQuantity(TE->quantities[dis_enum(this->generator)]);
+		c->addQuantity(TF->quantities[dis_enum(this->generator)]);
+		C->addConfiguration(c);
+	}
+
+	ConfigurationSetPtr CC = C->toColumnar();
+	ASSERT_THROW(CC->isColumnar(), "Set is not in columnar storage.")
+	ASSERT_EQUAL(C->size(), CC->size(), "Packing changes the number of configurations.")
+
+	// minimization in both storage modes must give the same Pareto points
+	ConfigurationSetPtr M1 = PC.minimize(C);
+	ConfigurationSetPtr M2 = PC.minimize(CC);
+	ASSERT_THROW(M2->isColumnar(), "Columnar minimization gives node storage.")
+	ASSERT_EQUAL(M1->size(), M2->size(), "Minimization on columns gives different results.")
+	ASSERT_EQUAL(M1->size(), PC.constraint(M1, M2)->size(), "Minimization on columns gives different results.")
+
+	// the divide and conquer minimization of columns honours its options
+	MinimizeStatistics stats;
+	MinimizeOptions options;
+	options.sweepKernels = false;
+	options.minimizeThreshold = 10;
+	options.statistics = &stats;
+	ConfigurationSetPtr M4 = PC.efficient_minimize(CC, options);
+	ASSERT_THROW(M4->isColumnar(), "Efficient minimization of columns gives node storage.")
+	ASSERT_THROW(stats.splits > 0, "Efficient minimization of columns does not recurse.")
+	ASSERT_EQUAL(M1->size(), PC.constraint(M1, M4)->size(), "Efficient minimization on columns gives different results.")
+	ASSERT_EQUAL(M1->size(), M4->size(), "Efficient minimization on columns gives different results.")
+
+	// product, abstraction and constraint
+	ConfigurationSpacePtr CS2 = std::make_shared< ConfigurationSpace>("TestColumnar2");
+	QuantityTypePtr TG = std::make_shared<QuantityType_Integer>("QuantityG");
+	CS2->addQuantity(TG);
+	ConfigurationSetPtr G = std::make_shared<ConfigurationSet>(CS2, "TestConfigurationSet2");
+	for (int i = 0; i < 3; i++) {
+		ConfigurationPtr c = std::make_shared<Configuration>(CS2);
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TG, i));
+		G->addConfiguration(c);
+	}
+	ConfigurationSetPtr P1 = PC.abstraction(PC.product(M1, G), 0);
+	ConfigurationSetPtr P2 = PC.abstraction(PC.product(M2, G), 0);
+	ASSERT_EQUAL(P1->size(), P2->size(), "Product and abstraction on columns give different results.")
+	ASSERT_EQUAL(P1->size(), PC.constraint(P2, P1)->size(), "Product and abstraction on columns give different results.")
+
+	// the view on the columns contains the same configurations, it is materialized on the first access
+	ASSERT_EQUAL(M1->confs().size(), M2->confs().size(), "The view on the columns is incomplete.")
+	ASSERT_THROW(M2->isColumnar(), "Access to the view changes the storage mode.")
+	ASSERT_THROW(M2->containsConfiguration(*M1->confs().begin()), "The view on the columns is incorrect.")
+	ConfigurationSetPtr M3 = PC.minimize(CC);
+	const ConfigurationSet& constant = *M3;
+	ASSERT_EQUAL(constant.confs().size(), M1->size(), "The view on the columns of a constant set is incomplete.")
+
+	return true;
+}
+
+bool UnitTester::test_DominanceKernel(void) {
+
+	// create a configuration space with a hidden quantity
+	ConfigurationSpacePtr CS = std::make_shared< ConfigurationSpace>("TestKernel");
+	QuantityTypePtr TA = std::make_shared<QuantityType_Integer>("QuantityA");
+	QuantityTypePtr TB = std::make_shared<QuantityType_Real>("QuantityB");
+	QuantityType_EnumPtr TE = std::make_shared<QuantityType_Enum_Unordered>("QuantityE_Unordered");
+	TE->addQuantity("U1");
+	TE->addQuantity("U2");
+	QuantityType_EnumPtr TF = std::make_shared<QuantityType_Enum>("QuantityF_Ordered");
+	TF->addQuantity("O2");
+	TF->addQuantity("O1");
+	CS->addQuantity(TA);
+	CS->addQuantity(TB);
+	CS->addQuantity(TE);
+	CS->addQuantity(TF);
+	CS->addQuantityAsVisibility(TA, "HiddenA", false);
+
+	std::uniform_int_distribution<> dis_int(1, 3);
+	std::uniform_int_distribution<> dis_enum(0, 1);
+	std::uniform_real_distribution<> dis_real(1.0, 1.5);
+	std::vector<ConfigurationPtr> confs;
+	for (unsigned int i = 0; i < 50; i++) {
+		ConfigurationPtr c = std::make_shared<Configuration>(CS);
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TA, dis_int(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TB, dis_real(this->generator) < 1.25 ? 1.0 : 2.0));
+		c->addQuantity(TE->quantities[dis_enum(this->generator)]);
+		c->addQuantity(TF->quantities[dis_enum(this->generator)]);
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TA, dis_int(this->generator)));
+		confs.push_back(c);
+	}
+
+	// compare the kernel to dominance tested quantity by quantity
+	const DominanceKernel& dk = CS->dominanceKernel();
+	ASSERT_EQUAL(dk.integers.size(), 1, "Hidden quantity is not ignored.")
+	for (const ConfigurationPtr& c1 : confs) {
+		for (const ConfigurationPtr& c2 : confs) {
+			bool d = true;
+			for (unsigned int k = 0; k < 4; k++) {
+				d = d && (*c1->getQuantity(k) <= *c2->getQuantity(k));
+			}
+			ASSERT_THROW(dk.dominates(*c1, *c2) == d, "Dominance kernel gives a different result.")
+		}
+	}
+	return true;
+}
+
+bool UnitTester::test_DominanceFilter(void) {
+
+	// create a configuration space with an unordered quantity
+	ConfigurationSpacePtr CS = std::make_shared< ConfigurationSpace>("TestFilter");
+	QuantityTypePtr TA = std::make_shared<QuantityType_Integer>("QuantityA");
+	QuantityTypePtr TB = std::make_shared<QuantityType_Real>("QuantityB");
+	QuantityType_EnumPtr TE = std::make_shared<QuantityType_Enum_Unordered>("QuantityE_Unordered");
+	TE->addQuantity("U1");
+	TE->addQuantity("U2");
+	CS->addQuantity(TA);
+	CS->addQuantity(TB);
+	CS->addQuantity(TE);
+
+	// two random lists of configurations, of sizes that are not a multiple of the block size
+	std::uniform_int_distribution<> dis_int(1, 20);
+	std::uniform_int_distribution<> dis_enum(0, 1);
+	std::uniform_real_distribution<> dis_real(1.0, 2.0);
+	std::vector<ConfigurationPtr> confs;
+	std::vector<const Configuration*> ca, cb;
+	for (unsigned int i = 0; i < 120; i++) {
+		ConfigurationPtr c = std::make_shared<Configuration>(CS);
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TA, dis_int(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TB, dis_real(this->generator)));
+		c->addQuantity(TE->quantities[dis_enum(this->generator)]);
+		confs.push_back(c);
+		if (i < 37) ca.push_back(c.get());
+		else cb.push_back(c.get());
+	}
+	PackedConfigurations pa(*CS, ca);
+	PackedConfigurations pb(*CS, cb);
+
+	// the reference result
+	const DominanceKernel& dk = CS->dominanceKernel();
+	std::vector<bool> expected;
+	for (const Configuration* b : cb) {
+		bool alive = true;
+		for (const Configuration* a : ca) alive = alive && !dk.dominates(*a, *b);
+		expected.push_back(alive);
+	}
+
+	// all supported instruction sets must give the reference result
+	DominanceFilter::InstructionSet original = DominanceFilter::active();
+	DominanceFilter::InstructionSet sets[] = { DominanceFilter::InstructionSet::Scalar, DominanceFilter::InstructionSet::AVX2, DominanceFilter::InstructionSet::AVX512 };
+	for (DominanceFilter::InstructionSet is : sets) {
+		DominanceFilter::select(is);
+		std::vector<uint8_t> alive = DominanceFilter::survivors(pa, pb);
+		for (size_t k = 0; k < cb.size(); k++) {
+			bool survives = (alive[k / PackedConfigurations::BlockSize] & (1 << (k % PackedConfigurations::BlockSize))) != 0;
+			ASSERT_THROW(survives == expected[k], "Dominance filter gives a different result.")
+		}
+	}
+	DominanceFilter::select(original);
+	return true;
+}
+
+bool UnitTester::test_ParallelMinimization(void) {
+
+	// tasks forked on a pool are executed and their exceptions are passed to join
+	TaskPool pool(3);
+	std::vector<int> results(100, 0);
+	std::vector<TaskPtr> tasks;
+	for (int i = 0; i < 100; i++) {
+		tasks.push_back(pool.fork([&results, i]() { results[i] = i * i; }));
+	}
+	for (const TaskPtr& t : tasks) pool.join(t);
+	for (int i = 0; i < 100; i++) {
+		ASSERT_EQUAL(results[i], i * i, "Task pool did not execute all tasks.")
+	}
+	TaskPtr failing = pool.fork([]() { throw EParetoCalculatorError("task failure"); });
+	bool caught = false;
+	try {
+		pool.join(failing);
+	}
+	catch (const EParetoCalculatorError&) {
+		caught = true;
+	}
+	ASSERT_THROW(caught, "Task pool did not pass on the exception of a task.")
+
+	// a thread that joins a running task without other work to do sleeps until the task has finished
+	std::atomic<bool> started{ false };
+	std::atomic<bool> finished{ false };
+	TaskPtr slow = pool.fork([&started, &finished]() {
+		started.store(true);
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		finished.store(true);
+	});
+	while (!started.load()) std::this_thread::yield();
+	pool.join(slow);
+	ASSERT_THROW(finished.load(), "Join returned before the task finished.")
+
+	// create a configuration space with an unordered and totally ordered quantities
+	ConfigurationSpacePtr CS = std::make_shared< ConfigurationSpace>("TestParallel");
+	QuantityTypePtr TA = std::make_shared<QuantityType_Integer>("QuantityA");
+	QuantityTypePtr TB = std::make_shared<QuantityType_Real>("QuantityB");
+	QuantityTypePtr TC = std::make_shared<QuantityType_Integer>("QuantityC");
+	QuantityType_EnumPtr TE = std::make_shared<QuantityType_Enum_Unordered>("QuantityE_Unordered");
+	TE->addQuantity("U1");
+	TE->addQuantity("U2");
+	TE->addQuantity("U3");
+	CS->addQuantity(TA);
+	CS->addQuantity(TB);
+	CS->addQuantity(TC);
+	CS->addQuantity(TE);
+
+	// create random configuration set
+	ConfigurationSetPtr C = std::make_shared<ConfigurationSet>(CS, "TestConfigurationSet");
+	std::uniform_int_distribution<> dis_int(1, 1000);
+	std::uniform_int_distribution<> dis_enum(0, 2);
+	std::uniform_real_distribution<> dis_real(1.0, 2.0);
+	for (unsigned int i = 0; i < 2000; i++) {
+		ConfigurationPtr c = std::make_shared<Configuration>(CS);
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TA, dis_int(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TB, dis_real(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TC, dis_int(this->generator)));
+		c->addQuantity(TE->quantities[dis_enum(this->generator)]);
+		C->addConfiguration(c);
+	}
+
+	// use low thresholds and a small grain to fork many subproblems
+	MinimizeStatistics stats;
+	MinimizeOptions options;
+	options.minimizeThreshold = 10;
+	options.filterThreshold = 10;
+	options.parallel = true;
+	options.grain = 50;
+	options.pool = &pool;
+	options.statistics = &stats;
+	ConfigurationSetPtr CM1 = PC.efficient_minimize(C, options);
+	ConfigurationSetPtr CM2 = PC.efficient_minimize(C, 10, 10);
+	ASSERT_THROW(stats.tasks > 0, "Parallel minimization did not fork any tasks.")
+
+	// check if both sets are equal by computing their intersection
+	ConfigurationSetPtr CM3 = PC.constraint(CM1, CM2);
+	ASSERT_EQUAL(CM1->confs().size(), CM2->confs().size(), "Parallel and sequential minimization give different results.")
+	ASSERT_EQUAL(CM1->confs().size(), CM3->confs().size(), "Parallel and sequential minimization give different results.")
+
+	return true;
+}
+
+bool UnitTester::test_MinimizeOptions(void) {
+
+	// create a configuration space with two totally ordered quantities
+	ConfigurationSpacePtr CS = std::make_shared< ConfigurationSpace>("TestOptions");
+	QuantityTypePtr TA = std::make_shared<QuantityType_Integer>("QuantityA");
+	QuantityTypePtr TB = std::make_shared<QuantityType_Real>("QuantityB");
+	CS->addQuantity(TA);
+	CS->addQuantity(TB);
+
+	ConfigurationSetPtr C = std::make_shared<ConfigurationSet>(CS, "TestConfigurationSet");
+	std::uniform_int_distribution<> dis_int(1, 1000);
+	std::uniform_real_distribution<> dis_real(1.0, 2.0);
+	for (unsigned int i = 0; i < 500; i++) {
+		ConfigurationPtr c = std::make_shared<Configuration>(CS);
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TA, dis_int(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TB, dis_real(this->generator)));
+		C->addConfiguration(c);
+	}
+
+	// divide and conquer with the simple cull base case, without the two-dimensional sweep
+	MinimizeStatistics stats1;
+	MinimizeOptions recursive;
+	recursive.sweepKernels = false;
+	recursive.minimizeThreshold = 10;
+	recursive.filterThreshold = 10;
+	recursive.baseCase = MinimizeAlgorithm::SimpleCull;
+	recursive.statistics = &stats1;
+	ConfigurationSetPtr CM1 = PC.efficient_minimize(C, recursive);
+	ASSERT_THROW(stats1.splits > 0 && stats1.baseCases > 0, "Divide and conquer minimization did not recurse.")
+
+	// the options of one minimization do not affect the next one
+	MinimizeStatistics stats2;
+	MinimizeOptions direct;
+	direct.sweepKernels = false;
+	direct.statistics = &stats2;
+	ConfigurationSetPtr CM2 = PC.efficient_minimize(C, direct);
+	ASSERT_EQUAL(stats2.splits.load(), 0ul, "Default thresholds were not used.")
+	ASSERT_EQUAL(stats2.baseCases.load(), 1ul, "Default thresholds were not used.")
+
+	ConfigurationSetPtr CM3 = PC.constraint(CM1, CM2);
+	ASSERT_EQUAL(CM1->confs().size(), CM2->confs().size(), "Minimization options give different results.")
+	ASSERT_EQUAL(CM1->confs().size(), CM3->confs().size(), "Minimization options give different results.")
+
+	// thresholds below two recurse down to single configurations
+	for (unsigned int threshold : { 0u, 1u }) {
+		MinimizeOptions small = recursive;
+		small.minimizeThreshold = threshold;
+		small.statistics = nullptr;
+		ASSERT_EQUAL(PC.efficient_minimize(C, small)->confs().size(), CM1->confs().size(), "Minimization with a threshold below two gives a different result.")
+	}
+
+	return true;
+}
+
+bool UnitTester::test_Autotuning(void) {
+
+	// create a configuration space with three totally ordered quantities
+	ConfigurationSpacePtr CS = std::make_shared< ConfigurationSpace>("TestTuning");
+	QuantityTypePtr TA = std::make_shared<QuantityType_Integer>("QuantityA");
+	QuantityTypePtr TB = std::make_shared<QuantityType_Real>("QuantityB");
+	QuantityTypePtr TC = std::make_shared<QuantityType_Real>("QuantityC");
+	CS->addQuantity(TA);
+	CS->addQuantity(TB);
+	CS->addQuantity(TC);
+
+	ConfigurationSetPtr C = std::make_shared<ConfigurationSet>(CS, "TestConfigurationSet");
+	std::uniform_int_distribution<> dis_int(1, 1000);
+	std::uniform_real_distribution<> dis_real(1.0, 2.0);
+	for (unsigned int i = 0; i < 1000; i++) {
+		ConfigurationPtr c = std::make_shared<Configuration>(CS);
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TA, dis_int(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TB, dis_real(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TC, dis_real(this->generator)));
+		C->addConfiguration(c);
+	}
+
+	// tune while minimizing and store the profile
+	const std::string profile = "TestAutotuning.profile";
+	std::remove(profile.c_str());
+	TunedThresholds t;
+	ConfigurationSetPtr CM1;
+	{
+		ThresholdTuner tuner(profile);
+		MinimizeOptions options;
+		options.tuner = &tuner;
+		CM1 = PC.efficient_minimize(C, options);
+		ASSERT_THROW(tuner.hasThresholds(3), "No thresholds were tuned.")
+		t = tuner.thresholds(3);
+		ASSERT_THROW(t.minimizeThreshold > 0 && t.filterThreshold > 0, "Invalid thresholds were tuned.")
+	}
+
+	// a new tuner loads the profile
+	ThresholdTuner loaded(profile);
+	ASSERT_THROW(loaded.hasThresholds(3), "The tuning profile was not loaded.")
+	ASSERT_EQUAL(loaded.thresholds(3).minimizeThreshold, t.minimizeThreshold, "The tuning profile was not loaded correctly.")
+	ASSERT_EQUAL(loaded.thresholds(3).filterThreshold, t.filterThreshold, "The tuning profile was not loaded correctly.")
+	std::remove(profile.c_str());
+
+	// tuning does not change the result
+	ConfigurationSetPtr CM2 = PC.minimize(C);
+	ConfigurationSetPtr CM3 = PC.constraint(CM1, CM2);
+	ASSERT_EQUAL(CM1->confs().size(), CM2->confs().size(), "Tuned minimization gives a different result.")
+	ASSERT_EQUAL(CM1->confs().size(), CM3->confs().size(), "Tuned minimization gives a different result.")
+
+	return true;
+}
+
+bool UnitTester::test_SortFilterMinimization(void) {
+
+	// create a configuration space with ordered, unordered and hidden quantities
+	ConfigurationSpacePtr CS = std::make_shared< ConfigurationSpace>("TestSFS");
+	QuantityTypePtr TA = std::make_shared<QuantityType_Integer>("QuantityA");
+	QuantityTypePtr TB = std::make_shared<QuantityType_Real>("QuantityB");
+	QuantityTypePtr TH = std::make_shared<QuantityType_Real>("QuantityHidden");
+	QuantityType_EnumPtr TE = std::make_shared<QuantityType_Enum_Unordered>("QuantityE_Unordered");
+	TE->addQuantity("U1");
+	TE->addQuantity("U2");
+	CS->addQuantity(TA);
+	CS->addQuantity(TB);
+	CS->addQuantityAsVisibility(TH, "QuantityHidden", false);
+	CS->addQuantity(TE);
+
+	// anti-correlated configurations, many of which are Pareto optimal
+	ConfigurationSetPtr C = std::make_shared<ConfigurationSet>(CS, "TestConfigurationSet");
+	std::uniform_int_distribution<> dis_int(0, 200);
+	std::uniform_int_distribution<> dis_enum(0, 1);
+	std::uniform_real_distribution<> dis_real(0.0, 20.0);
+	for (unsigned int i = 0; i < 1000; i++) {
+		int a = dis_int(this->generator);
+		ConfigurationPtr c = std::make_shared<Configuration>(CS);
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TA, a));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TB, 200.0 - a + dis_real(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TH, dis_real(this->generator)));
+		c->addQuantity(TE->quantities[dis_enum(this->generator)]);
+		C->addConfiguration(c);
+	}
+	ConfigurationSetPtr CM1 = PC.minimize_SFS(C);
+	ConfigurationSetPtr CM2 = PC.minimize(C);
+	ConfigurationSetPtr CM3 = PC.constraint(CM1, CM2);
+	ASSERT_EQUAL(CM1->confs().size(), CM2->confs().size(), "Sort-filter-skyline and block minimization give different results.")
+	ASSERT_EQUAL(CM1->confs().size(), CM3->confs().size(), "Sort-filter-skyline and block minimization give different results.")
+
+	// correlated configurations without unordered quantities stop early
+	ConfigurationSpacePtr CS2 = std::make_shared< ConfigurationSpace>("TestSFS2");
+	CS2->addQuantity(TA);
+	CS2->addQuantity(TB);
+	std::vector<ConfigurationPtr> confs;
+	std::vector<const Configuration*> cptrs;
+	for (unsigned int i = 0; i < 1000; i++) {
+		int a = dis_int(this->generator);
+		ConfigurationPtr c = std::make_shared<Configuration>(CS2);
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TA, a));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TB, a + dis_real(this->generator)));
+		confs.push_back(c);
+		cptrs.push_back(c.get());
+	}
+	SortFilterSkyline sfs(*CS2, cptrs);
+	std::vector<size_t> minimal = sfs.minimal();
+	ASSERT_THROW(sfs.visited < cptrs.size(), "Sort-filter-skyline minimization did not stop early.")
+	for (size_t k = 0; k < cptrs.size(); k++) {
+		bool isMinimal = std::find(minimal.begin(), minimal.end(), k) != minimal.end();
+		bool dominated = false;
+		for (size_t p : minimal) {
+			dominated = dominated || (p != k && CS2->dominanceKernel().dominates(*cptrs[p], *cptrs[k]));
+		}
+		ASSERT_THROW(isMinimal != dominated, "Sort-filter-skyline minimization is not correct.")
+	}
+
+	return true;
+}
+
+bool UnitTester::test_SweepKernels(void) {
+
+	// create a configuration space with three totally ordered and one hidden quantity
+	ConfigurationSpacePtr CS = std::make_shared< ConfigurationSpace>("TestSweep");
+	QuantityTypePtr TA = std::make_shared<QuantityType_Integer>("QuantityA");
+	QuantityTypePtr TB = std::make_shared<QuantityType_Real>("QuantityB");
+	QuantityTypePtr TH = std::make_shared<QuantityType_Real>("QuantityHidden");
+	QuantityTypePtr TC = std::make_shared<QuantityType_Integer>("QuantityC");
+	CS->addQuantity(TA);
+	CS->addQuantity(TB);
+	CS->addQuantityAsVisibility(TH, "QuantityHidden", false);
+	CS->addQuantity(TC);
+	ASSERT_THROW(SweepKernel::appliesTo(*CS), "The sweep kernels do not apply to three quantities.")
+
+	// few distinct values, so that there are many ties and duplicates
+	ConfigurationSetPtr C = std::make_shared<ConfigurationSet>(CS, "TestConfigurationSet");
+	std::uniform_int_distribution<> dis_int(0, 20);
+	std::uniform_real_distribution<> dis_real(0.0, 1.0);
+	for (unsigned int i = 0; i < 2000; i++) {
+		ConfigurationPtr c = std::make_shared<Configuration>(CS);
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TA, dis_int(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TB, dis_int(this->generator) / 4.0));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TH, dis_real(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TC, dis_int(this->generator)));
+		C->addConfiguration(c);
+	}
+
+	MinimizeStatistics stats;
+	MinimizeOptions options;
+	options.statistics = &stats;
+	ConfigurationSetPtr CM1 = PC.efficient_minimize(C, options);
+	ASSERT_THROW(stats.sweeps > 0, "The three-dimensional sweep was not used.")
+	ConfigurationSetPtr CM2 = PC.minimize(C);
+	ConfigurationSetPtr CM3 = PC.constraint(CM1, CM2);
+	ASSERT_EQUAL(CM1->confs().size(), CM2->confs().size(), "Three-dimensional sweep and block minimization give different results.")
+	ASSERT_EQUAL(CM1->confs().size(), CM3->confs().size(), "Three-dimensional sweep and block minimization give different results.")
+
+	// the same kind of configurations with only two visible quantities
+	ConfigurationSpacePtr CS2 = std::make_shared< ConfigurationSpace>("TestSweep2");
+	CS2->addQuantity(TA);
+	CS2->addQuantityAsVisibility(TH, "QuantityHidden", false);
+	CS2->addQuantity(TB);
+	ASSERT_THROW(SweepKernel::appliesTo(*CS2), "The sweep kernels do not apply to two quantities.")
+	ConfigurationSetPtr C2 = std::make_shared<ConfigurationSet>(CS2, "TestConfigurationSet2");
+	for (unsigned int i = 0; i < 2000; i++) {
+		ConfigurationPtr c = std::make_shared<Configuration>(CS2);
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TA, dis_int(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TH, dis_real(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TB, dis_int(this->generator) / 4.0));
+		C2->addConfiguration(c);
+	}
+	CM1 = PC.efficient_minimize(C2, options);
+	CM2 = PC.minimize(C2);
+	CM3 = PC.constraint(CM1, CM2);
+	ASSERT_EQUAL(CM1->confs().size(), CM2->confs().size(), "Two-dimensional sweep and block minimization give different results.")
+	ASSERT_EQUAL(CM1->confs().size(), CM3->confs().size(), "Two-dimensional sweep and block minimization give different results.")
+
+	// filtering keeps exactly the configurations that are not dominated by the other set
+	std::vector<const Configuration*> a, b;
+	unsigned int k = 0;
+	for (const ConfigurationPtr& c : C->confs()) {
+		if (k++ % 2 == 0) a.push_back(c.get()); else b.push_back(c.get());
+	}
+	std::vector<size_t> kept = SweepKernel::undominated(*CS, a, b);
+	for (size_t j = 0; j < b.size(); j++) {
+		bool dominated = false;
+		for (const Configuration* c : a) {
+			if (*c <= *b[j]) { dominated = true; break; }
+		}
+		bool isKept = std::find(kept.begin(), kept.end(), j) != kept.end();
+		ASSERT_THROW(isKept != dominated, "Sweep filter gives a wrong result.")
+	}
+
+	return true;
+}
+
+bool UnitTester::test_ConfigurationArena(void) {
+
+	size_t chunks = ConfigurationArena::chunksInUse();
+
+	// create two sets with two quantities each
+	ConfigurationSpacePtr CS1 = std::make_shared< ConfigurationSpace>("TestArena1");
+	ConfigurationSpacePtr CS2 = std::make_shared< ConfigurationSpace>("TestArena2");
+	QuantityTypePtr TA = std::make_shared<QuantityType_Integer>("QuantityA");
+	QuantityTypePtr TB = std::make_shared<QuantityType_Real>("QuantityB");
+	QuantityTypePtr TC = std::make_shared<QuantityType_Integer>("QuantityC");
+	QuantityTypePtr TD = std::make_shared<QuantityType_Real>("QuantityD");
+	CS1->addQuantity(TA);
+	CS1->addQuantity(TB);
+	CS2->addQuantity(TC);
+	CS2->addQuantity(TD);
+
+	ConfigurationSetPtr C1 = std::make_shared<ConfigurationSet>(CS1, "TestConfigurationSet1");
+	ConfigurationSetPtr C2 = std::make_shared<ConfigurationSet>(CS2, "TestConfigurationSet2");
+	std::uniform_int_distribution<> dis_int(1, 1000);
+	std::uniform_real_distribution<> dis_real(1.0, 2.0);
+	for (unsigned int i = 0; i < 100; i++) {
+		ConfigurationPtr c = C1->createConfiguration();
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TA, dis_int(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TB, dis_real(this->generator)));
+		C1->addConfiguration(c);
+		c = C2->createConfiguration();
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TC, dis_int(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TD, dis_real(this->generator)));
+		C2->addConfiguration(c);
+	}
+
+	// the configurations of the product are allocated in its arena
+	ConfigurationSetPtr P = PC.product(C1, C2);
+	ASSERT_THROW(ConfigurationArena::chunksInUse() > chunks, "The product was not allocated in an arena.")
+	for (const ConfigurationPtr& c : P->confs()) {
+		ASSERT_THROW(c->quantities.get_allocator().arena == P->arena, "A configuration was not allocated in the arena of its set.")
+	}
+
+	// minimal configurations survive the product they were allocated for
+	ConfigurationSetPtr M = PC.minimize(P);
+	size_t withProduct = ConfigurationArena::chunksInUse();
+	std::ostringstream before;
+	before << M;
+	P = nullptr;
+	ASSERT_THROW(ConfigurationArena::chunksInUse() < withProduct, "No chunks were released with the product.")
+	std::ostringstream after;
+	after << M;
+	ASSERT_THROW(before.str() == after.str(), "Releasing the product changed the minimal configurations.")
+
+	// all chunks are released with the sets
+	M = nullptr;
+	C1 = nullptr;
+	C2 = nullptr;
+	ASSERT_EQUAL(ConfigurationArena::chunksInUse(), chunks, "Not all chunks were released.")
+
+	return true;
+}
+
+bool UnitTester::test_InternedEnumValues(void) {
+
+	// names not in alphabetical order
+	QuantityType_EnumPtr TE = std::make_shared<QuantityType_Enum_Unordered>("QuantityE_Unordered");
+	TE->addQuantity("U3");
+	TE->addQuantity("U1");
+	TE->addQuantity("U2");
+
+	// every value has a single instance
+	ASSERT_THROW(TE->valueFromString("U1") == TE->valueWithIndex(1), "Parsed value is not the instance of its type.")
+	ASSERT_THROW(TE->valueFromString("U1") == TE->valueFromString("U1"), "Parsed values are not shared.")
+	ASSERT_THROW(TE->valueWithIndex(2)->value() == "U2", "Wrong name of an enumerated value.")
+
+	// the total order is the alphabetical order of the names
+	ASSERT_THROW(TE->valueWithIndex(1)->totalOrderSmaller(*TE->valueWithIndex(2)), "Wrong total order on enumerated values.")
+	ASSERT_THROW(TE->valueWithIndex(2)->totalOrderSmaller(*TE->valueWithIndex(0)), "Wrong total order on enumerated values.")
+	ASSERT_THROW(!TE->valueWithIndex(0)->totalOrderSmaller(*TE->valueWithIndex(1)), "Wrong total order on enumerated values.")
+	ASSERT_THROW(!TE->valueWithIndex(0)->totalOrderSmaller(*TE->valueWithIndex(0)), "Wrong total order on enumerated values.")
+
+	// a copy of the type has its own values
+	QuantityType_EnumPtr TC = std::dynamic_pointer_cast<QuantityType_Enum>(TE->copy());
+	ASSERT_THROW(&TC->valueWithIndex(0)->qtype == TC.get(), "Values of a copied type refer to the original type.")
+	TE = nullptr;
+	ASSERT_THROW(TC->valueFromString("U3")->asString() == "U3", "Wrong name of a value of a copied type.")
+	ASSERT_THROW(TC->valueWithIndex(1)->totalOrderSmaller(*TC->valueWithIndex(0)), "Wrong total order on values of a copied type.")
+	TC->addQuantity("U0");
+	ASSERT_THROW(TC->valueWithIndex(3)->totalOrderSmaller(*TC->valueWithIndex(1)), "Wrong total order on a value added to a copied type.")
+
+	// the values added one at a time are ranked like a sort of all names
+	QuantityType_EnumPtr TL = std::make_shared<QuantityType_Enum>("QuantityL");
+	std::uniform_int_distribution<> dis_int(0, 499);
+	std::vector<std::string> names;
+	for (unsigned int i = 0; i < 1000; i++) {
+		names.push_back("V" + std::to_string(dis_int(this->generator)));
+		TL->addQuantity(names.back());
+	}
+	std::vector<unsigned int> sorted(names.size());
+	for (unsigned int i = 0; i < sorted.size(); i++) sorted[i] = i;
+	std::stable_sort(sorted.begin(), sorted.end(), [&names](unsigned int a, unsigned int b) { return names[a] < names[b]; });
+	for (unsigned int r = 1; r < sorted.size(); r++) {
+		ASSERT_THROW(TL->valueWithIndex(sorted[r - 1])->totalOrderSmaller(*TL->valueWithIndex(sorted[r])), "Wrong total order on many enumerated values.")
+	}
+
+	return true;
+}
+
+bool UnitTester::test_HashJoin(void) {
+
+	// two enumerated types with partly the same names in a different order
+	QuantityType_EnumPtr TE = std::make_shared<QuantityType_Enum_Unordered>("Mode");
+	TE->addQuantity("M1");
+	TE->addQuantity("M2");
+	TE->addQuantity("M3");
+	QuantityType_EnumPtr TF = std::make_shared<QuantityType_Enum_Unordered>("OtherMode");
+	TF->addQuantity("M3");
+	TF->addQuantity("M4");
+	TF->addQuantity("M1");
+	QuantityTypePtr TI = std::make_shared<QuantityType_Integer>("Integer");
+	QuantityTypePtr TR = std::make_shared<QuantityType_Real>("Real");
+
+	ConfigurationSpacePtr CSA = std::make_shared< ConfigurationSpace>("TestJoinA");
+	CSA->addQuantityAs(TI, "KA");
+	CSA->addQuantityAs(TE, "EA");
+	CSA->addQuantityAs(TR, "XA");
+	ConfigurationSpacePtr CSB = std::make_shared< ConfigurationSpace>("TestJoinB");
+	CSB->addQuantityAs(TR, "YB");
+	CSB->addQuantityAs(TF, "EB");
+	CSB->addQuantityAs(TI, "KB");
+
+	ConfigurationSetPtr A = std::make_shared<ConfigurationSet>(CSA, "TestJoinSetA");
+	ConfigurationSetPtr B = std::make_shared<ConfigurationSet>(CSB, "TestJoinSetB");
+	std::uniform_int_distribution<> dis_key(0, 20);
+	std::uniform_int_distribution<> dis_enum(0, 2);
+	std::uniform_real_distribution<> dis_real(0.0, 1.0);
+	for (unsigned int i = 0; i < 300; i++) {
+		ConfigurationPtr c = A->createConfiguration();
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TI, dis_key(this->generator)));
+		c->addQuantity(TE->valueWithIndex(dis_enum(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, dis_real(this->generator)));
+		A->addConfiguration(c);
+		c = B->createConfiguration();
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, dis_real(this->generator)));
+		c->addQuantity(TF->valueWithIndex(dis_enum(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TI, dis_key(this->generator)));
+		B->addConfiguration(c);
+	}
+
+	// the expected join, enumerated values are matched on their names
+	ConfigurationSpacePtr P = CSA->productWith(CSB);
+	std::vector<std::string> expected;
+	for (const ConfigurationPtr& ca : A->confs()) {
+		for (const ConfigurationPtr& cb : B->confs()) {
+			if (ca->getQuantity(0)->asString() == cb->getQuantity(2)->asString() && ca->getQuantity(1)->asString() == cb->getQuantity(1)->asString()) {
+				ConfigurationPtr c = std::make_shared<Configuration>(P);
+				c->addQuantitiesOf(ca);
+				c->addQuantitiesOf(cb);
+				expected.push_back(*c->asString());
+			}
+		}
+	}
+	std::sort(expected.begin(), expected.end());
+	ASSERT_THROW(expected.size() > 0, "The join test has no matching configurations.")
+
+	StringMap jmap;
+	jmap["KA"] = "KB";
+	jmap["EA"] = "EB";
+	TaskPool pool(4);
+	std::vector<JoinOptions> options(3);
+	options[1].parallel = true;
+	options[1].pool = &pool;
+	options[2] = options[1];
+	options[2].grain = 1;
+	for (const JoinOptions& o : options) {
+		HashJoin join(A, B, jmap, P);
+		ConfigurationSetPtr J = join.join(o);
+		ASSERT_EQUAL(J->confs().size(), expected.size(), "Hash join gives a wrong number of configurations.")
+		std::vector<std::string> joined;
+		for (const ConfigurationPtr& c : J->confs()) joined.push_back(*c->asString());
+		std::sort(joined.begin(), joined.end());
+		ASSERT_THROW(joined == expected, "Hash join gives wrong configurations.")
+	}
+
+	// the join operation on the calculator stack
+	JoinMap ojmap;
+	ojmap["KA"] = "KB";
+	ojmap["EA"] = "EB";
+	PC.push(B);
+	PC.push(A);
+	POperation_EfficientJoin op(ojmap);
+	ASSERT_THROW(!op.options.parallel, "Efficient join operation is parallel by default.")
+	op.executeOn(PC);
+	ASSERT_EQUAL(PC.popConfigurationSet()->confs().size(), expected.size(), "Efficient join operation gives a wrong result.")
+	PC.push(B);
+	PC.push(A);
+	POperation_EfficientJoin pop(ojmap, options[2]);
+	pop.executeOn(PC);
+	ASSERT_EQUAL(PC.popConfigurationSet()->confs().size(), expected.size(), "Parallel efficient join operation gives a wrong result.")
+
+	return true;
+}
+
+bool UnitTester::test_ProductPipeline(void) {
+
+	QuantityTypePtr TR = std::make_shared<QuantityType_Real>("Real");
+	ConfigurationSpacePtr CSA = std::make_shared< ConfigurationSpace>("TestStreamA");
+	CSA->addQuantityAs(TR, "P");
+	CSA->addQuantityAs(TR, "X");
+	ConfigurationSpacePtr CSB = std::make_shared< ConfigurationSpace>("TestStreamB");
+	CSB->addQuantityAs(TR, "C");
+	CSB->addQuantityAs(TR, "Y");
+
+	ConfigurationSetPtr A = std::make_shared<ConfigurationSet>(CSA, "TestStreamSetA");
+	ConfigurationSetPtr B = std::make_shared<ConfigurationSet>(CSB, "TestStreamSetB");
+	std::uniform_real_distribution<> dis_real(0.5, 2.0);
+	for (unsigned int i = 0; i < 150; i++) {
+		ConfigurationPtr c = A->createConfiguration();
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, dis_real(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, dis_real(this->generator)));
+		A->addConfiguration(c);
+		c = B->createConfiguration();
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, dis_real(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, dis_real(this->generator)));
+		B->addConfiguration(c);
+	}
+
+	// product, producer-consumer constraint, hiding and minimization as separate operations
+	ListOfQuantityNames hidden;
+	hidden.push_back("X");
+	ListOfOperations ops;
+	ops.push_back(std::make_shared<POperation_Product>());
+	ops.push_back(std::make_shared<POperation_ProdCons>("P", "C"));
+	ops.push_back(std::make_shared<POperation_Hide>(hidden));
+	ops.push_back(std::make_shared<POperation_EfficientMinimize>());
+	ops.push_back(std::make_shared<POperation_Duplicate>());
+
+	// all but the last operation are fused
+	ListOfOperations fused = POperation_ProductPipeline::fuse(ops);
+	ASSERT_EQUAL(fused.size(), 2, "Wrong number of operations after fusion.")
+
+	std::vector<std::string> expected, streamed;
+	PC.push(B);
+	PC.push(A);
+	for (const ParetoCalculatorOperationPtr& op : ops) op->executeOn(PC);
+	PC.pop();
+	ConfigurationSetPtr R = PC.popConfigurationSet();
+	for (const ConfigurationPtr& c : R->confs()) expected.push_back(*c->asString());
+	ASSERT_THROW(expected.size() > 1, "The streaming test has a trivial result.")
+
+	PC.push(B);
+	PC.push(A);
+	for (const ParetoCalculatorOperationPtr& op : fused) op->executeOn(PC);
+	PC.pop();
+	R = PC.popConfigurationSet();
+	for (const ConfigurationPtr& c : R->confs()) streamed.push_back(*c->asString());
+	ASSERT_THROW(streamed == expected, "Fused pipeline gives a different result.")
+
+	// minimize small blocks of the stream
+	ProductPipeline pipeline(A, B);
+	pipeline.addStage(std::make_shared<StreamStage_ProdCons>("P", "C"));
+	pipeline.addStage(std::make_shared<StreamStage_Hide>(hidden));
+	pipeline.setMinimization([](ConfigurationSetPtr cs) { return ParetoCalculator::efficient_minimize(cs, MinimizeOptions()); });
+	pipeline.blockSize = 16;
+	streamed.clear();
+	R = pipeline.run();
+	for (const ConfigurationPtr& c : R->confs()) streamed.push_back(*c->asString());
+	ASSERT_THROW(streamed == expected, "Minimizing blocks of the stream gives a different result.")
+
+	// the lazy product enumerates all pairs
+	LazyProduct product(A, B, CSA->productWith(CSB));
+	size_t n = 0;
+	while (product.next()) n++;
+	ASSERT_EQUAL(n, product.size(), "Lazy product enumerates a wrong number of configurations.")
+	ASSERT_THROW(!product.next(), "Lazy product continues after it is exhausted.")
+
+	return true;
+}
+
+bool UnitTester::test_ProductFront(void) {
+
+	QuantityTypePtr TR = std::make_shared<QuantityType_Real>("Real");
+	QuantityType_EnumPtr TE = std::make_shared<QuantityType_Enum_Unordered>("Mode");
+	TE->addQuantity("M1");
+	TE->addQuantity("M2");
+	TE->addQuantity("M3");
+	ConfigurationSpacePtr CSA = std::make_shared< ConfigurationSpace>("TestFrontA");
+	CSA->addQuantityAs(TR, "P");
+	CSA->addQuantityAs(TR, "X");
+	ConfigurationSpacePtr CSB = std::make_shared< ConfigurationSpace>("TestFrontB");
+	CSB->addQuantityAs(TE, "M");
+	CSB->addQuantityAs(TR, "Q");
+	CSB->addQuantityAs(TR, "Y");
+
+	// the set A is not minimal, in B the cost Y grows with Q
+	ConfigurationSetPtr A = std::make_shared<ConfigurationSet>(CSA, "TestFrontSetA");
+	ConfigurationSetPtr B = std::make_shared<ConfigurationSet>(CSB, "TestFrontSetB");
+	std::uniform_real_distribution<> dis_real(0.0, 1.0);
+	std::uniform_int_distribution<> dis_enum(0, 2);
+	for (unsigned int i = 0; i < 200; i++) {
+		ConfigurationPtr c = A->createConfiguration();
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, dis_real(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, dis_real(this->generator)));
+		A->addConfiguration(c);
+		double q = dis_real(this->generator);
+		c = B->createConfiguration();
+		c->addQuantity(TE->valueWithIndex(dis_enum(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, q));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, 2.0 * q));
+		B->addConfiguration(c);
+	}
+
+	// product, aggregation, abstraction and minimization as separate operations
+	ListOfQuantityNames costs;
+	costs.push_back("X");
+	costs.push_back("Y");
+	ListOfOperations ops;
+	ops.push_back(std::make_shared<POperation_Product>());
+	ops.push_back(std::make_shared<POperation_Aggregate>(costs, "Cost"));
+	ops.push_back(std::make_shared<POperation_Abstract>(costs));
+	ops.push_back(std::make_shared<POperation_EfficientMinimize>());
+
+	ListOfOperations fused = POperation_ProductPipeline::fuse(ops);
+	ASSERT_EQUAL(fused.size(), 1, "Wrong number of operations after fusion.")
+	ASSERT_THROW(std::dynamic_pointer_cast<POperation_ProductAggregateMinimize>(fused[0]) != nullptr, "Product, aggregation and minimization are not fused.")
+
+	std::vector<std::string> expected, computed;
+	PC.push(B);
+	PC.push(A);
+	for (const ParetoCalculatorOperationPtr& op : ops) op->executeOn(PC);
+	ConfigurationSetPtr R = PC.popConfigurationSet();
+	for (const ConfigurationPtr& c : R->confs()) expected.push_back(*c->asString());
+	std::sort(expected.begin(), expected.end());
+	ASSERT_THROW(expected.size() > 1, "The product front test has a trivial result.")
+
+	PC.push(B);
+	PC.push(A);
+	fused[0]->executeOn(PC);
+	R = PC.popConfigurationSet();
+	for (const ConfigurationPtr& c : R->confs()) computed.push_back(*c->asString());
+	std::sort(computed.begin(), computed.end());
+	ASSERT_THROW(computed == expected, "Fused product, aggregation and minimization gives a different result.")
+
+	// dominated configurations of A are skipped on their bounds
+	ProductFront front(A, B);
+	front.addStage(std::make_shared<StreamStage_Aggregate>(costs, "Cost"));
+	front.addStage(std::make_shared<StreamStage_Abstract>(costs));
+	ASSERT_EQUAL(front.run()->confs().size(), expected.size(), "Product front gives a wrong number of configurations.")
+	ASSERT_THROW(front.pruned > 0, "Product front prunes no configurations.")
+
+	return true;
+}
+
+bool UnitTester::test_OperationPlan(void) {
+
+	QuantityTypePtr TR = std::make_shared<QuantityType_Real>("Real");
+	QuantityTypePtr TI = std::make_shared<QuantityType_Integer>("Integer");
+	ConfigurationSpacePtr CSA = std::make_shared< ConfigurationSpace>("TestPlanA");
+	CSA->addQuantityAs(TR, "P");
+	CSA->addQuantityAs(TR, "X");
+	CSA->addQuantityAs(TI, "K");
+	ConfigurationSpacePtr CSB = std::make_shared< ConfigurationSpace>("TestPlanB");
+	CSB->addQuantityAs(TR, "Q");
+	CSB->addQuantityAs(TR, "Y");
+	CSB->addQuantityAs(TI, "L");
+
+	ConfigurationSetPtr A = std::make_shared<ConfigurationSet>(CSA, "PlanA");
+	ConfigurationSetPtr B = std::make_shared<ConfigurationSet>(CSB, "PlanB");
+	std::uniform_real_distribution<> dis_real(0.0, 1.0);
+	std::uniform_int_distribution<> dis_key(0, 5);
+	for (unsigned int i = 0; i < 60; i++) {
+		ConfigurationPtr c = A->createConfiguration();
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, dis_real(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, dis_real(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TI, dis_key(this->generator)));
+		A->addConfiguration(c);
+		c = B->createConfiguration();
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, dis_real(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, dis_real(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TI, dis_key(this->generator)));
+		B->addConfiguration(c);
+	}
+	PC.store(A, "PlanA");
+	PC.store(B, "PlanB");
+
+	// the configurations on top of the stack after executing 'ops', one by one or as an optimized plan
+	auto run = [this](const ListOfOperations& ops, bool optimized) {
+		if (optimized) {
+			OperationPlan plan(ops, PC);
+			plan.optimize();
+			plan.executeOn(PC);
+		}
+		else {
+			for (const ParetoCalculatorOperationPtr& op : ops) op->executeOn(PC);
+		}
+		ConfigurationSetPtr R = PC.popConfigurationSet();
+		R->materialize();
+		std::vector<std::string> confs;
+		for (const ConfigurationPtr& c : R->confs()) confs.push_back(*c->asString());
+		std::sort(confs.begin(), confs.end());
+		return confs;
+	};
+	auto listing = [](const OperationPlan& plan) {
+		std::ostringstream os;
+		plan.streamOn(os);
+		return os.str();
+	};
+
+	// abstraction below the product and a redundant minimization
+	ListOfQuantityNames lqn;
+	lqn.push_back("X");
+	lqn.push_back("Y");
+	ListOfOperations ops;
+	ops.push_back(std::make_shared<POperation_Push>("PlanB"));
+	ops.push_back(std::make_shared<POperation_Push>("PlanA"));
+	ops.push_back(std::make_shared<POperation_Product>());
+	ops.push_back(std::make_shared<POperation_Abstract>(lqn));
+	ops.push_back(std::make_shared<POperation_EfficientMinimize>());
+	ops.push_back(std::make_shared<POperation_Duplicate>());
+	ops.push_back(std::make_shared<POperation_Pop>());
+	ops.push_back(std::make_shared<POperation_EfficientMinimize>());
+	OperationPlan plan(ops, PC);
+	ASSERT_EQUAL(plan.size(), 6, "Wrong number of nodes in the compiled plan.")
+	plan.optimize();
+	std::string l = listing(plan);
+	ASSERT_THROW(l.find("abstract X (%") != std::string::npos && l.find("abstract Y (%") != std::string::npos, "Abstraction is not moved below the product.")
+	ASSERT_THROW(l.find("minimize_eff") == l.rfind("minimize_eff"), "Redundant minimization is not removed.")
+	ASSERT_THROW(run(ops, true) == run(ops, false), "Optimized plan gives a different result.")
+
+	// common subexpressions and dead results
+	ops.clear();
+	ops.push_back(std::make_shared<POperation_Push>("PlanB"));
+	ops.push_back(std::make_shared<POperation_Pop>());
+	ops.push_back(std::make_shared<POperation_Push>("PlanA"));
+	ops.push_back(std::make_shared<POperation_SortFilterMinimize>());
+	ops.push_back(std::make_shared<POperation_Store>("PlanMinA"));
+	ops.push_back(std::make_shared<POperation_Push>("PlanA"));
+	ops.push_back(std::make_shared<POperation_SortFilterMinimize>());
+	ops.push_back(std::make_shared<POperation_Push>("PlanMinA"));
+	ops.push_back(std::make_shared<POperation_Product>());
+	OperationPlan cse(ops, PC);
+	ASSERT_EQUAL(cse.size(), 3, "Common subexpressions or dead results are not eliminated.")
+	ASSERT_THROW(run(ops, true) == run(ops, false), "Plan with common subexpressions gives a different result.")
+
+	// a join on integer quantities becomes a hash join
+	JoinMap jm;
+	jm["K"] = "L";
+	ops.clear();
+	ops.push_back(std::make_shared<POperation_Push>("PlanB"));
+	ops.push_back(std::make_shared<POperation_Push>("PlanA"));
+	ops.push_back(std::make_shared<POperation_Join>(jm));
+	OperationPlan join(ops, PC);
+	join.optimize();
+	ASSERT_THROW(listing(join).find("join_eff K=L") != std::string::npos, "Join is not replaced by an efficient join.")
+	ASSERT_THROW(run(ops, true) == run(ops, false), "Optimized join gives a different result.")
+
+	return true;
+}
+
+bool UnitTester::test_ConcurrentPlan(void) {
+
+	QuantityTypePtr TR = std::make_shared<QuantityType_Real>("Real");
+	ConfigurationSpacePtr CSA = std::make_shared< ConfigurationSpace>("TestConcurrentA");
+	CSA->addQuantityAs(TR, "P");
+	CSA->addQuantityAs(TR, "X");
+	ConfigurationSpacePtr CSB = std::make_shared< ConfigurationSpace>("TestConcurrentB");
+	CSB->addQuantityAs(TR, "Q");
+	CSB->addQuantityAs(TR, "Y");
+
+	ConfigurationSetPtr A = std::make_shared<ConfigurationSet>(CSA, "ConcurrentA");
+	ConfigurationSetPtr B = std::make_shared<ConfigurationSet>(CSB, "ConcurrentB");
+	std::uniform_real_distribution<> dis_real(0.0, 1.0);
+	for (unsigned int i = 0; i < 80; i++) {
+		ConfigurationPtr c = A->createConfiguration();
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, dis_real(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, dis_real(this->generator)));
+		A->addConfiguration(c);
+		c = B->createConfiguration();
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, dis_real(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, dis_real(this->generator)));
+		B->addConfiguration(c);
+	}
+
+	// two independent branches that share the minimized sets, the results are stored in
+	// memory and combined on the stack
+	ListOfQuantityNames lqn;
+	lqn.push_back("X");
+	ListOfOperations ops;
+	ops.push_back(std::make_shared<POperation_Push>("ConcurrentA"));
+	ops.push_back(std::make_shared<POperation_EfficientMinimize>());
+	ops.push_back(std::make_shared<POperation_Store>("ConcurrentMinA"));
+	ops.push_back(std::make_shared<POperation_Push>("ConcurrentB"));
+	ops.push_back(std::make_shared<POperation_EfficientMinimize>());
+	ops.push_back(std::make_shared<POperation_Duplicate>());
+	ops.push_back(std::make_shared<POperation_Push>("ConcurrentMinA"));
+	ops.push_back(std::make_shared<POperation_Product>());
+	ops.push_back(std::make_shared<POperation_EfficientMinimize>());
+	ops.push_back(std::make_shared<POperation_Store>("ConcurrentAB"));
+	ops.push_back(std::make_shared<POperation_Push>("ConcurrentA"));
+	ops.push_back(std::make_shared<POperation_Product>());
+	ops.push_back(std::make_shared<POperation_Abstract>(lqn));
+	ops.push_back(std::make_shared<POperation_EfficientMinimize>());
+
+	// the sorted configurations of a set
+	auto configurations = [](ConfigurationSetPtr R) {
+		R->materialize();
+		std::vector<std::string> confs;
+		for (const ConfigurationPtr& c : R->confs()) confs.push_back(*c->asString());
+		std::sort(confs.begin(), confs.end());
+		return confs;
+	};
+
+	// the stored and the remaining results in both storage modes
+	for (StorageMode mode : { StorageMode::Nodes, StorageMode::Columnar }) {
+		PC.setStorageMode(mode);
+		PC.store(A, "ConcurrentA");
+		PC.store(B, "ConcurrentB");
+		std::vector<std::vector<std::string>> results[2];
+		for (int concurrent = 0; concurrent < 2; concurrent++) {
+			OperationPlan plan(ops, PC);
+			plan.optimize();
+			plan.executeOn(PC, concurrent ? &TaskPool::shared() : nullptr);
+			ConfigurationSetPtr R = PC.popConfigurationSet();
+			results[concurrent].push_back(configurations(R));
+			ASSERT_THROW(PC.stack.empty(), "Stack is not empty after executing the plan.")
+			results[concurrent].push_back(configurations(PC.retrieveConfigurationSet("ConcurrentMinA")));
+			results[concurrent].push_back(configurations(PC.retrieveConfigurationSet("ConcurrentAB")));
+		}
+		ASSERT_THROW(results[0] == results[1], "Concurrent plan gives a different result.")
+	}
+	PC.setStorageMode(StorageMode::Nodes);
+
+	// a chain of nodes in which every node uses the previous one. The nodes do not wait for
+	// their inputs, a pool thread that joins a task may run any of them.
+	ConfigurationSetPtr L = std::make_shared<ConfigurationSet>(CSA, "ConcurrentLarge");
+	for (unsigned int i = 0; i < 5000; i++) {
+		ConfigurationPtr c = L->createConfiguration();
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, dis_real(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TR, dis_real(this->generator)));
+		L->addConfiguration(c);
+	}
+	PC.store(L, "ConcurrentLarge");
+	ListOfOperations chain;
+	chain.push_back(std::make_shared<POperation_Push>("ConcurrentLarge"));
+	for (int i = 0; i < 5; i++) {
+		chain.push_back(std::make_shared<POperation_Minimize>());
+		chain.push_back(std::make_shared<POperation_Hide>(lqn));
+	}
+	chain.push_back(std::make_shared<POperation_Minimize>());
+	chain.push_back(std::make_shared<POperation_Store>("ConcurrentChain"));
+	OperationPlan(chain, PC).executeOn(PC);
+	std::vector<std::string> expected = configurations(PC.retrieveConfigurationSet("ConcurrentChain"));
+	TaskPool pool(4);
+	for (int run = 0; run < 3; run++) {
+		OperationPlan plan(chain, PC);
+		plan.executeOn(PC, &pool);
+		ASSERT_THROW(configurations(PC.retrieveConfigurationSet("ConcurrentChain")) == expected, "Concurrent chain gives a different result.")
+	}
+
+	// collects the progress messages of the calculator
+	class Messages : public StatusCallback {
+	public:
+		std::string text;
+		virtual void setStatus(const std::string&) {}
+		virtual void verbose(const std::string& s) { text += s; }
+	};
+
+	// without optimization, the concurrent plan reports the messages of all operations in order
+	for (ParetoCalculatorOperationPtr& op : ops) {
+		op->message = op->describe() + "\n";
+	}
+	ops.push_back(std::make_shared<POperation_Duplicate>());
+	ops.back()->message = "dup\n";
+	ops.push_back(std::make_shared<POperation_Pop>());
+	ops.back()->message = "pop\n";
+	PC.store(A, "ConcurrentA");
+	PC.store(B, "ConcurrentB");
+	std::string sequential;
+	for (int concurrent = 0; concurrent < 2; concurrent++) {
+		Messages messages;
+		PC.setStatusCallbackObject(&messages);
+		if (concurrent) {
+			OperationPlan plan(ops, PC);
+			plan.executeOn(PC, &TaskPool::shared());
+		}
+		else {
+			for (const ParetoCalculatorOperationPtr& op : ops) {
+				op->announce(PC);
+				PC.execute(*op);
+			}
+		}
+		PC.setStatusCallbackObject(nullptr);
+		PC.popConfigurationSet();
+		ASSERT_THROW(PC.stack.empty(), "Stack is not empty after executing the plan.")
+		if (concurrent) {
+			ASSERT_THROW(messages.text == sequential, "Concurrent plan reports different messages.")
+		}
+		sequential = messages.text;
+	}
+
+	return true;
+}
+
+bool UnitTester::test_ParetoArchive(void) {
+
+	// create a configuration space with ordered, unordered and hidden quantities
+	ConfigurationSpacePtr CS = std::make_shared< ConfigurationSpace>("TestArchive");
+	QuantityTypePtr TA = std::make_shared<QuantityType_Integer>("QuantityA");
+	QuantityTypePtr TB = std::make_shared<QuantityType_Real>("QuantityB");
+	QuantityTypePtr TC = std::make_shared<QuantityType_Real>("QuantityC");
+	QuantityTypePtr TH = std::make_shared<QuantityType_Real>("QuantityHidden");
+	QuantityType_EnumPtr TE = std::make_shared<QuantityType_Enum_Unordered>("QuantityE_Unordered");
+	TE->addQuantity("U1");
+	TE->addQuantity("U2");
+	CS->addQuantity(TA);
+	CS->addQuantity(TB);
+	CS->addQuantity(TC);
+	CS->addQuantityAsVisibility(TH, "QuantityHidden", false);
+	CS->addQuantity(TE);
+
+	// anti-correlated configurations, many of which are Pareto optimal
+	ConfigurationSetPtr C = std::make_shared<ConfigurationSet>(CS, "TestConfigurationSet");
+	std::uniform_int_distribution<> dis_int(0, 100);
+	std::uniform_int_distribution<> dis_enum(0, 1);
+	std::uniform_real_distribution<> dis_real(0.0, 20.0);
+	auto random = [&]() {
+		int a = dis_int(this->generator);
+		double b = dis_real(this->generator);
+		ConfigurationPtr c = std::make_shared<Configuration>(CS);
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TA, a));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TB, b));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TC, 140.0 - a - b + dis_real(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TH, dis_real(this->generator)));
+		c->addQuantity(TE->quantities[dis_enum(this->generator)]);
+		return c;
+	};
+	for (unsigned int i = 0; i < 2000; i++) {
+		C->addConfiguration(random());
+	}
+
+	// simple cull with the archive and block minimization give the same front
+	ConfigurationSetPtr CM1 = PC.minimize_SC(C);
+	ConfigurationSetPtr CM2 = PC.minimize(C);
+	ConfigurationSetPtr CM3 = PC.constraint(CM1, CM2);
+	ASSERT_EQUAL(CM1->confs().size(), CM2->confs().size(), "Simple cull and block minimization give different results.")
+	ASSERT_EQUAL(CM1->confs().size(), CM3->confs().size(), "Simple cull and block minimization give different results.")
+
+	// the dominance queries of the archive agree with a scan of its set, also after deletions
+	const DominanceKernel& dk = CS->dominanceKernel();
+	auto scan = [&](const ConfigurationSetPtr& F, const Configuration& c) {
+		for (const ConfigurationPtr& f : F->confs()) {
+			if (dk.dominates(*f, c)) return true;
+		}
+		return false;
+	};
+	ConfigurationSetPtr F = std::make_shared<ConfigurationSet>(CS, "TestFront");
+	ParetoArchive archive(F, 4);
+	// in lexicographic order no configuration is dominated by a later one
+	for (const ConfigurationPtr& c : C->confs()) {
+		ASSERT_THROW(archive.insert(c) == CM1->containsConfiguration(c), "Pareto archive inserts a dominated configuration.")
+	}
+	ASSERT_EQUAL(archive.size(), CM1->confs().size(), "Pareto archive does not hold the minimal configurations.")
+	std::vector<ConfigurationPtr> front(F->confs().begin(), F->confs().end());
+	for (size_t k = 0; k < front.size(); k += 2) {
+		ASSERT_THROW(archive.erase(front[k]), "Pareto archive does not erase a configuration.")
+		ASSERT_THROW(!archive.erase(front[k]), "Pareto archive erases a configuration twice.")
+	}
+	ASSERT_EQUAL(archive.size(), F->confs().size(), "Pareto archive and its set differ in size.")
+	for (unsigned int i = 0; i < 500; i++) {
+		ConfigurationPtr c = random();
+		ASSERT_THROW(archive.isDominated(*c) == scan(F, *c), "Pareto archive gives a wrong dominance query.")
+		archive.insert(c);
+		ASSERT_EQUAL(archive.size(), F->confs().size(), "Pareto archive and its set differ in size.")
+	}
+	for (const ConfigurationPtr& f : F->confs()) {
+		ConfigurationSetPtr rest = std::make_shared<ConfigurationSet>(CS, "TestRest");
+		for (const ConfigurationPtr& g : F->confs()) {
+			if (g != f) rest->addUniqueConfiguration(g);
+		}
+		ASSERT_THROW(!scan(rest, *f), "Pareto archive is not minimal.")
+	}
+
+	return true;
+}
+
+bool UnitTester::test_OnlineMinimization(void) {
+
+	// create a configuration space with ordered and unordered quantities
+	ConfigurationSpacePtr CS = std::make_shared< ConfigurationSpace>("TestOnline");
+	QuantityTypePtr TA = std::make_shared<QuantityType_Integer>("QuantityA");
+	QuantityTypePtr TB = std::make_shared<QuantityType_Real>("QuantityB");
+	QuantityType_EnumPtr TE = std::make_shared<QuantityType_Enum_Unordered>("QuantityE_Unordered");
+	TE->addQuantity("U1");
+	TE->addQuantity("U2");
+	CS->addQuantity(TA);
+	CS->addQuantity(TB);
+	CS->addQuantity(TE);
+
+	// anti-correlated configurations
+	ConfigurationSetPtr C = std::make_shared<ConfigurationSet>(CS, "TestConfigurationSet");
+	std::uniform_int_distribution<> dis_int(-100, 100);
+	std::uniform_int_distribution<> dis_enum(0, 1);
+	std::uniform_real_distribution<> dis_real(0.0, 20.0);
+	for (unsigned int i = 0; i < 1000; i++) {
+		int a = dis_int(this->generator);
+		ConfigurationPtr c = std::make_shared<Configuration>(CS);
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TA, a));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TB, 1.0 / 3.0 - a + dis_real(this->generator)));
+		c->addQuantity(TE->quantities[dis_enum(this->generator)]);
+		C->addConfiguration(c);
+	}
+	ConfigurationSetPtr CM = PC.minimize(C);
+
+	// write the configurations in both formats, read them back and minimize them online
+	for (RecordFormat f : { RecordFormat::Text, RecordFormat::Binary }) {
+		std::stringstream records;
+		ConfigurationWriter writer(records, f);
+		for (const ConfigurationPtr& c : C->confs()) {
+			writer.write(*c);
+		}
+		ConfigurationReader reader(records, CS, f);
+		ConfigurationSetPtr CO = PC.minimize_Online(reader, "TestOnlineFront");
+		ASSERT_EQUAL(reader.count, C->confs().size(), "Not all records are read.")
+		ASSERT_EQUAL(CO->confs().size(), CM->confs().size(), "Online and block minimization give different results.")
+		ASSERT_EQUAL(PC.constraint(CO, CM)->confs().size(), CM->confs().size(), "Online and block minimization give different results.")
+	}
+
+	// comments, separators and malformed lines in text records
+	std::stringstream text("# A, B, E\n\n1, 2.5, U2\n  -3\t4e1 U1\r\n");
+	ConfigurationReader reader(text, CS, RecordFormat::Text);
+	ASSERT_THROW(reader.next() != nullptr && reader.next() != nullptr && reader.next() == nullptr, "Text records are not read correctly.")
+	for (const char* bad : { "1, 2.5", "1, 2.5, U3", "1, x, U1", "1.5, 2, U1", "1, 2, U1, 3", "3000000000, 2, U1" }) {
+		std::stringstream malformed(bad);
+		ConfigurationReader r(malformed, CS, RecordFormat::Text);
+		bool thrown = false;
+		try {
+			r.next();
+		}
+		catch (const EParetoCalculatorError&) {
+			thrown = true;
+		}
+		ASSERT_THROW(thrown, "Malformed text record is accepted.")
+	}
+
+	// an integer out of the range of the quantity type in a binary record
+	std::stringstream binary;
+	int64_t a = 3000000000LL;
+	double b = 2.5;
+	uint64_t e = 0;
+	binary.write(reinterpret_cast<const char*>(&a), sizeof(a));
+	binary.write(reinterpret_cast<const char*>(&b), sizeof(b));
+	binary.write(reinterpret_cast<const char*>(&e), sizeof(e));
+	ConfigurationReader rb(binary, CS, RecordFormat::Binary);
+	bool thrown = false;
+	try {
+		rb.next();
+	}
+	catch (const EParetoCalculatorError&) {
+		thrown = true;
+	}
+	ASSERT_THROW(thrown, "Out of range integer in a binary record is accepted.")
+
+	return true;
+}
+
+bool UnitTester::test_BinaryFormat(void) {
+
+	// create a configuration space with all kinds of quantities and a hidden quantity
+	ConfigurationSpacePtr CS = std::make_shared< ConfigurationSpace>("TestBinary");
+	QuantityTypePtr TA = std::make_shared<QuantityType_Integer>("QuantityA");
+	QuantityTypePtr TB = std::make_shared<QuantityType_Real>("QuantityB");
+	QuantityType_EnumPtr TE = std::make_shared<QuantityType_Enum>("QuantityE");
+	TE->addQuantity("E2");
+	TE->addQuantity("E1");
+	QuantityType_EnumPtr TU = std::make_shared<QuantityType_Enum_Unordered>("QuantityU");
+	TU->addQuantity("U1");
+	TU->addQuantity("U2");
+	CS->addQuantityAs(TA, "A");
+	CS->addQuantityAs(TB, "B");
+	CS->addQuantityAsVisibility(TB, "Hidden", false);
+	CS->addQuantity(TE);
+	CS->addQuantity(TU);
+
+	ConfigurationSetPtr C = std::make_shared<ConfigurationSet>(CS, "TestBinarySet");
+	std::uniform_int_distribution<> dis_int(-1000, 1000);
+	std::uniform_int_distribution<> dis_enum(0, 1);
+	std::uniform_real_distribution<> dis_real(0.0, 20.0);
+	for (unsigned int i = 0; i < 1000; i++) {
+		ConfigurationPtr c = std::make_shared<Configuration>(CS);
+		c->addQuantity(std::make_shared<QuantityValue_Integer>(*TA, dis_int(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TB, dis_real(this->generator)));
+		c->addQuantity(std::make_shared<QuantityValue_Real>(*TB, dis_real(this->generator)));
+		c->addQuantity(TE->quantities[dis_enum(this->generator)]);
+		c->addQuantity(TU->quantities[dis_enum(this->generator)]);
+		C->addConfiguration(c);
+	}
+
+	// the sorted configurations of a set
+	auto configurations = [](ConfigurationSetPtr R) {
+		R->materialize();
+		std::vector<std::string> confs;
+		for (const ConfigurationPtr& c : R->confs()) confs.push_back(*c->asString());
+		std::sort(confs.begin(), confs.end());
+		return confs;
+	};
+
+	// save the whole memory and a single item and load them into fresh calculators
+	const std::string all = "TestBinaryAll.pcb";
+	const std::string item = "TestBinaryItem.pcb";
+	ParetoCalculator source;
+	source.store(C, "Set");
+	source.store(std::make_shared<StorableString>("TestString"), "String");
+	source.store(CS);
+	source.SaveAllFile(all);
+	source.SaveItemFile("Set", item);
+
+	ParetoCalculator loadAll;
+	loadAll.LoadBinaryFile(all);
+	ASSERT_EQUAL(loadAll.memory.size(), 3, "Binary file does not hold all objects.")
+	ConfigurationSetPtr L = loadAll.retrieveConfigurationSet("Set");
+	ASSERT_THROW(L->isColumnar(), "Configuration set is not loaded in columnar storage mode.")
+	ASSERT_THROW(configurations(L) == configurations(C), "Configuration set changed in the binary file.")
+	ASSERT_THROW(loadAll.retrieveStorableString("String")->name == "TestString", "String changed in the binary file.")
+	ConfigurationSpacePtr LS = loadAll.retrieveConfigurationSpace("TestBinary");
+	ASSERT_EQUAL(LS->quantities.size(), CS->quantities.size(), "Configuration space changed in the binary file.")
+	ASSERT_THROW(!LS->quantityVisibility[2] && LS->quantityNames["Hidden"] == 2, "Hidden quantity changed in the binary file.")
+	ASSERT_THROW(L->confspace == LS, "Configuration set and space are not shared in the binary file.")
+
+	ParetoCalculator loadItem;
+	loadItem.LoadBinaryFile(item);
+	ASSERT_EQUAL(loadItem.memory.size(), 1, "Binary item file holds other objects.")
+	ASSERT_THROW(configurations(loadItem.retrieveConfigurationSet("Set")) == configurations(C), "Configuration set changed in the binary item file.")
+	ASSERT_EQUAL(loadItem.minimize(loadItem.retrieveConfigurationSet("Set"))->size(), PC.minimize(C)->size(), "Loaded configuration set minimizes differently.")
+
+	// truncated files are rejected
+	std::ifstream is(all, std::ios::binary);
+	std::string content((std::istreambuf_iterator<char>(is)), std::istreambuf_iterator<char>());
+	is.close();
+	std::ofstream os(item, std::ios::binary);
+	os.write(content.data(), content.size() / 2);
+	os.close();
+	bool thrown = false;
+	try {
+		BinaryFormat::load(item);
+	}
+	catch (const EParetoCalculatorError&) {
+		thrown = true;
+	}
+	ASSERT_THROW(thrown, "Truncated binary file is accepted.")
+
+	// a row count that does not fit in the file is rejected before the columns are allocated
+	const std::string setName = std::string("\x0d\0\0\0", 4) + "TestBinarySet";
+	size_t rowsAt = content.find(setName) + setName.size() + sizeof(uint32_t);
+	ASSERT_THROW(rowsAt + sizeof(uint64_t) <= content.size(), "Configuration set not found in the binary file.")
+	uint64_t rows = (uint64_t)1 << 40;
+	content.replace(rowsAt, sizeof(uint64_t), (const char*)&rows, sizeof(uint64_t));
+	os.open(item, std::ios::binary);
+	os.write(content.data(), content.size());
+	os.close();
+	thrown = false;
+	try {
+		BinaryFormat::load(item);
+	}
+	catch (const EParetoCalculatorError& e) {
+		thrown = e.errorMsg.find("is corrupt") != std::string::npos;
+	}
+	ASSERT_THROW(thrown, "Binary file with too many rows is accepted.")
+
+	std::remove(all.c_str());
+	std::remove(item.c_str());
+	return true;
+}
+
+bool UnitTester::test_DSLParser(void) {
+
+	// a specification with all kinds of quantity types, a renamed quantity and comments
+	const std::string spec =
+		"pareto specification TestDSL\n"
+		"description <a test of the .pareto parser>\n"
+		"quantity types\n"
+		"  Cost: real\n"
+		"  Count: int\n"
+		"  Level: ordered [low, high] // a comment\n"
+		"  Mode: unordered [m1, m2]\n"
+		"configuration spaces\n"
+		"  Space:\n"
+		"    Cost\n"
+		"    Count as Number\n"
+		"    Level Mode\n"
+		"  Other: Cost as OtherCost\n"
+		"configuration sets\n"
+		"  Set in Space = { (1.5e1, -3, low, m1), (+2, 4, high, m2), (20, 5, high, m2) }\n"
+		"  /* sets with a single\n configuration */\n"
+		"  OtherSet in Other = { (1) }\n"
+		"calculation\n"
+		"  push Set minimize store as Front\n";
+
+	ParetoCalculator calc;
+	ParetoDSLParser parser(calc);
+	parser.Load(spec, "test");
+	ASSERT_THROW(parser.name == "TestDSL", "Name of the specification not parsed.")
+	ASSERT_EQUAL(calc.memory.size(), 8, "Objects of the specification not stored.")
+	ConfigurationSpacePtr S = calc.retrieveConfigurationSpace("Space");
+	ASSERT_EQUAL(S->quantities.size(), 4, "Quantities of the configuration space not parsed.")
+	ASSERT_THROW(S->includesQuantityNamed("Number"), "Renamed quantity not parsed.")
+	ASSERT_THROW(S->quantities[3]->isQuantityTypeEnum(), "Enumerated quantity type not parsed.")
+	ConfigurationSetPtr C = calc.retrieveConfigurationSet("Set");
+	ASSERT_EQUAL(C->size(), 3, "Configurations of the set not parsed.")
+	ASSERT_EQUAL(calc.retrieveConfigurationSet("OtherSet")->size(), 1, "Set with a single configuration not parsed.")
+	ASSERT_EQUAL(parser.operations.size(), 3, "Operations not parsed.")
+
+	// the operations give the same result as the calculator
+	calc.executeOperations(parser.operations);
+	ASSERT_EQUAL(calc.retrieveConfigurationSet("Front")->size(), PC.minimize(C)->size(), "Operations not executed.")
+	ASSERT_EQUAL(calc.retrieveConfigurationSet("Front")->size(), 2, "Configurations minimized incorrectly.")
+
+	// syntax errors are reported with their line
+	auto errorOf = [](const std::string& text) {
+		ParetoCalculator c;
+		ParetoDSLParser p(c);
+		try {
+			p.Load(text, "bad");
+		}
+		catch (const EParetoCalculatorError& e) {
+			return e.errorMsg;
+		}
+		return std::string();
+	};
+	const std::string header = "pareto specification Bad description <> quantity types Cost: real\n";
+	ASSERT_THROW(errorOf(header + "configuration spaces S: Unknown\n").find("bad:2: unknown name Unknown") == 0, "Unknown quantity type not reported.")
+	ASSERT_THROW(errorOf(header + "configuration spaces S: Cost\nconfiguration sets C in S = { (1, 2) }\n").find("bad:3: too many values") == 0, "Wrong number of values not reported.")
+	ASSERT_THROW(errorOf(header + "configuration spaces S: Cost\nconfiguration sets C in S = { (x) }\n").find("bad:3: invalid value") == 0, "Invalid value not reported.")
+	ASSERT_THROW(errorOf(header + "configuration spaces configuration sets calculation").find("bad:2: operation expected at end of file") == 0, "Missing operation not reported.")
+	return true;
+}
+
+bool UnitTester::test_XMLParser(void) {
+
+	// a specification with two configuration sets sections, the second one empty
+	auto spec = [](const std::string& configurations, const std::string& minimize) {
+		return std::string(
+			"<?xml version=\"1.0\"?>\n"
+			"<pareto_specification xmlns=\"uri:pareto\">\n"
+			"  <name>TestXML</name>\n"
+			"  <quantity_definitions><quantity_definition name=\"Q\" type=\"real\"/></quantity_definitions>\n"
+			"  <configuration_spaces><space name=\"S\"><quantity name=\"Q\" referBy=\"A\"/><quantity name=\"Q\" referBy=\"B\"/></space></configuration_spaces>\n"
+			"  <configuration_sets><configuration_set name=\"Set\" space_id=\"S\"><configurations>\n")
+			+ configurations +
+			"  </configurations></configuration_set></configuration_sets>\n"
+			"  <configuration_sets/>\n"
+			"  <calculation><push name=\"Set\"/>" + minimize + "<store name=\"Front\"/></calculation>\n"
+			"</pareto_specification>\n";
+	};
+	const std::string file = "TestXMLParser.xml";
+	auto load = [&](const std::string& configurations, ParetoCalculator& c, const std::string& minimize = "<minimize/>") {
+		std::ofstream os(file);
+		os << spec(configurations, minimize);
+		os.close();
+		c.LoadFile(file);
+		c.LoadQuantityTypes();
+		c.LoadConfigurationSpaces();
+		c.LoadConfigurationSets();
+		c.LoadOperations();
+	};
+
+	ParetoCalculator calc;
+	load("<configuration><value>1</value><value>2</value></configuration>\n"
+		"<configuration><value>2</value><value>1</value></configuration>\n"
+		"<configuration><value>3</value><value>3</value></configuration>\n", calc);
+	ASSERT_EQUAL(calc.retrieveConfigurationSet("Set")->size(), 3, "Configurations of the set not loaded.")
+	ASSERT_EQUAL(calc.retrieveConfigurationSet("Front")->size(), 2, "Operations after the configuration sets not loaded.")
+
+	// configurations with the wrong number of values are rejected
+	auto errorOf = [&](const std::string& configurations, const std::string& minimize = "<minimize/>") {
+		ParetoCalculator c;
+		try {
+			load(configurations, c, minimize);
+		}
+		catch (const EParetoCalculatorError& e) {
+			return e.errorMsg;
+		}
+		return std::string();
+	};
+	ASSERT_THROW(errorOf("<configuration><value>1</value></configuration>\n").find("Too few values") == 0, "Too few values not reported.")
+	ASSERT_THROW(errorOf("<configuration/>\n").find("Too few values") == 0, "Empty configuration not reported.")
+	ASSERT_THROW(errorOf("<configuration><value>1</value><value>2</value><value>3</value></configuration>\n").find("Too many values") == 0, "Too many values not reported.")
+
+	// the divide and conquer minimization needs a threshold of at least two
+	const std::string configuration = "<configuration><value>1</value><value>2</value></configuration>\n";
+	ASSERT_THROW(errorOf(configuration, "<minimize_eff minimize_threshold=\"1\"/>").find("Invalid value of attribute minimize_threshold") == 0, "Threshold below two accepted.")
+	ASSERT_THROW(errorOf(configuration, "<minimize_eff minimize_threshold=\"2\"/>").empty(), "Threshold of two rejected.")
+
+	std::remove(file.c_str());
+	return true;
+}
+
+bool UnitTester::test_Profiling(void) {
+
+	// collects the profiles reported by the calculator
+	class Recorder : public ProfilingCallback {
+	public:
+		std::vector<OperationProfile> profiles;
+		virtual void profile(const OperationProfile& p) { profiles.push_back(p); }
+	};
+
+	const std::string spec =
+		"pareto specification TestProfiling\n"
+		"description <a test of the profiling of the operations>\n"
+		"quantity types\n"
+		"  Cost: real\n"
+		"  Time: real\n"
+		"configuration spaces\n"
+		"  Costs: Cost\n"
+		"  Times: Time\n"
+		"configuration sets\n"
+		"  A in Costs = { (1), (2), (3) }\n"
+		"  B in Times = { (3), (2), (1), (4) }\n"
+		"calculation\n"
+		"  push A push B product minimize store as Front\n";
+
+	// every operation reports its operands and results, the operations that call an
+	// algebra function are preceded by its profile
+	Recorder recorder;
+	ParetoCalculator calc;
+	calc.setProfilingCallbackObject(&recorder);
+	ParetoDSLParser parser(calc);
+	parser.Load(spec, "test");
+	calc.executeOperations(parser.operations);
+	ASSERT_EQUAL(recorder.profiles.size(), 7, "Not all operations and functions are profiled.")
+	const OperationProfile& push = recorder.profiles[0];
+	ASSERT_THROW(push.name == "push A" && push.level == 0, "Operation not profiled.")
+	ASSERT_EQUAL(push.inputSize, 0, "Operands of a push not measured.")
+	ASSERT_EQUAL(push.outputSize, 3, "Results of a push not measured.")
+	const OperationProfile& productFunction = recorder.profiles[2];
+	const OperationProfile& product = recorder.profiles[3];
+	ASSERT_THROW(productFunction.name == "product" && productFunction.level == 1, "Algebra function not profiled.")
+	ASSERT_THROW(product.name == "product" && product.level == 0, "Product not profiled.")
+	ASSERT_EQUAL(product.inputSize, 7, "Operands of a product not measured.")
+	ASSERT_EQUAL(product.outputSize, 12, "Results of a product not measured.")
+	ASSERT_EQUAL(productFunction.outputSize, 12, "Result of an algebra function not measured.")
+	ASSERT_THROW(product.allocations >= 12, "Allocations of a product not counted.")
+	const OperationProfile& minimize = recorder.profiles[5];
+	ASSERT_THROW(recorder.profiles[4].name == "efficient_minimize" && recorder.profiles[4].dominanceTests > 0, "Dominance tests not counted.")
+	ASSERT_EQUAL(minimize.inputSize, 12, "Operands of a minimization not measured.")
+	ASSERT_EQUAL(minimize.outputSize, 1, "Results of a minimization not measured.")
+	ASSERT_THROW(minimize.seconds >= recorder.profiles[4].seconds, "Time of an operation not measured.")
+	ASSERT_THROW(recorder.profiles[6].name == "store Front" && recorder.profiles[6].outputSize == 0, "Store not profiled.")
+
+	// the base cases of a divide-and-conquer minimization are included in its profile
+	ConfigurationSpacePtr CS = std::make_shared<ConfigurationSpace>("TestProfilingSpace");
+	for (const char* n : { "QuantityA", "QuantityB", "QuantityC", "QuantityD" }) {
+		CS->addQuantity(std::make_shared<QuantityType_Real>(n));
+	}
+	ConfigurationSetPtr C = std::make_shared<ConfigurationSet>(CS, "TestConfigurationSet");
+	std::uniform_real_distribution<> dis_real(0.0, 1.0);
+	for (unsigned int i = 0; i < 500; i++) {
+		ConfigurationPtr c = std::make_shared<Configuration>(CS);
+		for (unsigned int q = 0; q < 4; q++) {
+			c->addQuantity(std::make_shared<QuantityValue_Real>(*CS->quantities[q], dis_real(this->generator)));
+		}
+		C->addConfiguration(c);
+	}
+	MinimizeOptions o;
+	o.minimizeThreshold = 16;
+	o.filterThreshold = 16;
+	o.sweepKernels = false;
+	recorder.profiles.clear();
+	{
+		ProfileScope scope(&recorder, "test");
+		PC.efficient_minimize(C, o);
+	}
+	ASSERT_EQUAL(recorder.profiles.size(), 2, "Nested algebra functions are reported.")
+	ASSERT_THROW(recorder.profiles[0].name == "efficient_minimize", "Minimization not profiled.")
+	ASSERT_THROW(recorder.profiles[0].recursionDepth >= 5, "Recursion depth not measured.")
+	ASSERT_EQUAL(recorder.profiles[1].recursionDepth, recorder.profiles[0].recursionDepth, "Recursion depth not measured.")
+
+	// the work of the tasks of a parallel minimization is added to its profile
+	OperationProfile sequential = recorder.profiles[0];
+	o.parallel = true;
+	o.grain = 32;
+	recorder.profiles.clear();
+	{
+		ProfileScope scope(&recorder, "test");
+		PC.efficient_minimize(C, o);
+	}
+	ASSERT_EQUAL(recorder.profiles[0].dominanceTests, sequential.dominanceTests, "Dominance tests of parallel tasks not counted.")
+	ASSERT_EQUAL(recorder.profiles[0].allocations, sequential.allocations, "Allocations of parallel tasks not counted.")
+	ASSERT_EQUAL(recorder.profiles[0].recursionDepth, sequential.recursionDepth, "Recursion depth of parallel tasks not measured.")
+	o.parallel = false;
+
+	// nothing is reported without a callback
+	recorder.profiles.clear();
+	PC.efficient_minimize(C, o);
+	ASSERT_EQUAL(recorder.profiles.size(), 0, "Profile reported without a callback.")
+	// configurations and values created outside an arena are counted as well
+	std::stringstream records("1, 2, 3, 4\n");
+	ConfigurationReader reader(records, CS, RecordFormat::Text);
+	unsigned long long before = ProfileCounters::allocations;
+	ASSERT_THROW(reader.next() != nullptr, "Record not read.")
+	ASSERT_THROW(ProfileCounters::allocations - before >= 5, "Allocations outside an arena not counted.")
+
+	return true;
+}
+
+bool UnitTester::test_MinimizeTrace(void) {
+
+	// a set with four real quantities, divided down to small subproblems
+	ConfigurationSpacePtr CS = std::make_shared<ConfigurationSpace>("TestTraceSpace");
+	for (const char* n : { "QuantityA", "QuantityB", "QuantityC", "QuantityD" }) {
+		CS->addQuantity(std::make_shared<QuantityType_Real>(n));
+	}
+	ConfigurationSetPtr C = std::make_shared<ConfigurationSet>(CS, "TestConfigurationSet");
+	std::uniform_real_distribution<> dis_real(0.0, 1.0);
+	for (unsigned int i = 0; i < 1000; i++) {
+		ConfigurationPtr c = std::make_shared<Configuration>(CS);
+		for (unsigned int q = 0; q < 4; q++) {
+			c->addQuantity(std::make_shared<QuantityValue_Real>(*CS->quantities[q], dis_real(this->generator)));
+		}
+		C->addConfiguration(c);
+	}
+	MinimizeOptions o;
+	o.minimizeThreshold = 32;
+	o.filterThreshold = 32;
+	o.sweepKernels = false;
+	ConfigurationSetPtr M = PC.efficient_minimize(C, o);
+
+	// tracing does not change the result
+	MinimizeTrace trace;
+	o.trace = &trace;
+	unsigned long long tests = ProfileCounters::dominanceTests;
+	ConfigurationSetPtr MT = PC.efficient_minimize(C, o);
+	tests = ProfileCounters::dominanceTests - tests;
+	ASSERT_EQUAL(PC.constraint(M, MT)->confs().size(), M->confs().size(), "Traced minimization gives a different result.")
+
+	// the complete set is split once, in halves
+	std::vector<MinimizeTrace::Level> levels = trace.levels();
+	ASSERT_THROW(levels.size() >= 5, "Levels of the recursion not traced.")
+	ASSERT_EQUAL(levels[0].splits, 1, "Split of the complete set not traced.")
+	ASSERT_EQUAL(levels[0].lowSizes + levels[0].highSizes, 1000, "Sizes of the halves not traced.")
+	ASSERT_EQUAL(levels[1].splits, 2, "Splits of the halves not traced.")
+	unsigned long filter2 = 0, fallThroughs = 0, projections = 0, indexes = 0;
+	for (const MinimizeTrace::Level& l : levels) {
+		filter2 += l.filter2;
+		fallThroughs += l.filter2ToFilter3;
+		projections += l.projections;
+		indexes += l.indexes;
+	}
+	ASSERT_THROW(filter2 > 0 && fallThroughs > 0 && fallThroughs <= filter2, "Filters not traced.")
+	ASSERT_THROW(projections > 0 && indexes > 0, "Projections and indexes not traced.")
+
+	// the dominance tests are counted once, in the innermost phase
+	std::vector<MinimizeTrace::Event> events = trace.events();
+	unsigned long long eventTests = 0;
+	for (const MinimizeTrace::Event& e : events) {
+		eventTests += e.dominanceTests;
+	}
+	ASSERT_EQUAL(eventTests, tests, "Dominance tests of the phases do not add up.")
+	ASSERT_THROW(events.back().phase == MinimizePhase::Minimize && events.back().size == 1000, "Minimization not traced.")
+
+	// every event is written as a complete event
+	std::ostringstream json;
+	trace.writeChromeTrace(json);
+	std::string js = json.str();
+	size_t n = 0;
+	for (size_t p = js.find("\"ph\":\"X\""); p != std::string::npos; p = js.find("\"ph\":\"X\"", p + 1)) n++;
+	ASSERT_THROW(js.find("{\"traceEvents\":[") == 0, "Chrome trace not written.")
+	ASSERT_EQUAL(n, events.size(), "Events missing from the Chrome trace.")
+
+	// parallel subproblems are traced at their own level
+	MinimizeTrace parallelTrace;
+	o.trace = &parallelTrace;
+	o.parallel = true;
+	o.grain = 64;
+	ConfigurationSetPtr MP = PC.efficient_minimize(C, o);
+	ASSERT_EQUAL(PC.constraint(M, MP)->confs().size(), M->confs().size(), "Traced parallel minimization gives a different result.")
+	levels = parallelTrace.levels();
+	ASSERT_EQUAL(levels[1].splits, 2, "Splits of parallel subproblems not traced.")
+	ASSERT_EQUAL(levels[2].splits, 4, "Splits of parallel subproblems not traced.")
+	eventTests = 0;
+	for (const MinimizeTrace::Event& e : parallelTrace.events()) {
+		eventTests += e.dominanceTests;
+	}
+	ASSERT_EQUAL(eventTests, tests, "Dominance tests of the parallel phases do not add up.")
+	return true;
+}
+
+bool UnitTester::test_SortedConfigurationRange(void) {
+
+	// two sets with many equal values of the sorted quantity
+	ConfigurationSpacePtr CS = std::make_shared<ConfigurationSpace>("TestSortedSpace");
+	QuantityTypePtr TA = std::make_shared<QuantityType_Real>("QuantityA");
+	QuantityTypePtr TB = std::make_shared<QuantityType_Integer>("QuantityB");
+	QuantityTypePtr TC = std::make_shared<QuantityType_Real>("QuantityC");
+	QuantityTypePtr TD = std::make_shared<QuantityType_Real>("QuantityD");
+	CS->addQuantity(TA);
+	CS->addQuantity(TB);
+	CS->addQuantity(TC);
+	CS->addQuantity(TD);
+	std::uniform_int_distribution<> dis_int(0, 3);
+	std::uniform_real_distribution<> dis_real(0.0, 1.0);
+	auto randomSet = [&](unsigned int n, bool constant) {
+		ConfigurationSetPtr C = std::make_shared<ConfigurationSet>(CS, "TestConfigurationSet");
+		for (unsigned int i = 0; i < n; i++) {
+			ConfigurationPtr c = std::make_shared<Configuration>(CS);
+			c->addQuantity(std::make_shared<QuantityValue_Real>(*TA, dis_real(this->generator)));
+			c->addQuantity(std::make_shared<QuantityValue_Integer>(*TB, constant ? 0 : dis_int(this->generator)));
+			c->addQuantity(std::make_shared<QuantityValue_Real>(*TC, dis_real(this->generator)));
+			c->addQuantity(std::make_shared<QuantityValue_Real>(*TD, dis_real(this->generator)));
+			C->addConfiguration(c);
+		}
+		return C;
+	};
+	ConfigurationSetPtr CA = randomSet(100, false);
+	ConfigurationSetPtr CB = randomSet(60, false);
+
+	// the ranges are sorted and split at the first value that is not smaller
+	SortedConfigurationRange ra("QuantityB", CA);
+	SortedConfigurationRange rb("QuantityB", CB);
+	ASSERT_EQUAL(ra.size(), 100, "Configurations missing from the sorted range.")
+	std::vector<int> merged;
+	for (size_t k = 0; k < ra.size(); k++) {
+		int v = std::static_pointer_cast<QuantityValue_Integer>(ra.conf(k)->getQuantity("QuantityB"))->value;
+		ASSERT_THROW(k == 0 || ra.value(k - 1) <= ra.value(k), "Range is not sorted.")
+		ASSERT_EQUAL(dynamic_cast<const QuantityValue_Integer&>(ra.value(k)).value, v, "Value does not belong to the configuration.")
+		merged.push_back(v);
+	}
+	for (size_t k = 0; k < rb.size(); k++) {
+		merged.push_back(dynamic_cast<const QuantityValue_Integer&>(rb.value(k)).value);
+	}
+	std::sort(merged.begin(), merged.end());
+	for (int v = 0; v <= 3; v++) {
+		QuantityValue_Integer qv(*TB, v);
+		size_t below = 0;
+		for (size_t k = 0; k < ra.size(); k++) {
+			if (ra.value(k) < qv) below++;
+		}
+		ASSERT_EQUAL(ra.lower(qv), below, "Lower bound of the range is wrong.")
+	}
+
+	// selection from the merge of two ranges, also of parts of the ranges
+	for (size_t k = 0; k < merged.size(); k++) {
+		ASSERT_EQUAL(dynamic_cast<const QuantityValue_Integer&>(SortedConfigurationRange::select(ra, rb, k)).value, merged[k], "Selection from the merge is wrong.")
+	}
+	SortedConfigurationRange ral = ra.range(10, 30);
+	ASSERT_EQUAL(ral.size(), 20, "Size of the part of the range is wrong.")
+	ASSERT_THROW(&ral.value(0) == &ra.value(10), "Part of the range does not share the sorted configurations.")
+	ASSERT_EQUAL(ral.copy()->confs().size(), 20, "Copy of the range is wrong.")
+	ASSERT_THROW(&SortedConfigurationRange::select(ral, rb.range(0, 0), 19) == &ra.value(29), "Selection from a part of a range is wrong.")
+
+	// the divide and conquer minimization on the sorted ranges agrees with a simple cull, also
+	// when all values of a quantity are equal
+	MinimizeOptions o;
+	o.minimizeThreshold = 8;
+	o.filterThreshold = 8;
+	o.sweepKernels = false;
+	for (bool constant : { false, true }) {
+		ConfigurationSetPtr C = randomSet(2000, constant);
+		ConfigurationSetPtr CM1 = PC.efficient_minimize(C, o);
+		ConfigurationSetPtr CM2 = PC.minimize(C);
+		ASSERT_EQUAL(PC.constraint(CM1, CM2)->confs().size(), CM2->confs().size(), "DC minimization on sorted ranges gives a different result.")
+		ASSERT_EQUAL(CM1->confs().size(), CM2->confs().size(), "DC minimization on sorted ranges gives a different result.")
+	}
+	return true;
+}
@@ -64,6 +64,29 @@ namespace Pareto {
 
 		bool test_PCStore(void);
 		bool test_DCMinimization(void);
+		bool test_ColumnarStorage(void);
+		bool test_DominanceKernel(void);
+		bool test_DominanceFilter(void);
+		bool test_ParallelMinimization(void);
+		bool test_MinimizeOptions(void);
+		bool test_Autotuning(void);
+		bool test_SortFilterMinimization(void);
+		bool test_SweepKernels(void);
+		bool test_ConfigurationArena(void);
+		bool test_InternedEnumValues(void);
+		bool test_HashJoin(void);
+		bool test_ProductPipeline(void);
+		bool test_ProductFront(void);
+		bool test_OperationPlan(void);
+		bool test_ConcurrentPlan(void);
+		bool test_ParetoArchive(void);
+		bool test_OnlineMinimization(void);
+		bool test_BinaryFormat(void);
+		bool test_DSLParser(void);
+		bool test_XMLParser(void);
+		bool test_Profiling(void);
+		bool test_MinimizeTrace(void);
+		bool test_SortedConfigurationRange(void);
 
 	private:
 		// for reproducable pseudo random input